@@ -212,6 +212,53 @@ prepare_workspace() {
     log_success "Workspace prepared"
 }
 
+# Function to prune the VSS spec to the signals the app uses (VSS_SUBSET)
+# "auto" scans VehicleApp.cpp for Vehicle.* accesses; other words are VSS paths,
+# a branch keeps its whole subtree. The model then only contains those nodes.
+prepare_vss_subset() {
+    local full_spec="$1"
+    local manifest_file="$WORKSPACE/app/AppManifest.json"
+    local subset_spec="$WORKSPACE/vss-subset.json"
+    local scan_args=""
+    local signals=""
+
+    if [ -z "$full_spec" ] || [ ! -f "$full_spec" ]; then
+        log_error "VSS_SUBSET needs the downloaded VSS specification"
+        return 1
+    fi
+
+    local word
+    for word in ${VSS_SUBSET//,/ }; do
+        if [ "$word" = "auto" ]; then
+            scan_args="--scan $APP_SOURCE"
+        else
+            signals="$signals $word"
+        fi
+    done
+
+    log_info "Pruning VSS specification to the app's signals: $VSS_SUBSET"
+    if ! run_with_logging "python3 /scripts/vss-subset.py --spec '$full_spec' --out '$subset_spec' $scan_args --signals '$signals'" "VSS subset written" "Failed to prune VSS specification"; then
+        return 1
+    fi
+
+    # Generate from the subset; generate_model restores the manifest afterwards
+    cp "$manifest_file" "$manifest_file.full"
+    if command -v jq >/dev/null 2>&1; then
+        jq --arg vss_path "file://$subset_spec" \
+           '.interfaces[0].config.src = $vss_path' \
+           "$manifest_file" > "$manifest_file.tmp" && \
+           mv "$manifest_file.tmp" "$manifest_file"
+    else
+        sed -i "s|\"src\": \"[^\"]*vss[^\"]*\"|\"src\": \"file://$subset_spec\"|" "$manifest_file"
+    fi
+    if ! run_with_logging "velocitas exec vehicle-signal-interface download-vspec" "VSS subset selected" "Failed to select VSS subset"; then
+        return 1
+    fi
+
+    # No headers of pruned branches may survive from the pre-generated model
+    rm -rf "$WORKSPACE/app/vehicle_model"
+}
+
 # Function to generate vehicle model
 generate_model() {
     log_info "Generating vehicle model from VSS..."
@@ -223,8 +270,40 @@ generate_model() {
         log_error "Failed to download VSS specification"
         return 1
     fi
-    
-    if ! run_with_logging "velocitas exec vehicle-signal-interface generate-model" "Vehicle model generated" "Failed to generate vehicle model"; then
+
+    local vspec_file
+    vspec_file=$(velocitas cache get vspec_file_path 2>/dev/null || true)
+    if [ -n "$vspec_file" ] && [ -f "$vspec_file" ]; then
+        # Keep the full spec - a subset build points the cache at the pruned one
+        cp "$vspec_file" "$WORKSPACE/vss-full.json"
+        vspec_file="$WORKSPACE/vss-full.json"
+    fi
+
+    # The full spec feeds bin/vss.catalog (runtime/VssCatalog.h)
+    if [ -z "$APP_VSS_JSON" ]; then
+        APP_VSS_JSON="$vspec_file"
+    fi
+    if [ -n "$APP_VSS_JSON" ] && [ -f "$APP_VSS_JSON" ]; then
+        export APP_VSS_JSON
+        log_info "VSS catalog source: $APP_VSS_JSON"
+    else
+        unset APP_VSS_JSON
+        log_warning "VSS spec path unknown, building without VSS catalog"
+    fi
+
+    local generated=true
+    if [ -n "$VSS_SUBSET" ] && ! prepare_vss_subset "$vspec_file"; then
+        generated=false
+    elif ! run_with_logging "velocitas exec vehicle-signal-interface generate-model" "Vehicle model generated" "Failed to generate vehicle model"; then
+        generated=false
+    fi
+
+    # Later builds in this container start from the full spec again
+    if [ -f "$WORKSPACE/app/AppManifest.json.full" ]; then
+        mv "$WORKSPACE/app/AppManifest.json.full" "$WORKSPACE/app/AppManifest.json"
+    fi
+
+    if [ "$generated" = false ]; then
         log_error "Failed to generate vehicle model"  
         return 1
     fi
@@ -334,7 +413,7 @@ main() {
     
     # Step 3: Generate vehicle model (if needed)
     log_info "🔧 STEP 3/5: Vehicle signal model preparation..."
-    if [ ! -d "$WORKSPACE/app/vehicle_model" ]; then
+    if [ ! -d "$WORKSPACE/app/vehicle_model" ] || [ -n "$VSS_SUBSET" ]; then
         generate_model
     else
         log_info "✅ Vehicle model already exists, skipping generation"
@@ -462,6 +541,7 @@ case "${1:-build}" in
         echo "Environment Variables:"
         echo "  VSS_SPEC_FILE - Path to custom VSS JSON file"
         echo "  VSS_SPEC_URL  - URL to custom VSS JSON specification"
+        echo "  VSS_SUBSET    - Only generate these VSS paths ('auto' = scan VehicleApp.cpp)"
         echo "  VERBOSE_BUILD - Set to 1 to show detailed command output"
         ;;
     *)
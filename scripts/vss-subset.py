@@ -0,0 +1,104 @@
+#!/usr/bin/env python3
+# ============================================================================
+# vss-subset.py - Prune a VSS JSON spec to the signals an app uses
+# ============================================================================
+# Purpose: The generated vehicle model instantiates every VSS node as part of
+#          the global `Vehicle` object. Generating it from a pruned spec keeps
+#          only the branches the app touches: a smaller binary, less static
+#          initialization and less code for every build_application run.
+# Usage:
+#   vss-subset.py --spec vss_rel_4.0.json --out vss-subset.json \
+#                 [--scan app/src/VehicleApp.cpp ...] [--signals "Vehicle.Speed,..."]
+#
+# --scan collects `Vehicle.A.B` expressions from C++ sources (comments and
+# string literals are skipped - those are not model accesses). --signals adds
+# paths by hand, e.g. signals only named in APP_FORMULAS. A path naming a
+# branch keeps the whole subtree; ancestors of kept nodes keep their metadata.
+# ============================================================================
+
+import argparse
+import json
+import re
+import sys
+
+MODEL_ACCESS = re.compile(r"\bVehicle(?:\.[A-Z][A-Za-z0-9_]*)+")
+NOT_CODE = re.compile(r'//[^\n]*|/\*.*?\*/|"(?:\\.|[^"\\\n])*"|\'(?:\\.|[^\'\\\n])*\'', re.S)
+
+
+def scan(source):
+    with open(source, encoding="utf-8") as file:
+        code = NOT_CODE.sub(" ", file.read())
+    return MODEL_ACCESS.findall(code)
+
+
+def resolve(spec, path):
+    """Longest prefix of path that names a node: [(name, node), ...] from the root."""
+    names = path.split(".")
+    chain = []
+    children = spec
+    for name in names:
+        if not isinstance(children, dict) or name not in children:
+            break
+        node = children[name]
+        chain.append((name, node))
+        children = node.get("children")
+    return chain, len(chain) == len(names)
+
+
+def keep(subset, chain):
+    """Copy the nodes of chain into subset; the last one with its full subtree."""
+    children = subset
+    for depth, (name, node) in enumerate(chain):
+        if depth == len(chain) - 1:
+            children[name] = node
+            return
+        if name not in children:
+            children[name] = {key: value for key, value in node.items() if key != "children"}
+            children[name]["children"] = {}
+        elif children[name] is node:
+            return  # already kept with its whole subtree
+        children = children[name]["children"]
+
+
+def count(tree):
+    return sum(1 + count(node.get("children", {})) for node in tree.values())
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Prune a VSS JSON spec to the signals an app uses")
+    parser.add_argument("--spec", required=True, help="full VSS JSON spec")
+    parser.add_argument("--out", required=True, help="pruned VSS JSON spec to write")
+    parser.add_argument("--scan", action="append", default=[], help="C++ source to scan")
+    parser.add_argument("--signals", default="", help="extra paths, comma or space separated")
+    args = parser.parse_args()
+
+    with open(args.spec, encoding="utf-8") as file:
+        spec = json.load(file)
+
+    paths = set(re.split(r"[\s,;]+", args.signals.strip())) - {""}
+    for source in args.scan:
+        paths.update(scan(source))
+
+    subset = {}
+    unknown = []
+    for path in sorted(paths):
+        chain, found = resolve(spec, path)
+        if found:
+            keep(subset, chain)
+        else:
+            unknown.append(path)
+    if not subset:
+        print("vss-subset: none of the referenced paths is in the spec", file=sys.stderr)
+        return 1
+
+    with open(args.out, "w", encoding="utf-8") as file:
+        json.dump(subset, file, indent=2)
+
+    for path in unknown:
+        print(f"vss-subset: not in spec, ignored: {path}", file=sys.stderr)
+    print(f"vss-subset: {len(paths) - len(unknown)} paths, {count(subset)} of {count(spec)} nodes kept")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,105 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// ============================================================================
+// 🧩 EXAMPLE PLUGIN: Speed rule, hot-swappable (see runtime/PluginAbi.h)
+// ============================================================================
+// Build:  cmake --build build --target speed-rule
+// Deploy: cp build/.../speed-rule.so $APP_PLUGIN_DIR/.speed-rule.tmp &&
+//         mv $APP_PLUGIN_DIR/.speed-rule.tmp $APP_PLUGIN_DIR/speed-rule.so
+// Change the limit or the version string and deploy again - the running app
+// swaps it in within APP_PLUGIN_RELOAD_MS and the counters carry over.
+// ============================================================================
+
+#include "runtime/PluginAbi.h"
+
+#include <cstdio>
+#include <cstring>
+#include <new>
+
+namespace {
+
+constexpr double LIMIT_MPS = 30.0; // 108 km/h
+
+// Handed over to the next version - only append fields
+struct State {
+    unsigned long long samples;
+    unsigned long long violations;
+    double             peak;
+};
+
+struct Instance {
+    const vapp_host* host;
+    State            state;
+    bool             above;
+};
+
+void* create(const vapp_host* host, const void* state, size_t stateSize) {
+    auto* instance = new (std::nothrow) Instance{host, {}, false};
+    if (instance != nullptr && state != nullptr) {
+        std::memcpy(&instance->state, state, stateSize < sizeof(State) ? stateSize : sizeof(State));
+    }
+    return instance;
+}
+
+void destroy(void* instance) {
+    delete static_cast<Instance*>(instance);
+}
+
+void onReply(void* opaque, const vapp_sample* samples, size_t count) {
+    auto* self = static_cast<Instance*>(opaque);
+    for (size_t i = 0; i < count; ++i) {
+        if (std::strcmp(samples[i].path, "Vehicle.Speed") != 0) {
+            continue;
+        }
+        const double speed = samples[i].value;
+        ++self->state.samples;
+        self->state.peak = speed > self->state.peak ? speed : self->state.peak;
+        const bool above = speed > LIMIT_MPS;
+        if (above && !self->above) {
+            ++self->state.violations;
+            char message[96];
+            std::snprintf(message, sizeof(message), "speed-rule: %.1f km/h over the limit",
+                          speed * 3.6);
+            self->host->log(self->host->context, VAPP_LOG_WARN, message);
+        }
+        self->above = above;
+    }
+}
+
+void onTimer(void* opaque, int64_t /*nowNs*/) {
+    auto* self = static_cast<Instance*>(opaque);
+    self->host->publish(self->host->context, "Vehicle.SpeedRule.Violations",
+                        static_cast<double>(self->state.violations));
+}
+
+size_t saveState(void* opaque, void* buffer, size_t capacity) {
+    const auto* self = static_cast<Instance*>(opaque);
+    if (buffer != nullptr && capacity >= sizeof(State)) {
+        std::memcpy(buffer, &self->state, sizeof(State));
+    }
+    return sizeof(State);
+}
+
+const vapp_plugin PLUGIN = {
+    VAPP_PLUGIN_ABI_VERSION, "speed-rule", "1.0.0", create, destroy, onReply, onTimer, saveState,
+};
+
+} // namespace
+
+extern "C" __attribute__((visibility("default"))) const vapp_plugin* vapp_plugin_entry(void) {
+    return &PLUGIN;
+}
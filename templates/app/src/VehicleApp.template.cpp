@@ -10,7 +10,7 @@
 //
 // 🎯 QUICK START (3 Steps):
 // 1. Choose your signals in the onStart() method (lines 90-120)
-// 2. Add your custom logic in onSignalChanged() method (lines 130-180)
+// 2. Add your custom logic in the pipeline stages: decode/enrich/evaluate/publish
 // 3. Build: cat VehicleApp.cpp | docker run --rm -i velocitas-quick
 //
 // 💡 TIP: Look for 🔧 STEP markers throughout this file for guidance
@@ -18,16 +18,58 @@
 
 #include "sdk/VehicleApp.h"
 #include "sdk/DataPointReply.h"
+#include "sdk/DataPointValue.h"
 #include "sdk/Logger.h"
 #include "sdk/QueryBuilder.h"
 #include "sdk/vdb/IVehicleDataBrokerClient.h"
 #include "vehicle/Vehicle.hpp"
+#include "runtime/ActuatorQueue.h"
+#include "runtime/AllocTripwire.h"
+#include "runtime/Checkpoint.h"
+#include "runtime/ControlLoop.h"
+#include "runtime/Coroutine.h"
+#include "runtime/DerivedSignals.h"
+#include "runtime/FastLane.h"
+#include "runtime/Formula.h"
+#include "runtime/Fleet.h"
+#include "runtime/LaunchOptions.h"
+#include "runtime/LazyModel.h"
+#include "runtime/LiveStream.h"
+#include "runtime/ModuleScheduler.h"
+#include "runtime/Pipeline.h"
+#include "runtime/PluginHost.h"
+#include "runtime/QueryServer.h"
+#include "runtime/RunningStats.h"
+#include "runtime/ScratchArena.h"
+#include "runtime/Shutdown.h"
+#include "runtime/SignalTable.h"
+#include "runtime/SinkGuard.h"
+#include "runtime/SignalFilter.h"
+#include "runtime/Units.h"
+#include "runtime/VssCatalog.h"
+#include "runtime/WorkerPool.h"
 #include <fmt/format.h>
-#include <csignal>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
 #include <memory>
+#include <optional>
+#include <thread>
+#include <type_traits>
 
-// Create global Vehicle instance for accessing signals
-::vehicle::Vehicle Vehicle;
+// Global Vehicle instance for accessing signals. It holds every node of the
+// model, so it is built on first use rather than before main() (see
+// runtime/LazyModel.h); build with VSS_SUBSET=auto to generate only the nodes
+// used below. Code outside the app class calls VehicleModel.get() first.
+constinit runtime::LazyModel<::vehicle::Vehicle> VehicleModel;
+constinit ::vehicle::Vehicle&                    Vehicle = VehicleModel.reference();
+
+// Thresholds in any unit: 108_kmh, 22_celsius, ... (see runtime/Units.h)
+using namespace runtime::units::literals;
 
 // ============================================================================
 // VEHICLE APP CLASS DEFINITION
@@ -46,7 +88,7 @@
  * 
  * 📝 KEY METHODS TO CUSTOMIZE:
  * - onStart(): Choose which vehicle signals to subscribe to
- * - onSignalChanged(): Process the signal data when it changes
+ * - decode()/enrich()/evaluate()/publish(): Process the signal data in pipeline stages
  * 
  * 💡 COMMON SIGNALS YOU CAN USE:
  * - Vehicle.Speed (vehicle speed in m/s)
@@ -81,27 +123,247 @@ protected:
      */
     void onStart() override;
 
+    /**
+     * @brief Called when the app stops - reports how many samples the filters dropped
+     */
+    void onStop() override;
+
 private:
     // ========================================================================
-    // 🔧 STEP 3: PROCESS YOUR SIGNAL DATA (Customize this method)
+    // 🔧 STEP 3: PROCESS YOUR SIGNAL DATA (Customize the pipeline stages)
     // ========================================================================
     /**
-     * @brief Called when signal data changes - ADD YOUR LOGIC HERE
-     * 
-     * 🎯 YOUR TASK: Process the incoming signal data
-     * 
-     * 📖 HOW TO PROCESS SIGNALS:
-     * 1. Use reply.get(Vehicle.SignalName)->value() to get signal values
-     * 2. Add if/else logic to react to different values
-     * 3. Use logger().info() to print messages
-     * 
+     * @brief Units of the signals as this app receives them (see runtime/Units.h)
+     *
+     * VSS 4.0 declares Vehicle.Speed in km/h; the examples here are fed m/s. If
+     * your feeder follows the spec, change the unit here - thresholds written as
+     * 108_kmh and conversions with .in<km_per_h>() stay correct.
+     */
+    using VehicleSpeed     = runtime::units::Speed<runtime::units::m_per_s>;
+    using CabinTemperature = runtime::units::Temperature<runtime::units::celsius>;
+
+    /**
+     * @brief One sample travelling through the processing pipeline
+     *
+     * Each stage fills in more fields. Add the fields your own stages need.
+     */
+    struct SignalEvent {
+        std::optional<velocitas::DataPointReply> reply;       // raw databroker reply
+        VehicleSpeed                             speed;       // decoded
+        VehicleSpeed                             avgSpeed;    // enriched, trip average
+        const char*                              verdict{""}; // evaluated
+        bool                                     alert{false};
+    };
+
+    /**
+     * @brief Pipeline stages - ADD YOUR LOGIC HERE
+     *
+     * 🎯 YOUR TASK: Process the incoming signal data, one step per stage
+     *
+     * 📖 HOW THE STAGES WORK:
+     * 1. decode():   read values with reply.get(Vehicle.SignalName)->value()
+     * 2. enrich():   add derived values (units, running statistics)
+     * 3. evaluate(): decide what the values mean (alerts, rules)
+     * 4. publish():  act on the result (signal table, logs, actuators)
+     * Return false from a stage to drop the sample. Each stage runs on its own
+     * thread(s) and samples of one signal keep their order (see runtime/Pipeline.h).
+     *
      * 💡 EXAMPLE ACTIONS:
      * - Speed monitoring: Warn if speed > 120 km/h
-     * - Temperature alerts: Alert if cabin too hot/cold  
+     * - Temperature alerts: Alert if cabin too hot/cold
      * - Fuel warnings: Alert when fuel < 20%
      * - Data logging: Save values to file or database
      */
-    void onSignalChanged(const velocitas::DataPointReply& reply);
+    bool decode(SignalEvent& event);
+    bool enrich(SignalEvent& event);
+    // Static: fleet simulation (APP_FLEET_SIZE) runs the same rules per vehicle
+    static bool evaluate(SignalEvent& event);
+    bool publish(SignalEvent& event);
+
+    // ========================================================================
+    // 🔧 SIGNAL FILTERS: Drop samples you don't need BEFORE they are processed
+    // ========================================================================
+    // Pick one policy per signal (see runtime/SignalFilter.h):
+    // - SignalFilter::minInterval(1s) → at most one sample per second
+    // - SignalFilter::deadband(0.5)   → only when value moved by more than 0.5
+    // - SignalFilter::everyNth(10)    → every 10th sample
+    // - SignalFilter::passAll()       → no filtering
+    runtime::SignalFilter m_speedFilter =
+        runtime::SignalFilter::minInterval(std::chrono::milliseconds(100));
+
+    // ========================================================================
+    // 🔧 LONG-RUNNING STATE: Survives restarts when APP_CHECKPOINT_FILE is set
+    // ========================================================================
+    // Register aggregates with m_checkpoints in onStart() (see runtime/Checkpoint.h)
+    runtime::RunningStats    m_speedStats{"trip.speed"};
+    runtime::CheckpointStore m_checkpoints{runtime::CheckpointStore::Options::fromEnvironment()};
+
+    // ========================================================================
+    // 🔧 LATEST VALUES: Lock-free, optionally shared via APP_SIGNAL_TABLE_SHM
+    // ========================================================================
+    // Other processes read it with runtime/SignalTableReader.h (no databroker needed)
+    std::unique_ptr<runtime::SignalTable> m_latest{runtime::SignalTable::fromEnvironment()};
+    int                                   m_speedSlot{m_latest->registerSignal("Vehicle.Speed")};
+    int m_averageSpeedSlot{m_latest->registerSignal("Vehicle.AverageSpeed")}; // derived, km/h
+
+    // ========================================================================
+    // 🔧 CRITICAL SIGNALS: Fast lane around the pipeline (APP_FAST_LANE=1)
+    // ========================================================================
+    // Signals subscribed with subscribeCritical() use their own databroker channel
+    // and a dedicated high-priority thread (APP_CRITICAL_CPUS/APP_CRITICAL_PRIORITY,
+    // see runtime/FastLane.h). Keep their handlers short and allocation-free: record
+    // what happened in a member and log it from the follow-up.
+    template <typename Signal>
+    void subscribeCritical(Signal& signal, runtime::FastLane::Handler handler,
+                           runtime::FastLane::Handler followUp = {});
+
+    struct CriticalAlert {
+        bool   raised{false};
+        double value{0.0};
+    };
+    CriticalAlert m_brakeAlert; // fast lane thread only
+    CriticalAlert m_doorAlert;
+
+    runtime::FastLane m_fastLane{runtime::FastLane::Options::fromEnvironment()};
+
+    // Own channel, so critical updates never queue behind bulk subscriptions
+    std::shared_ptr<velocitas::IVehicleDataBrokerClient> m_criticalClient;
+
+    // ========================================================================
+    // 🔧 WORKER POOL: Run heavy processing on APP_WORKER_THREADS cores
+    // ========================================================================
+    // m_workers.submit(key, job) keeps the jobs of one key (e.g. a signal slot) in
+    // order; different keys run in parallel. Without APP_WORKER_THREADS jobs run inline.
+    runtime::WorkerPool m_workers{runtime::WorkerPool::Options::fromEnvironment()};
+
+    // ========================================================================
+    // 🔧 OUTPUT SINKS: Slow sinks sit behind a circuit breaker (APP_TRIP_LOG_FILE)
+    // ========================================================================
+    // The "recorder" module offers raw samples and one summary per second. When the
+    // sink stalls or fails, raw samples are shed and summaries kept (see runtime/SinkGuard.h)
+    struct TripRecord {
+        std::int64_t timeMs{0};
+        double       speed{0.0};  // raw samples, m/s
+        double       avgKmh{0.0}; // summaries, trip average
+        bool         summary{false};
+    };
+    bool writeTripRecord(const TripRecord& record);
+
+    std::unique_ptr<std::FILE, int (*)(std::FILE*)> m_tripLog{nullptr, &std::fclose};
+
+    runtime::SinkGuard<TripRecord> m_tripSink{
+        "trip-log", runtime::SinkGuard<TripRecord>::Options{}.withEnvironment("trip-log")};
+
+    // ========================================================================
+    // 🔧 VSS CATALOG: Type, unit and min/max of every VSS node, O(1) by path
+    // ========================================================================
+    // bin/vss.catalog is generated from the VSS spec at build time (APP_VSS_JSON);
+    // nullptr when the build had none (see runtime/VssCatalog.h)
+    std::unique_ptr<runtime::VssCatalog> m_catalog{runtime::VssCatalog::fromEnvironment()};
+
+    // ========================================================================
+    // 🔧 FORMULAS: Derived metrics defined outside the code (APP_FORMULAS[_FILE])
+    // ========================================================================
+    // "Vehicle.Derived.SpeedKmh = Vehicle.Speed * 3.6" - evaluated by the "formulas"
+    // module on every sample. Inputs are read from m_latest, so subscribe to them;
+    // outputs are written there too (see runtime/Formula.h)
+    runtime::FormulaSet m_formulas{*m_latest};
+
+    // ========================================================================
+    // 🔧 PLUGINS: Rules shipped as shared objects, swapped without a restart
+    // ========================================================================
+    // With APP_PLUGIN_DIR set, every *.so there (see plugins/) gets the speed
+    // samples from the "plugins" module and may write registered signals of
+    // m_latest. Replacing a file hot-swaps that plugin (see runtime/PluginHost.h)
+    runtime::PluginHost m_plugins{runtime::PluginHost::Options::fromEnvironment()};
+
+    // ========================================================================
+    // 🔧 HANDLER MODULES: Priority classes and CPU budgets for publish() actions
+    // ========================================================================
+    // Register modules in onStart(). Critical alerts run before anything else;
+    // budgeted modules are throttled per APP_MODULE_PERIOD_MS (see runtime/ModuleScheduler.h)
+    runtime::ModuleScheduler<SignalEvent> m_modules{
+        "handlers", runtime::ModuleScheduler<SignalEvent>::Options::fromEnvironment()};
+
+    // Runs the Step 3 stages; threads, batch size, queue size and backpressure
+    // per stage come from APP_STAGE_<NAME>_* (see runtime/Pipeline.h)
+    runtime::Pipeline<SignalEvent> m_pipeline{"signals"};
+
+    // Local query API for on-box tools when APP_QUERY_SOCKET is set (see runtime/QueryProtocol.h)
+    runtime::QueryServer m_queryServer{*m_latest, runtime::QueryServer::Options::fromEnvironment()};
+
+    // Throttled WebSocket feed for dashboards when APP_LIVE_STREAM_PORT is set
+    runtime::LiveStream m_liveStream{*m_latest, runtime::LiveStream::Options::fromEnvironment()};
+
+    // ========================================================================
+    // 🔧 DERIVED SIGNALS: Write computed values back to the databroker
+    // ========================================================================
+    // Enabled with APP_DERIVED_PUBLISH_MS; changed slots go out as one batch per interval
+    bool publishDerived(std::vector<runtime::DerivedUpdate>& batch);
+
+    runtime::DerivedSignalPublisher m_derived{
+        *m_latest, runtime::DerivedSignalPublisher::Options::fromEnvironment()};
+
+    // ========================================================================
+    // 🔧 ACTUATORS: Coalesced, batched target writes with deadlines and retry
+    // ========================================================================
+    // Declare actuators in onStart(), then call m_actuators.write(id, value) anywhere
+    bool sendActuatorTargets(std::vector<runtime::ActuatorWrite>& batch);
+
+    runtime::ActuatorQueue m_actuators{runtime::ActuatorQueue::Options::fromEnvironment()};
+
+    // Writes use their own databroker channel so they never queue behind subscriptions
+    std::shared_ptr<velocitas::IVehicleDataBrokerClient> m_writeClient;
+
+    // The databroker only accepts a value with the signal's VSS datatype
+    static std::unique_ptr<velocitas::DataPointValue>
+    makeDataPoint(const std::string& path, double value, runtime::VssDataType type);
+
+    // ========================================================================
+    // 🔧 CONTROL LOOP: Fixed-rate cabin climate example (APP_CONTROL_PERIOD_MS)
+    // ========================================================================
+    // The step reads the signal table and writes to m_actuators - never the databroker
+    void climateStep();
+
+    runtime::ControlLoop m_climateLoop{"cabin-climate",
+                                       runtime::ControlLoop::Options::fromEnvironment()};
+    int m_cabinAirSlot{m_latest->registerSignal("Vehicle.Cabin.HVAC.AmbientAirTemperature")};
+    int m_cabinTemperature{-1};
+
+    // ========================================================================
+    // 🔧 COROUTINES: Sequential get → set → wait logic without nested callbacks
+    // ========================================================================
+    // Write a runtime::Task<void> method, then m_coroutines.spawn("name", method()).
+    // Inside it: co_await runtime::awaitResult(...), stream.next(), runtime::sleepFor(...)
+    runtime::Task<void> preconditionCabin();
+
+    runtime::CoScheduler m_coroutines{"app"};
+
+    friend class FleetVehicle;
+};
+
+/**
+ * @brief One simulated vehicle in fleet mode (APP_FLEET_SIZE, see runtime/Fleet.h)
+ *
+ * Keeps only per-vehicle state - no databroker client, threads or signal table -
+ * and runs the app's enrich/evaluate logic on a simulated speed stream, so
+ * thousands fit in one process.
+ */
+class FleetVehicle : public runtime::FleetInstance {
+public:
+    void onSample(std::uint32_t vehicle, double speed,
+                  runtime::FleetPublisher& publisher) override {
+        VehicleAppTemplate::SignalEvent event;
+        event.speed = VehicleAppTemplate::VehicleSpeed{speed};
+        m_speedStats.add(speed);
+        event.avgSpeed = VehicleAppTemplate::VehicleSpeed{m_speedStats.getMean()};
+        if (VehicleAppTemplate::evaluate(event)) {
+            publisher.publish(vehicle, event.avgSpeed.in<runtime::units::km_per_h>(), event.alert);
+        }
+    }
+
+private:
+    runtime::RunningStats m_speedStats{"trip.speed"};
 };
 
 // ============================================================================
@@ -110,11 +372,284 @@ private:
 
 VehicleAppTemplate::VehicleAppTemplate()
     : VehicleApp(velocitas::IVehicleDataBrokerClient::createInstance("vehicledatabroker")) {
+    VehicleModel.get(); // every Vehicle.* access below runs after this
     velocitas::logger().info("🚗 Vehicle App Template starting...");
 }
 
+template <typename Signal>
+void VehicleAppTemplate::subscribeCritical(Signal& signal, runtime::FastLane::Handler handler,
+                                           runtime::FastLane::Handler followUp) {
+    const int id = m_fastLane.addSignal(signal.getPath(), std::move(handler), std::move(followUp));
+    m_criticalClient->subscribe(velocitas::QueryBuilder::select(signal).build())
+        ->onItem([this, &signal, id](auto&& item) {
+            const auto received = runtime::FastLane::Clock::now();
+            try {
+                m_fastLane.post(id, static_cast<double>(item.get(signal)->value()), received);
+            } catch (const std::exception&) {
+                // No valid value in this update (e.g. not available yet) - nothing to handle
+            }
+        })
+        ->onError([&signal](auto&& status) {
+            velocitas::logger().error("❌ Critical subscription {} error: {}", signal.getPath(),
+                                      status.errorMessage());
+        });
+}
+
 void VehicleAppTemplate::onStart() {
     velocitas::logger().info("🚀 Vehicle App Template starting - setting up signal subscriptions");
+
+    // 🎚️ Every published sample goes to each module. Keep alerts Critical and
+    // give expensive analytics the Background class and a budget, e.g.:
+    // m_modules.addModule("fft", [this](const SignalEvent& event) { runFft(event); },
+    //                     runtime::ModuleOptions{.priority = runtime::PriorityClass::Background,
+    //                                            .budget   = std::chrono::microseconds(500)}
+    //                         .withEnvironment("fft"));
+    m_modules.addModule(
+        "alerts",
+        [](const SignalEvent& event) {
+            if (event.alert) {
+                velocitas::logger().warn("{}: {:.1f} km/h", event.verdict,
+                                         event.speed.in<runtime::units::km_per_h>());
+            }
+        },
+        runtime::ModuleOptions{.priority = runtime::PriorityClass::Critical}.withEnvironment(
+            "alerts"));
+    m_modules.addModule(
+        "trip-log",
+        [](const SignalEvent& event) {
+            const double kmh = event.speed.in<runtime::units::km_per_h>();
+            velocitas::logger().info("📊 Vehicle Speed: {:.2f} m/s ({:.1f} km/h)",
+                                     event.speed.in<runtime::units::m_per_s>(), kmh);
+            if (!event.alert) {
+                velocitas::logger().info("{}: {:.1f} km/h", event.verdict, kmh);
+            }
+        },
+        runtime::ModuleOptions{.budget = std::chrono::microseconds(2000)}.withEnvironment(
+            "trip-log"));
+
+    // 💾 Trip recorder: a file sink that must never stall the signal path
+    if (const char* path = std::getenv("APP_TRIP_LOG_FILE")) {
+        m_tripLog.reset(std::fopen(path, "a"));
+        if (m_tripLog == nullptr) {
+            velocitas::logger().warn("⚠️  Trip log {} not writable - recorder disabled", path);
+        } else {
+            m_tripSink.start([this](const TripRecord& record) { return writeTripRecord(record); });
+            m_modules.addModule(
+                "recorder",
+                [this, nextSummary = std::chrono::steady_clock::time_point{}](
+                    const SignalEvent& event) mutable {
+                    const auto now    = std::chrono::steady_clock::now();
+                    const auto timeMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                            std::chrono::system_clock::now().time_since_epoch())
+                                            .count();
+                    m_tripSink.offer(TripRecord{timeMs, event.speed.value(), 0.0, false},
+                                     runtime::RecordPriority::Raw);
+                    if (now >= nextSummary) {
+                        nextSummary = now + std::chrono::seconds(1);
+                        m_tripSink.offer(
+                            TripRecord{timeMs, 0.0, event.avgSpeed.in<runtime::units::km_per_h>(),
+                                       true},
+                                         runtime::RecordPriority::Summary);
+                    }
+                },
+                runtime::ModuleOptions{}.withEnvironment("recorder"));
+        }
+    }
+
+    // 🧮 Formulas: compiled once, evaluated together on the latest values
+    if (m_formulas.load(runtime::FormulaSet::Options::fromEnvironment()) > 0) {
+        for (std::size_t input = 0; m_catalog && input < m_formulas.getInputCount(); ++input) {
+            if (m_catalog->find(m_formulas.getInputPath(input)) < 0) {
+                velocitas::logger().warn("⚠️  Formula input {} is not in the VSS catalog",
+                                         m_formulas.getInputPath(input));
+            }
+        }
+        m_modules.addModule(
+            "formulas", [this](const SignalEvent&) { m_formulas.evaluate(); },
+            runtime::ModuleOptions{}.withEnvironment("formulas"));
+    }
+
+    // 🧩 Plugins: one batch per published sample; a swap waits for the batch in flight
+    if (m_plugins.isEnabled()) {
+        m_latest->registerSignal("Vehicle.SpeedRule.Violations"); // written by plugins/SpeedRule
+        m_plugins.start([this](std::string_view path, double value) {
+            const int slot = m_latest->find(path);
+            if (slot < 0) {
+                return false;
+            }
+            m_latest->update(slot, value);
+            return true;
+        });
+        m_modules.addModule(
+            "plugins",
+            [this](const SignalEvent& event) {
+                const auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count();
+                const vapp_sample samples[] = {
+                    {"Vehicle.Speed", event.speed.value(), now},
+                    {"Vehicle.AverageSpeed", event.avgSpeed.in<runtime::units::km_per_h>(), now}};
+                m_plugins.dispatch(samples, std::size(samples));
+            },
+            runtime::ModuleOptions{}.withEnvironment("plugins"));
+    }
+    m_modules.start();
+
+    // decode → enrich → evaluate → publish; allocations inside the stages are
+    // flagged when built with -DAPP_ALLOC_TRIPWIRE=ON. Follow-up work that may
+    // allocate (logging, checkpoints) runs in `after`, outside the no-alloc scope
+    const auto stage = [this](auto step, auto after) {
+        return [this, step, after](SignalEvent& event) {
+            bool keep = false;
+            {
+                runtime::AllocTripwire::Scope noAlloc;
+                if constexpr (std::is_member_function_pointer_v<decltype(step)>) {
+                    keep = (this->*step)(event);
+                } else {
+                    keep = step(event);
+                }
+            }
+            after(keep);
+            return keep;
+        };
+    };
+    const auto nothing = [](bool) {};
+    m_pipeline
+        .addStage("decode",
+                  stage(&VehicleAppTemplate::decode,
+                        [](bool decoded) {
+                            if (!decoded) {
+                                velocitas::logger().debug("📡 Waiting for vehicle signal data...");
+                            }
+                        }),
+                  runtime::StageOptions{}.withEnvironment("decode"))
+        .addStage("enrich",
+                  stage(&VehicleAppTemplate::enrich,
+                        [this](bool) {
+                            // The first sample warmed up all lazily created state
+                            runtime::AllocTripwire::markSteadyState();
+                            // Snapshot changed aggregates every APP_CHECKPOINT_INTERVAL_MS -
+                            // on the thread that updates them
+                            m_checkpoints.tick();
+                        }),
+                  runtime::StageOptions{}.withEnvironment("enrich"))
+        .addStage("evaluate", stage(&VehicleAppTemplate::evaluate, nothing),
+                  runtime::StageOptions{}.withEnvironment("evaluate"))
+        .addStage("publish", stage(&VehicleAppTemplate::publish, nothing),
+                  runtime::StageOptions{}.withEnvironment("publish"));
+    m_pipeline.start();
+
+    // 🚨 Critical signals bypass the pipeline - brake and door examples (VSS 4.0)
+    if (m_fastLane.isEnabled()) {
+        m_criticalClient = velocitas::IVehicleDataBrokerClient::createInstance("vehicledatabroker");
+        subscribeCritical(
+            Vehicle.Chassis.Brake.PedalPosition,
+            [this](const runtime::CriticalEvent& event) {
+                m_brakeAlert = {event.value > 80.0, event.value};
+            },
+            [this](const runtime::CriticalEvent&) {
+                if (m_brakeAlert.raised) {
+                    velocitas::logger().warn("🚨 Emergency braking: pedal {:.0f}%",
+                                             m_brakeAlert.value);
+                }
+            });
+        subscribeCritical(
+            Vehicle.Cabin.Door.Row1.DriverSide.IsOpen,
+            [this](const runtime::CriticalEvent& event) {
+                runtime::SignalSample speed;
+                m_doorAlert = {event.value != 0.0 && m_latest->read(m_speedSlot, speed) &&
+                                   VehicleSpeed{speed.value} > 3.6_kmh,
+                               speed.value};
+            },
+            [this](const runtime::CriticalEvent&) {
+                if (m_doorAlert.raised) {
+                    velocitas::logger().warn(
+                        "🚨 Driver door opened while moving ({:.1f} km/h)",
+                        VehicleSpeed{m_doorAlert.value}.in<runtime::units::km_per_h>());
+                }
+            });
+        if (m_fastLane.start()) {
+            runtime::Shutdown::addDrainHook(
+                "fast-lane", [this](auto deadline) { return m_fastLane.flush(deadline); });
+        }
+    }
+
+    // Queued samples and jobs finish before the aggregates they update are checkpointed
+    runtime::Shutdown::addDrainHook(
+        "pipeline", [this](auto deadline) { return m_pipeline.flush(deadline); });
+    runtime::Shutdown::addDrainHook(
+        "modules", [this](auto deadline) { return m_modules.flush(deadline); });
+    if (m_tripLog != nullptr) {
+        runtime::Shutdown::addDrainHook(
+            "trip-log", [this](auto deadline) { return m_tripSink.flush(deadline); });
+    }
+    if (m_workers.start()) {
+        runtime::Shutdown::addDrainHook(
+            "workers", [this](auto deadline) { return m_workers.flush(deadline); });
+    }
+
+    // Warm restart: reload trip statistics from the last checkpoint (if enabled)
+    m_checkpoints.add(m_speedStats);
+    m_checkpoints.restore();
+    runtime::Shutdown::addDrainHook(
+        "checkpoint", [this](auto deadline) { return m_checkpoints.flush(deadline); });
+    m_queryServer.start();
+    m_liveStream.start();
+
+    // Add more derived signals with m_derived.publish(slot, VSS datatype[, "Vehicle.Path"])
+    m_derived.publish(m_averageSpeedSlot, runtime::VssDataType::Float);
+    for (std::size_t formula = 0; formula < m_formulas.getFormulaCount(); ++formula) {
+        // Formula outputs take their datatype from the VSS catalog, if there is one
+        const int  slot = m_formulas.getOutputSlot(formula);
+        const int  id   = m_catalog ? m_catalog->find(m_latest->getPath(slot)) : -1;
+        const auto type = id >= 0 ? m_catalog->getType(id) : runtime::VssDataType::Double;
+        m_derived.publish(slot, type);
+    }
+
+    // 🎛️ Actuators are declared up front and written with m_actuators.write(id, value)
+    if (m_climateLoop.isEnabled() && m_cabinAirSlot < 0) {
+        velocitas::logger().warn("⚠️  Signal table full - cabin climate loop has no input");
+    } else if (m_climateLoop.isEnabled()) {
+        // VSS 4.0 declares HVAC station temperatures as int8 (whole °C)
+        m_cabinTemperature = m_actuators.declare(
+            "Vehicle.Cabin.HVAC.Station.Row1.Left.Temperature", runtime::VssDataType::Int8);
+        subscribeDataPoints(
+            velocitas::QueryBuilder::select(Vehicle.Cabin.HVAC.AmbientAirTemperature).build())
+            ->onItem([this](auto&& item) {
+                m_latest->update(m_cabinAirSlot,
+                                 item.get(Vehicle.Cabin.HVAC.AmbientAirTemperature)->value());
+            })
+            ->onError([](auto&& status) {
+                velocitas::logger().error("❌ Cabin air subscription error: {}",
+                                          status.errorMessage());
+            });
+    }
+
+    // ☕ Coroutine example (APP_COROUTINE_EXAMPLE=1) - see preconditionCabin()
+    const char* coroutineExample = std::getenv("APP_COROUTINE_EXAMPLE");
+    const bool  precondition     = coroutineExample != nullptr && *coroutineExample == '1';
+    if (m_derived.isEnabled() || m_actuators.getActuatorCount() > 0 || precondition) {
+        m_writeClient = velocitas::IVehicleDataBrokerClient::createInstance("vehicledatabroker");
+    }
+    if (precondition) {
+        m_coroutines.spawn("precondition-cabin", preconditionCabin());
+    }
+    m_coroutines.start();
+    runtime::Shutdown::addDrainHook("coroutines", [this](auto) { return m_coroutines.stop(); });
+    if (m_derived.start([this](auto& batch) { return publishDerived(batch); })) {
+        runtime::Shutdown::addDrainHook(
+            "derived-signals", [this](auto deadline) { return m_derived.flush(deadline); });
+    }
+    m_actuators.start([this](auto& batch) { return sendActuatorTargets(batch); });
+    if (m_cabinAirSlot >= 0 && m_climateLoop.start([this] { climateStep(); })) {
+        // Stop producing commands before the actuator queue drains
+        runtime::Shutdown::addDrainHook("control-loop", [this](auto) {
+            m_climateLoop.stop();
+            return runtime::DrainResult{};
+        });
+    }
+    runtime::Shutdown::addDrainHook(
+        "actuators", [this](auto deadline) { return m_actuators.flush(deadline); });
     
     // ========================================================================
     // 🔧 STEP 2: SIGNAL SUBSCRIPTION - CHOOSE YOUR SIGNALS HERE
@@ -134,11 +669,31 @@ void VehicleAppTemplate::onStart() {
     // Subscribe to just one signal - perfect for beginners
     
     subscribeDataPoints(velocitas::QueryBuilder::select(Vehicle.Speed).build())
-        ->onItem([this](auto&& item) { onSignalChanged(std::forward<decltype(item)>(item)); })
+        ->onItem([this](auto&& item) {
+            // Ignore new samples once shutdown has started
+            runtime::Shutdown::IntakeGuard intake;
+            if (!intake) {
+                return;
+            }
+            // Drop samples right here so they never reach the pipeline
+            if (!m_speedFilter.accept()) {
+                return;
+            }
+            // Pin/prioritise the callback thread on first use (APP_INGEST_CPUS, APP_INGEST_PRIORITY)
+            runtime::tuneIngestThreadOnce();
+            runtime::AllocTripwire::nameThisThread("vdb-callback");
+            // Hand the reply to the pipeline - the key keeps speed samples in order
+            SignalEvent event;
+            event.reply.emplace(std::forward<decltype(item)>(item));
+            m_pipeline.push(m_speedSlot, std::move(event));
+        })
         ->onError([this](auto&& status) { 
             velocitas::logger().error("❌ Signal subscription error: {}", status.errorMessage());
         });
     
+    // 💡 VALUE-BASED FILTERS (deadband) need the value - pass it to accept():
+    //    if (!m_tempFilter.accept(item.get(Vehicle.Cabin.HVAC.Station.Row1.Left.Temperature)->value())) return;
+    
     // 💡 SINGLE SIGNAL ALTERNATIVES - Replace Vehicle.Speed with any of these:
     // Vehicle.Cabin.HVAC.Station.Row1.Left.Temperature  // Cabin temperature
     // Vehicle.Powertrain.Engine.Speed                    // Engine RPM
@@ -158,7 +713,11 @@ void VehicleAppTemplate::onStart() {
                                                .select(Vehicle.Cabin.HVAC.Station.Row1.Left.Temperature)
                                                .select(Vehicle.Powertrain.FuelSystem.Level)
                                                .build())
-        ->onItem([this](auto&& item) { onSignalChanged(std::forward<decltype(item)>(item)); })
+        ->onItem([this](auto&& item) {
+            SignalEvent event;
+            event.reply.emplace(std::forward<decltype(item)>(item));
+            m_pipeline.push(m_speedSlot, std::move(event));
+        })
         ->onError([this](auto&& status) { 
             velocitas::logger().error("❌ Signal subscription error: {}", status.errorMessage());
         });
@@ -174,133 +733,318 @@ void VehicleAppTemplate::onStart() {
     subscribeDataPoints(velocitas::QueryBuilder::select(Vehicle.YourSignalHere)
                                                .select(Vehicle.AnotherSignal)
                                                .build())
-        ->onItem([this](auto&& item) { onSignalChanged(std::forward<decltype(item)>(item)); })
+        ->onItem([this](auto&& item) {
+            SignalEvent event;
+            event.reply.emplace(std::forward<decltype(item)>(item));
+            m_pipeline.push(m_speedSlot, std::move(event));
+        })
         ->onError([this](auto&& status) { 
             velocitas::logger().error("❌ Signal subscription error: {}", status.errorMessage());
         });
     */
     
     // ========================================================================
-    // 🔧 STEP 2 COMPLETE: Now go to onSignalChanged() method below (line 170)
+    // 🔧 STEP 2 COMPLETE: Now go to the pipeline stages below (decode() ...)
     // ========================================================================
     
     velocitas::logger().info("✅ Signal subscription completed - waiting for vehicle data...");
 }
 
-void VehicleAppTemplate::onSignalChanged(const velocitas::DataPointReply& reply) {
+void VehicleAppTemplate::onStop() {
+    velocitas::logger().info("🔽 Speed filter ({}): {} passed, {} dropped",
+                             m_speedFilter.getPolicyName(), m_speedFilter.getPassedCount(),
+                             m_speedFilter.getDroppedCount());
+    runtime::AllocTripwire::report();
+    m_pipeline.report();
+    m_modules.report();
+    m_formulas.report();
+    if (m_plugins.isEnabled()) {
+        m_plugins.report();
+        m_plugins.stop();
+    }
+    m_fastLane.report();
+    if (m_tripLog != nullptr) {
+        m_tripSink.report();
+    }
+    m_workers.report();
+    velocitas::logger().info("📈 Trip speed: {} samples, avg {:.1f} km/h, max {:.1f} km/h",
+                             m_speedStats.getCount(),
+                             VehicleSpeed{m_speedStats.getMean()}.in<runtime::units::km_per_h>(),
+                             VehicleSpeed{m_speedStats.getMax()}.in<runtime::units::km_per_h>());
+    m_queryServer.stop();
+    m_liveStream.stop();
+    if (m_derived.isEnabled()) {
+        velocitas::logger().info("📤 Derived signals: {} published in {} batches, {} coalesced",
+                                 m_derived.getPublishedCount(), m_derived.getBatchCount(),
+                                 m_derived.getCoalescedCount());
+    }
+    m_coroutines.stop();
+    if (m_coroutines.getSpawnedCount() > 0) {
+        velocitas::logger().info("🧵 Coroutines: {} spawned, {} completed, {} failed",
+                                 m_coroutines.getSpawnedCount(), m_coroutines.getCompletedCount(),
+                                 m_coroutines.getFailedCount());
+    }
+    m_climateLoop.stop();
+    m_climateLoop.report();
+    for (int id = 0; id < static_cast<int>(m_actuators.getActuatorCount()); ++id) {
+        const auto stats = m_actuators.getStats(id);
+        velocitas::logger().info(
+            "🎛️  {}: {} sent, {} coalesced, {} expired, {} retries, latency avg {} us max {} us",
+            m_actuators.getPath(id), stats.sent, stats.coalesced, stats.expired, stats.retries,
+            stats.meanLatency.count(), stats.maxLatency.count());
+    }
+}
+
+std::unique_ptr<velocitas::DataPointValue>
+VehicleAppTemplate::makeDataPoint(const std::string& path, double value,
+                                  runtime::VssDataType type) {
+    const auto typed = [&](auto sample) -> std::unique_ptr<velocitas::DataPointValue> {
+        using T = decltype(sample);
+        if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>) {
+            // Integer signals get the nearest representable value
+            value = std::clamp(std::round(value),
+                               static_cast<double>(std::numeric_limits<T>::min()),
+                               static_cast<double>(std::numeric_limits<T>::max()));
+        }
+        return std::make_unique<velocitas::TypedDataPointValue<T>>(path, static_cast<T>(value));
+    };
+    switch (type) {
+    case runtime::VssDataType::Boolean:
+        return typed(bool{});
+    case runtime::VssDataType::Int8:
+        return typed(std::int8_t{});
+    case runtime::VssDataType::Int16:
+        return typed(std::int16_t{});
+    case runtime::VssDataType::Int32:
+        return typed(std::int32_t{});
+    case runtime::VssDataType::Int64:
+        return typed(std::int64_t{});
+    case runtime::VssDataType::UInt8:
+        return typed(std::uint8_t{});
+    case runtime::VssDataType::UInt16:
+        return typed(std::uint16_t{});
+    case runtime::VssDataType::UInt32:
+        return typed(std::uint32_t{});
+    case runtime::VssDataType::UInt64:
+        return typed(std::uint64_t{});
+    case runtime::VssDataType::Float:
+        return typed(float{});
+    default:
+        return typed(double{});
+    }
+}
+
+bool VehicleAppTemplate::publishDerived(std::vector<runtime::DerivedUpdate>& batch) {
+    std::vector<std::unique_ptr<velocitas::DataPointValue>> values;
+    values.reserve(batch.size());
+    for (const auto& update : batch) {
+        values.push_back(makeDataPoint(*update.path, update.value, update.type));
+    }
+    // Accepted entries are done; rejected ones stay dirty for the next batch
+    const auto errors = m_writeClient->setDatapoints(values)->await();
+    for (auto& update : batch) {
+        const auto error = errors.find(*update.path);
+        update.accepted  = error == errors.end();
+        if (!update.accepted) {
+            velocitas::logger().warn("⚠️  Databroker rejected {}: {}", *update.path, error->second);
+        }
+    }
+    return true;
+}
+
+bool VehicleAppTemplate::writeTripRecord(const TripRecord& record) {
+    // A stalled disk shows up as latency, a full one as an error - both trip the breaker
+    std::FILE* file = m_tripLog.get();
+    std::clearerr(file);
+    if (record.summary) {
+        std::fprintf(file, "%lld summary avg_kmh=%.1f\n", static_cast<long long>(record.timeMs),
+                     record.avgKmh);
+        std::fflush(file);
+    } else {
+        std::fprintf(file, "%lld raw speed=%.2f\n", static_cast<long long>(record.timeMs),
+                     record.speed);
+    }
+    return std::ferror(file) == 0;
+}
+
+void VehicleAppTemplate::climateStep() {
+    // Proportional set-point: push the HVAC harder the further the cabin is from target
+    constexpr CabinTemperature TARGET = 22_celsius;
+    constexpr double           GAIN   = 0.5;
+
+    runtime::SignalSample cabinAir;
+    if (!m_latest->read(m_cabinAirSlot, cabinAir)) {
+        return; // no measurement yet
+    }
+    const auto             error    = TARGET - CabinTemperature{cabinAir.value}; // delta<celsius>
+    const CabinTemperature setPoint =
+        std::clamp<CabinTemperature>(TARGET + GAIN * error, 16_celsius, 28_celsius);
+    m_actuators.write(m_cabinTemperature, setPoint.value());
+}
+
+runtime::Task<void> VehicleAppTemplate::preconditionCabin() {
+    // Runs on the coroutine thread. Each co_await suspends this routine without
+    // blocking a thread; an error from the databroker throws at the co_await.
+    constexpr VehicleSpeed     MOVING = 3.6_kmh;
+    constexpr CabinTemperature TARGET = 22_celsius;
+
+    runtime::SignalStream speed{
+        subscribeDataPoints(velocitas::QueryBuilder::select(Vehicle.Speed).build())};
+    while (true) {
+        // 1. Wait for a change: the vehicle starts moving
+        while (VehicleSpeed{(co_await speed.next()).get(Vehicle.Speed)->value()} < MOVING) {
+        }
+
+        // 2. Get: read the cabin air temperature once
+        const auto cabinAir =
+            co_await runtime::awaitResult(Vehicle.Cabin.HVAC.AmbientAirTemperature.get());
+
+        // 3. Set: overshoot the target by as much as the cabin is off from it
+        const auto   error    = TARGET - CabinTemperature{cabinAir.value()};
+        const double setPoint =
+            std::clamp<CabinTemperature>(TARGET + error, 16_celsius, 28_celsius).value();
+        std::vector<std::unique_ptr<velocitas::DataPointValue>> values;
+        values.push_back(makeDataPoint("Vehicle.Cabin.HVAC.Station.Row1.Left.Temperature",
+                                       setPoint, runtime::VssDataType::Int8));
+        const auto errors = co_await runtime::awaitResult(m_writeClient->setDatapoints(values));
+        velocitas::logger().info("☕ Cabin {:.1f}°C - HVAC target set to {:.0f}°C{}",
+                                 cabinAir.value(), setPoint, errors.empty() ? "" : " (rejected)");
+
+        // 4. Wait until the vehicle has stopped before arming again
+        while (VehicleSpeed{(co_await speed.next()).get(Vehicle.Speed)->value()} >= MOVING) {
+        }
+    }
+}
+
+bool VehicleAppTemplate::sendActuatorTargets(std::vector<runtime::ActuatorWrite>& batch) {
+    // One multi-datapoint set call per batch; rejected entries are retried by the queue.
+    // Each value is sent with the datatype its actuator was declared with.
+    std::vector<std::unique_ptr<velocitas::DataPointValue>> values;
+    values.reserve(batch.size());
+    for (const auto& write : batch) {
+        values.push_back(makeDataPoint(*write.path, write.value, write.type));
+    }
+    const auto errors = m_writeClient->setDatapoints(values)->await();
+    for (auto& write : batch) {
+        write.accepted = errors.find(*write.path) == errors.end();
+    }
+    return true;
+}
+
+// ============================================================================
+// 🔧 STEP 3: SIGNAL PROCESSING PIPELINE - ADD YOUR LOGIC HERE
+// ============================================================================
+//
+// 📖 INSTRUCTIONS:
+// 1. Choose the processing example that matches your Step 2 choice
+// 2. Uncomment the example you want to use in each stage
+// 3. Modify the logic to fit your needs
+// 4. Add your own fields to SignalEvent and your own actions to publish()
+//
+// 💡 Need temporary strings or vectors? Use the per-batch scratch arena instead
+//    of the heap - it is reset after every batch a stage processes:
+//    auto& arena = runtime::ScratchArena::forThisThread();
+//    std::string_view text = arena.format("{:.1f} km/h",
+//                                       event.speed.in<runtime::units::km_per_h>());
+//    runtime::ScratchVector<double> history{arena.resource()};
+// ============================================================================
+
+bool VehicleAppTemplate::decode(SignalEvent& event) {
     try {
-        // ====================================================================
-        // 🔧 STEP 3: SIGNAL PROCESSING - ADD YOUR LOGIC HERE
-        // ====================================================================
-        // 
-        // 📖 INSTRUCTIONS:
-        // 1. Choose the processing example that matches your Step 2 choice
-        // 2. Uncomment the example you want to use
-        // 3. Modify the logic to fit your needs
-        // 4. Add your own custom actions
-        //
-        // ====================================================================
-        
         // --------------------------------------------------------------------
-        // 📊 OPTION A: PROCESS SINGLE SIGNAL (matches Step 2 Option A)
+        // 📊 OPTION A: DECODE SINGLE SIGNAL (matches Step 2 Option A)
         // --------------------------------------------------------------------
-        // Process the speed signal (or whatever single signal you chose)
-        
-        auto speedValue = reply.get(Vehicle.Speed)->value();
-        velocitas::logger().info("📊 Vehicle Speed: {:.2f} m/s ({:.1f} km/h)", 
-                                speedValue, speedValue * 3.6);
-        
-        // 🎯 ADD YOUR SPEED-BASED LOGIC HERE:
-        // Example: Speed monitoring with alerts
-        if (speedValue > 30.0) {  // 30 m/s = 108 km/h
-            velocitas::logger().warn("⚠️  HIGH SPEED ALERT: {:.1f} km/h - Slow down!", speedValue * 3.6);
-        } else if (speedValue > 20.0) {  // 20 m/s = 72 km/h
-            velocitas::logger().info("🚗 Normal highway speed: {:.1f} km/h", speedValue * 3.6);
-        } else if (speedValue > 5.0) {  // 5 m/s = 18 km/h
-            velocitas::logger().info("🏘️  City driving speed: {:.1f} km/h", speedValue * 3.6);
-        } else if (speedValue > 0.1) {
-            velocitas::logger().info("🚶 Very slow: {:.1f} km/h", speedValue * 3.6);
-        } else {
-            velocitas::logger().info("🛑 Vehicle stopped");
-        }
-        
-        // 💡 REPLACE THE ABOVE WITH YOUR OWN LOGIC:
-        // - Send alerts to a mobile app
-        // - Log data to a database
-        // - Control other vehicle systems
-        // - Calculate fuel efficiency
-        
+        event.speed = VehicleSpeed{event.reply->get(Vehicle.Speed)->value()};
+
         // --------------------------------------------------------------------
-        // 📊 OPTION B: PROCESS MULTIPLE SIGNALS (matches Step 2 Option B)
+        // 📊 OPTION B: DECODE MULTIPLE SIGNALS (matches Step 2 Option B)
         // --------------------------------------------------------------------
-        // UNCOMMENT THE BLOCK BELOW IF YOU CHOSE MULTIPLE SIGNALS IN STEP 2:
-        
+        // Add CabinTemperature cabinTemp and runtime::units::Ratio<> fuel fields
+        // to SignalEvent, then UNCOMMENT:
         /*
-        // Process speed signal
-        if (reply.get(Vehicle.Speed)->isAvailable()) {
-            auto speed = reply.get(Vehicle.Speed)->value();
-            velocitas::logger().info("🚗 Speed: {:.1f} km/h", speed * 3.6);
-        }
-        
-        // Process cabin temperature signal
-        if (reply.get(Vehicle.Cabin.HVAC.Station.Row1.Left.Temperature)->isAvailable()) {
-            auto temp = reply.get(Vehicle.Cabin.HVAC.Station.Row1.Left.Temperature)->value();
-            velocitas::logger().info("🌡️  Cabin Temp: {:.1f}°C", temp);
-            
-            // 🎯 ADD YOUR TEMPERATURE LOGIC HERE:
-            if (temp > 28.0) {
-                velocitas::logger().warn("🔥 Cabin too hot! Consider turning on AC");
-            } else if (temp < 16.0) {
-                velocitas::logger().warn("🧊 Cabin too cold! Consider turning on heater");
-            } else {
-                velocitas::logger().info("✅ Cabin temperature is comfortable");
-            }
+        if (event.reply->get(Vehicle.Cabin.HVAC.Station.Row1.Left.Temperature)->isAvailable()) {
+            event.cabinTemp = CabinTemperature{event.reply->get(Vehicle.Cabin.HVAC.Station.Row1.Left.Temperature)->value()};
         }
-        
-        // Process fuel level signal
-        if (reply.get(Vehicle.Powertrain.FuelSystem.Level)->isAvailable()) {
-            auto fuel = reply.get(Vehicle.Powertrain.FuelSystem.Level)->value();
-            velocitas::logger().info("⛽ Fuel Level: {:.1f}%", fuel);
-            
-            // 🎯 ADD YOUR FUEL LOGIC HERE:
-            if (fuel < 15.0) {
-                velocitas::logger().warn("⚠️  LOW FUEL WARNING: {:.1f}% - Find a gas station!", fuel);
-            } else if (fuel < 30.0) {
-                velocitas::logger().info("⚠️  Fuel getting low: {:.1f}%", fuel);
-            }
+        if (event.reply->get(Vehicle.Powertrain.FuelSystem.Level)->isAvailable()) {
+            event.fuel = runtime::units::Ratio<>{event.reply->get(Vehicle.Powertrain.FuelSystem.Level)->value()};
         }
         */
-        
+
         // --------------------------------------------------------------------
-        // 📊 OPTION C: CUSTOM SIGNAL PROCESSING (matches Step 2 Option C)
+        // 📊 OPTION C: DECODE CUSTOM SIGNALS (matches Step 2 Option C)
         // --------------------------------------------------------------------
-        // UNCOMMENT AND MODIFY THE BLOCK BELOW FOR YOUR CUSTOM SIGNALS:
-        
         /*
-        if (reply.get(Vehicle.YourSignalHere)->isAvailable()) {
-            auto value = reply.get(Vehicle.YourSignalHere)->value();
-            velocitas::logger().info("📈 Your Signal: {}", value);
-            
-            // 🎯 ADD YOUR CUSTOM LOGIC HERE:
-            // Process your specific signal data
-            // Add conditions, calculations, alerts, etc.
+        if (event.reply->get(Vehicle.YourSignalHere)->isAvailable()) {
+            event.yourValue = event.reply->get(Vehicle.YourSignalHere)->value();
         }
         */
-        
-        // ====================================================================
-        // 🎯 CHALLENGE: ADD YOUR OWN CUSTOM LOGIC BELOW
-        // ====================================================================
-        // Ideas for custom logic:
-        // - Combine multiple signals for complex decisions
-        // - Track signal changes over time
-        // - Send data to external systems (MQTT, databases, APIs)
-        // - Calculate derived metrics (fuel efficiency, trip distance, etc.)
-        // - Implement safety features (collision avoidance, driver alerts)
-        // ====================================================================
-        
-    } catch (const std::exception& e) {
-        velocitas::logger().debug("📡 Waiting for vehicle signal data...");
+    } catch (const std::exception&) {
+        return false; // not available yet - logged by the decode stage
     }
+    event.reply.reset(); // later stages work on the decoded values only
+    return true;
+}
+
+bool VehicleAppTemplate::enrich(SignalEvent& event) {
+    // Running statistics are only touched here - one thread per signal, no locks
+    m_speedStats.add(event.speed.value());
+    event.avgSpeed = VehicleSpeed{m_speedStats.getMean()};
+
+    // 💡 MORE DERIVED METRICS: fuel efficiency, trip distance, acceleration, ...
+    return true;
+}
+
+bool VehicleAppTemplate::evaluate(SignalEvent& event) {
+    // ------------------------------------------------------------------------
+    // 📊 OPTION A: SPEED RULES (matches Step 2 Option A)
+    // ------------------------------------------------------------------------
+    // 🎯 ADD YOUR SPEED-BASED LOGIC HERE:
+    // Write limits in the unit that reads best; they are converted at compile time
+    if (event.speed > 108_kmh) {
+        event.verdict = "⚠️  HIGH SPEED ALERT - Slow down!";
+        event.alert   = true;
+    } else if (event.speed > 72_kmh) {
+        event.verdict = "🚗 Normal highway speed";
+    } else if (event.speed > 18_kmh) {
+        event.verdict = "🏘️  City driving speed";
+    } else if (event.speed > 0.36_kmh) {
+        event.verdict = "🚶 Very slow";
+    } else {
+        event.verdict = "🛑 Vehicle stopped";
+    }
+
+    // ------------------------------------------------------------------------
+    // 📊 OPTION B: TEMPERATURE AND FUEL RULES (matches Step 2 Option B)
+    // ------------------------------------------------------------------------
+    /*
+    if (event.cabinTemp > 28_celsius) {
+        event.verdict = "🔥 Cabin too hot! Consider turning on AC";
+        event.alert   = true;
+    } else if (event.cabinTemp < 16_celsius) {
+        event.verdict = "🧊 Cabin too cold! Consider turning on heater";
+        event.alert   = true;
+    }
+    if (event.fuel < 15_percent) {
+        event.verdict = "⚠️  LOW FUEL WARNING - Find a gas station!";
+        event.alert   = true;
+    }
+    */
+
+    // 💡 Return false to stop a sample here (e.g. nothing worth publishing)
+    return true;
+}
+
+bool VehicleAppTemplate::publish(SignalEvent& event) {
+    m_latest->update(m_speedSlot, event.speed.value());
+    m_latest->update(m_averageSpeedSlot, event.avgSpeed.in<runtime::units::km_per_h>());
+    // Alerts and logging run as handler modules (registered in onStart())
+    m_modules.dispatch(event);
+
+    // 💡 ADD YOUR OWN ACTIONS AS MODULES:
+    // - Send alerts to a mobile app
+    // - Log data to a database
+    // - Control other vehicle systems (queue targets with m_actuators.write())
+    return true;
 }
 
 // ============================================================================
@@ -309,11 +1053,42 @@ void VehicleAppTemplate::onSignalChanged(const velocitas::DataPointReply& reply)
 
 std::unique_ptr<VehicleAppTemplate> myApp;
 
-void signal_handler(int sig) {
-    velocitas::logger().info("🛑 App terminated due to signal {}", sig);
-    if (myApp) {
-        myApp->stop();
+/**
+ * @brief Fleet simulation entry point - hosts APP_FLEET_SIZE FleetVehicle instances
+ *
+ * All vehicles share one worker pool (APP_WORKER_THREADS, default: one per core),
+ * one timer wheel and one publisher. The sink below logs a fleet summary per
+ * flush; replace it to forward outputs to your cloud backend.
+ */
+int runFleet(const runtime::FleetSimulation::Options& options) {
+    auto poolOptions = runtime::WorkerPool::Options::fromEnvironment();
+    if (poolOptions.workers == 0) {
+        poolOptions.workers = std::max(1U, std::thread::hardware_concurrency());
+    }
+    runtime::WorkerPool workers{poolOptions};
+    workers.start();
+
+    runtime::FleetSimulation fleet{options, workers};
+    if (!runtime::Shutdown::setStopFunction([&fleet] { fleet.stop(); })) {
+        runtime::Shutdown::uninstall();
+        return 0;
     }
+    fleet.run([](std::uint32_t) { return std::make_unique<FleetVehicle>(); },
+              [](const std::vector<runtime::FleetUpdate>& batch) {
+                  std::size_t alerts = 0;
+                  double      sum    = 0.0;
+                  for (const auto& update : batch) {
+                      alerts += update.alert ? 1 : 0;
+                      sum += update.value;
+                  }
+                  velocitas::logger().info("🚙 Fleet: {} vehicles updated, {} alerts, "
+                                           "average trip speed {:.1f} km/h",
+                                           batch.size(), alerts, sum / batch.size());
+              });
+    fleet.report();
+    workers.report();
+    runtime::Shutdown::uninstall();
+    return 0;
 }
 
 // ============================================================================
@@ -323,7 +1098,7 @@ void signal_handler(int sig) {
  * @brief Main application entry point
  * 
  * 📖 WHAT THIS DOES:
- * 1. Handles Ctrl+C to shut down gracefully
+ * 1. Handles Ctrl+C / SIGTERM to shut down gracefully
  * 2. Starts your vehicle application
  * 3. Catches and reports any errors
  * 
@@ -334,8 +1109,17 @@ void signal_handler(int sig) {
  * - Configuration files
  */
 int main(int argc, char** argv) {
-    // Handle Ctrl+C for clean shutdown
-    signal(SIGINT, signal_handler);
+    // Handle Ctrl+C / SIGTERM for clean shutdown. Signals are received on a
+    // watcher thread (not in signal context), so this must run before any
+    // other thread is started. Drain deadline: APP_SHUTDOWN_DEADLINE_MS.
+    runtime::Shutdown::install();
+
+    // No-op unless built with -DAPP_ALLOC_TRIPWIRE=ON (see runtime/AllocTripwire.h)
+    runtime::AllocTripwire::configureFromEnvironment();
+
+    // CPU pinning, SCHED_FIFO and mlockall from APP_LAUNCH_CONFIG / APP_* variables
+    // (see runtime/LaunchOptions.h) - defaults leave scheduling untouched
+    runtime::applyProcessLaunchOptions();
 
     // ========================================================================
     // 🔧 STEP 4 (OPTIONAL): ADVANCED INITIALIZATION
@@ -365,21 +1149,39 @@ int main(int argc, char** argv) {
     
     // ========================================================================
 
+    // 🚙 Fleet mode: APP_FLEET_SIZE simulated vehicles in this process, no databroker
+    // (see runtime/Fleet.h) - for capacity planning of cloud-side digital twins
+    const auto fleet = runtime::FleetSimulation::Options::fromEnvironment();
+    if (fleet.vehicles > 0) {
+        return runFleet(fleet);
+    }
+
     velocitas::logger().info("🚀 Starting your Vehicle Application...");
     velocitas::logger().info("💡 Press Ctrl+C to stop the application");
 
-    // Create and run your vehicle application
+    // Create and run your vehicle application. The vehicle model is built
+    // meanwhile on another thread; the constructor waits for it
+    VehicleModel.prefetch();
     myApp = std::make_unique<VehicleAppTemplate>();
+    if (!runtime::Shutdown::setStopFunction([] { myApp->stop(); })) {
+        // Ctrl+C during startup - nothing has run yet
+        velocitas::logger().info("👋 Vehicle Application stopped during startup");
+        runtime::Shutdown::uninstall();
+        return 0;
+    }
     try {
         myApp->run();  // This runs until you press Ctrl+C
     } catch (const std::exception& e) {
         velocitas::logger().error("💥 Application error: {}", e.what());
+        runtime::Shutdown::uninstall();
         return 1;
     } catch (...) {
         velocitas::logger().error("💥 Unknown application error");
+        runtime::Shutdown::uninstall();
         return 1;
     }
 
+    runtime::Shutdown::uninstall();
     velocitas::logger().info("👋 Vehicle Application stopped");
     return 0;
 }
@@ -392,7 +1194,7 @@ int main(int argc, char** argv) {
 // ============================================================================
 //
 // 📊 SPEED & MOVEMENT:
-// Vehicle.Speed                           → Speed in m/s (multiply by 3.6 for km/h)
+// Vehicle.Speed                           → Speed as VehicleSpeed (.in<km_per_h>() converts)
 // Vehicle.Acceleration.Longitudinal       → Forward/backward acceleration in m/s²
 // Vehicle.Acceleration.Lateral            → Left/right acceleration in m/s²
 //
@@ -450,6 +1252,6 @@ int main(int argc, char** argv) {
 // 🔧 NEXT STEPS:
 // 1. Pick one of the examples above
 // 2. Copy the Step 2 line to the onStart() method
-// 3. Copy the Step 3 lines to the onSignalChanged() method
+// 3. Copy the Step 3 lines to the decode()/evaluate() pipeline stages
 // 4. Build and test: cat VehicleApp.cpp | docker run --rm -i velocitas-quick
 // ============================================================================
\ No newline at end of file
@@ -0,0 +1,259 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "runtime/ActuatorQueue.h"
+
+#include "sdk/Logger.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <exception>
+
+namespace runtime {
+
+namespace {
+
+std::chrono::milliseconds millisFromEnvironment(const char*               name,
+                                                std::chrono::milliseconds fallback) {
+    if (const char* value = std::getenv(name)) {
+        const long millis = std::atol(value);
+        if (millis >= 0) {
+            return std::chrono::milliseconds(millis);
+        }
+    }
+    return fallback;
+}
+
+} // namespace
+
+ActuatorQueue::Options ActuatorQueue::Options::fromEnvironment() {
+    Options options;
+    options.batchWindow = millisFromEnvironment("APP_ACTUATOR_BATCH_MS", options.batchWindow);
+    options.deadline    = millisFromEnvironment("APP_ACTUATOR_DEADLINE_MS", options.deadline);
+    return options;
+}
+
+ActuatorQueue::ActuatorQueue(Options options)
+    : m_options(options) {}
+
+ActuatorQueue::~ActuatorQueue() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+int ActuatorQueue::declare(std::string vssPath, VssDataType type) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_actuators.push_back({});
+    m_actuators.back().path = std::move(vssPath);
+    m_actuators.back().type = type;
+    return static_cast<int>(m_actuators.size() - 1);
+}
+
+void ActuatorQueue::start(Sink sink) {
+    if (m_thread.joinable() || m_actuators.empty()) {
+        return;
+    }
+    m_sink = std::move(sink);
+    m_batch.reserve(m_actuators.size());
+    m_batchIds.reserve(m_actuators.size());
+    m_thread = std::thread(&ActuatorQueue::loop, this);
+}
+
+void ActuatorQueue::write(int id, double value, std::chrono::milliseconds deadline) {
+    const auto now = Clock::now();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto&                       actuator = m_actuators[id];
+        if (actuator.pending) {
+            ++actuator.stats.coalesced;
+        }
+        actuator.pending    = true;
+        actuator.value      = value;
+        actuator.enqueuedAt = now;
+        actuator.deadline   = now + deadline;
+        // A new value is a new command: it does not inherit the backoff of a failed one
+        actuator.notBefore = {};
+        actuator.attempt   = 0;
+    }
+    m_wake.notify_one();
+}
+
+DrainResult ActuatorQueue::flush(Clock::time_point deadline) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    std::uint64_t                sentBefore = 0;
+    for (const auto& actuator : m_actuators) {
+        sentBefore += actuator.stats.sent;
+    }
+    if (m_thread.joinable()) {
+        m_idle.wait_until(lock, deadline, [this] { return pendingCount() == 0; });
+    }
+
+    DrainResult result;
+    for (const auto& actuator : m_actuators) {
+        result.drained += actuator.stats.sent;
+    }
+    result.drained -= sentBefore;
+    result.dropped = pendingCount();
+    m_stopping     = true;
+    lock.unlock();
+
+    m_wake.notify_all();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    return result;
+}
+
+ActuatorStats ActuatorQueue::getStats(int id) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto&                 actuator = m_actuators[id];
+    auto                        stats    = actuator.stats;
+    if (stats.sent > 0) {
+        stats.meanLatency = actuator.totalLatency / stats.sent;
+    }
+    return stats;
+}
+
+void ActuatorQueue::loop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_stopping) {
+        const auto now   = Clock::now();
+        bool       ready = false;
+        auto       wake  = Clock::time_point::max();
+        for (auto& actuator : m_actuators) {
+            if (!actuator.pending || actuator.inFlight) {
+                continue;
+            }
+            if (now >= actuator.deadline) {
+                actuator.pending = false;
+                ++actuator.stats.expired;
+            } else if (now >= actuator.notBefore) {
+                ready = true;
+            } else {
+                wake = std::min(wake, std::min(actuator.notBefore, actuator.deadline));
+            }
+        }
+        if (!ready) {
+            m_idle.notify_all();
+            if (wake == Clock::time_point::max()) {
+                m_wake.wait(lock);
+            } else {
+                m_wake.wait_until(lock, wake);
+            }
+            continue;
+        }
+
+        // Give concurrent writes a moment to join the same call.
+        if (m_options.batchWindow.count() > 0) {
+            m_wake.wait_for(lock, m_options.batchWindow, [this] { return m_stopping; });
+        }
+        send(lock);
+    }
+}
+
+void ActuatorQueue::send(std::unique_lock<std::mutex>& lock) {
+    struct Attempt {
+        Clock::time_point enqueuedAt;
+        Clock::time_point deadline;
+    };
+    std::vector<Attempt> attempts;
+    attempts.reserve(m_actuators.size());
+
+    const auto now = Clock::now();
+    m_batch.clear();
+    m_batchIds.clear();
+    for (std::size_t id = 0; id < m_actuators.size(); ++id) {
+        auto& actuator = m_actuators[id];
+        if (!actuator.pending || actuator.inFlight || now < actuator.notBefore) {
+            continue;
+        }
+        if (now >= actuator.deadline) {
+            actuator.pending = false;
+            ++actuator.stats.expired;
+            continue;
+        }
+        actuator.pending  = false;
+        actuator.inFlight = true;
+        m_batch.push_back({&actuator.path, actuator.type, actuator.value});
+        m_batchIds.push_back(static_cast<int>(id));
+        attempts.push_back({actuator.enqueuedAt, actuator.deadline});
+    }
+    if (m_batch.empty()) {
+        return;
+    }
+
+    lock.unlock();
+    bool delivered = false;
+    try {
+        delivered = m_sink(m_batch);
+    } catch (const std::exception& e) {
+        velocitas::logger().warn("⚠️  Actuator batch failed: {}", e.what());
+    }
+    lock.lock();
+
+    const auto done = Clock::now();
+    for (std::size_t i = 0; i < m_batch.size(); ++i) {
+        auto& actuator    = m_actuators[m_batchIds[i]];
+        actuator.inFlight = false;
+
+        if (delivered && m_batch[i].accepted) {
+            const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+                done - attempts[i].enqueuedAt);
+            ++actuator.stats.sent;
+            actuator.totalLatency += latency;
+            actuator.stats.maxLatency = std::max(actuator.stats.maxLatency, latency);
+            actuator.attempt          = 0;
+            actuator.notBefore        = {};
+        } else if (actuator.pending) {
+            // A newer value arrived meanwhile; it replaces the one that failed and
+            // goes out with the next batch - write() reset the backoff.
+            ++actuator.stats.coalesced;
+        } else if (done < attempts[i].deadline) {
+            actuator.pending    = true;
+            actuator.value      = m_batch[i].value;
+            actuator.enqueuedAt = attempts[i].enqueuedAt;
+            actuator.deadline   = attempts[i].deadline;
+            actuator.notBefore  = done + backoff(actuator.attempt++);
+            ++actuator.stats.retries;
+        } else {
+            ++actuator.stats.expired;
+        }
+    }
+    m_idle.notify_all();
+}
+
+ActuatorQueue::Clock::duration ActuatorQueue::backoff(unsigned attempt) {
+    // Exponential with "equal jitter": somewhere between half and all of the step,
+    // so actuators that failed together do not retry in lockstep.
+    const auto step = std::min<Clock::duration>(
+        m_options.maxBackoff, m_options.initialBackoff * (1U << std::min(attempt, 10U)));
+    std::uniform_int_distribution<Clock::rep> jitter(step.count() / 2, step.count());
+    return Clock::duration(jitter(m_random));
+}
+
+std::size_t ActuatorQueue::pendingCount() const {
+    return static_cast<std::size_t>(
+        std::count_if(m_actuators.begin(), m_actuators.end(),
+                      [](const Actuator& actuator) { return actuator.pending || actuator.inFlight; }));
+}
+
+} // namespace runtime
@@ -0,0 +1,161 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef VEHICLE_APP_RUNTIME_ACTUATORQUEUE_H
+#define VEHICLE_APP_RUNTIME_ACTUATORQUEUE_H
+
+#include "runtime/Shutdown.h"
+#include "runtime/VssCatalogLayout.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace runtime {
+
+/**
+ * @brief One actuator target handed to the sink. The sink clears accepted for
+ * entries the databroker rejected.
+ */
+struct ActuatorWrite {
+    const std::string* path;
+    VssDataType        type; // VSS datatype to send the value as
+    double             value;
+    bool               accepted{true};
+};
+
+/**
+ * @brief Counters and enqueue-to-acknowledge latency of one actuator.
+ */
+struct ActuatorStats {
+    std::uint64_t             sent{0};      // values acknowledged by the databroker
+    std::uint64_t             coalesced{0}; // values replaced by a newer one before sending
+    std::uint64_t             expired{0};   // values dropped at their deadline
+    std::uint64_t             retries{0};
+    std::chrono::microseconds meanLatency{0};
+    std::chrono::microseconds maxLatency{0};
+};
+
+/**
+ * @brief Coalescing command queue for actuator targets.
+ *
+ * write() only records the newest value per actuator; a sender thread groups
+ * everything pending into one multi-datapoint set call per batch window. A
+ * value that cannot be delivered is retried with jittered exponential backoff
+ * until its deadline passes, after which it is dropped - an old temperature
+ * set-point arriving late is worse than none. A newer write always replaces
+ * a queued or retrying value.
+ *
+ * Environment:
+ *   APP_ACTUATOR_BATCH_MS=5        how long to gather writes into one call
+ *   APP_ACTUATOR_DEADLINE_MS=1000  default lifetime of a write
+ */
+class ActuatorQueue {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Sends one batch; returns false if the call as a whole failed.
+     */
+    using Sink = std::function<bool(std::vector<ActuatorWrite>& batch)>;
+
+    struct Options {
+        std::chrono::milliseconds batchWindow{std::chrono::milliseconds(5)};
+        std::chrono::milliseconds deadline{std::chrono::milliseconds(1000)};
+        std::chrono::milliseconds initialBackoff{std::chrono::milliseconds(20)};
+        std::chrono::milliseconds maxBackoff{std::chrono::milliseconds(500)};
+
+        static Options fromEnvironment();
+    };
+
+    explicit ActuatorQueue(Options options);
+    ~ActuatorQueue();
+
+    ActuatorQueue(const ActuatorQueue&)            = delete;
+    ActuatorQueue& operator=(const ActuatorQueue&) = delete;
+    ActuatorQueue(ActuatorQueue&&)                 = delete;
+    ActuatorQueue& operator=(ActuatorQueue&&)      = delete;
+
+    /**
+     * @brief Register a VSS actuator path and its VSS datatype. Call before start().
+     * @return id for write()
+     */
+    int declare(std::string vssPath, VssDataType type);
+
+    /**
+     * @brief Start the sender thread.
+     */
+    void start(Sink sink);
+
+    /**
+     * @brief Queue a target value, replacing any value still pending for this actuator.
+     */
+    void write(int id, double value) { write(id, value, m_options.deadline); }
+    void write(int id, double value, std::chrono::milliseconds deadline);
+
+    /**
+     * @brief Wait for pending writes, then stop the sender - use as a Shutdown drain hook.
+     */
+    DrainResult flush(Clock::time_point deadline);
+
+    [[nodiscard]] std::size_t        getActuatorCount() const { return m_actuators.size(); }
+    [[nodiscard]] const std::string& getPath(int id) const { return m_actuators[id].path; }
+    [[nodiscard]] ActuatorStats      getStats(int id) const;
+
+private:
+    struct Actuator {
+        std::string       path;
+        VssDataType       type{VssDataType::Double};
+        bool              pending{false};
+        bool              inFlight{false};
+        double            value{0.0};
+        Clock::time_point enqueuedAt;
+        Clock::time_point deadline;
+        Clock::time_point notBefore; // backoff
+        unsigned          attempt{0};
+
+        ActuatorStats             stats;
+        std::chrono::microseconds totalLatency{0};
+    };
+
+    void            loop();
+    void            send(std::unique_lock<std::mutex>& lock);
+    Clock::duration backoff(unsigned attempt);
+    std::size_t     pendingCount() const;
+
+    Options               m_options;
+    Sink                  m_sink;
+    std::vector<Actuator> m_actuators;
+
+    mutable std::mutex         m_mutex;
+    std::condition_variable    m_wake;
+    std::condition_variable    m_idle;
+    bool                       m_stopping{false};
+    std::thread                m_thread;
+    std::vector<ActuatorWrite> m_batch; // sender thread only
+    std::vector<int>           m_batchIds;
+    std::minstd_rand           m_random{std::random_device{}()};
+};
+
+} // namespace runtime
+
+#endif // VEHICLE_APP_RUNTIME_ACTUATORQUEUE_H
@@ -0,0 +1,322 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "runtime/AllocTripwire.h"
+
+#include "sdk/Logger.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include <unistd.h>
+
+namespace runtime {
+
+#if APP_ALLOC_TRIPWIRE
+
+namespace {
+
+constexpr int MAX_THREADS = 64;
+
+// Everything reachable from the hooks is constant-initialised and never allocates.
+// A slot is owned by one live thread and handed back when that thread exits.
+struct ThreadSlot {
+    std::atomic<bool>          used{false};
+    std::atomic<const char*>   name{nullptr};
+    std::atomic<std::uint64_t> allocations{0};
+    std::atomic<std::uint64_t> deallocations{0};
+    std::atomic<std::uint64_t> bytes{0};
+    std::atomic<std::uint64_t> violations{0};
+};
+
+ThreadSlot            threadSlots[MAX_THREADS];
+ThreadSlot            exitedThreads; // totals folded in from released slots
+std::atomic<int>      slotHighWater{0};
+std::atomic<bool>     steadyState{false};
+std::atomic<uint8_t>  tripMode{static_cast<uint8_t>(AllocTripwire::Mode::Count)};
+std::atomic<uint64_t> unattributed{0};
+
+constexpr int NO_SLOT   = -1;
+constexpr int UNTRACKED = -2; // all slots taken, or this thread is exiting
+
+thread_local int slotIndex = NO_SLOT;
+
+void releaseSlot(ThreadSlot& slot) {
+    const auto move = [](std::atomic<std::uint64_t>& from, std::atomic<std::uint64_t>& to) {
+        to.fetch_add(from.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+    };
+    move(slot.allocations, exitedThreads.allocations);
+    move(slot.deallocations, exitedThreads.deallocations);
+    move(slot.bytes, exitedThreads.bytes);
+    move(slot.violations, exitedThreads.violations);
+    slot.name.store(nullptr, std::memory_order_relaxed);
+    slot.used.store(false, std::memory_order_release);
+}
+
+// Hands the slot back on thread exit. Registering it goes through
+// __cxa_thread_atexit, which uses calloc - not the hooks below.
+struct SlotLease {
+    ~SlotLease() {
+        if (slotIndex >= 0) {
+            const int index = slotIndex;
+            slotIndex       = UNTRACKED; // later TLS destructors count as unattributed
+            releaseSlot(threadSlots[index]);
+        }
+    }
+};
+
+ThreadSlot* slotForThisThread() {
+    if (slotIndex >= 0) {
+        return &threadSlots[slotIndex];
+    }
+    if (slotIndex == UNTRACKED) {
+        return nullptr;
+    }
+    slotIndex = UNTRACKED;
+    for (int i = 0; i < MAX_THREADS; ++i) {
+        bool free = false;
+        if (threadSlots[i].used.compare_exchange_strong(free, true, std::memory_order_acquire)) {
+            slotIndex = i;
+            int highWater = slotHighWater.load(std::memory_order_relaxed);
+            while (highWater <= i &&
+                   !slotHighWater.compare_exchange_weak(highWater, i + 1,
+                                                        std::memory_order_relaxed)) {
+            }
+            thread_local SlotLease lease;
+            (void)lease;
+            return &threadSlots[i];
+        }
+    }
+    return nullptr;
+}
+
+void writeRaw(const char* text) {
+    const auto written = ::write(STDERR_FILENO, text, std::strlen(text));
+    (void)written;
+}
+
+void onAllocate(std::size_t size) {
+    ThreadSlot* slot = slotForThisThread();
+    if (slot == nullptr) {
+        unattributed.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    slot->allocations.fetch_add(1, std::memory_order_relaxed);
+    slot->bytes.fetch_add(size, std::memory_order_relaxed);
+
+    if (AllocTripwire::guardDepth() > 0 && steadyState.load(std::memory_order_relaxed)) {
+        slot->violations.fetch_add(1, std::memory_order_relaxed);
+        if (tripMode.load(std::memory_order_relaxed) ==
+            static_cast<uint8_t>(AllocTripwire::Mode::Abort)) {
+            writeRaw("💥 AllocTripwire: heap allocation on no-alloc path in thread ");
+            const char* name = slot->name.load(std::memory_order_relaxed);
+            writeRaw(name != nullptr ? name : "<unnamed>");
+            writeRaw("\n");
+            std::abort();
+        }
+    }
+}
+
+void onDeallocate() {
+    ThreadSlot* slot = slotForThisThread();
+    if (slot != nullptr) {
+        slot->deallocations.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void* allocate(std::size_t size, std::size_t alignment, bool throwOnFailure) {
+    onAllocate(size);
+    if (size == 0) {
+        size = 1;
+    }
+    void* ptr = nullptr;
+    if (alignment <= alignof(std::max_align_t)) {
+        ptr = std::malloc(size);
+    } else if (::posix_memalign(&ptr, alignment, size) != 0) {
+        ptr = nullptr;
+    }
+    if (ptr == nullptr && throwOnFailure) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void deallocate(void* ptr) {
+    if (ptr == nullptr) {
+        return;
+    }
+    onDeallocate();
+    std::free(ptr);
+}
+
+} // namespace
+
+bool AllocTripwire::isEnabled() {
+    return true;
+}
+
+void AllocTripwire::setMode(Mode mode) {
+    tripMode.store(static_cast<uint8_t>(mode), std::memory_order_relaxed);
+}
+
+void AllocTripwire::configureFromEnvironment() {
+    const char* mode = std::getenv("APP_ALLOC_TRIPWIRE");
+    if (mode != nullptr && std::strcmp(mode, "abort") == 0) {
+        setMode(Mode::Abort);
+    } else {
+        setMode(Mode::Count);
+    }
+    velocitas::logger().info("🪤 Allocation tripwire enabled (mode: {})",
+                             mode != nullptr && std::strcmp(mode, "abort") == 0 ? "abort"
+                                                                                 : "count");
+}
+
+void AllocTripwire::nameThisThread(const char* name) {
+    ThreadSlot* slot = slotForThisThread();
+    if (slot != nullptr) {
+        slot->name.store(name, std::memory_order_relaxed);
+    }
+}
+
+void AllocTripwire::markSteadyState() {
+    steadyState.store(true, std::memory_order_relaxed);
+}
+
+bool AllocTripwire::isSteadyState() {
+    return steadyState.load(std::memory_order_relaxed);
+}
+
+void AllocTripwire::report() {
+    const auto print = [](const ThreadSlot& slot, const char* name) {
+        const auto violations = slot.violations.load(std::memory_order_relaxed);
+        velocitas::logger().info("  {} {:<16} new: {:>8} delete: {:>8} bytes: {:>10} violations: {}",
+                                 violations > 0 ? "❌" : "✅", name,
+                                 slot.allocations.load(std::memory_order_relaxed),
+                                 slot.deallocations.load(std::memory_order_relaxed),
+                                 slot.bytes.load(std::memory_order_relaxed), violations);
+    };
+
+    const int count = std::min(slotHighWater.load(std::memory_order_relaxed), MAX_THREADS);
+    const int live  = static_cast<int>(
+        std::count_if(threadSlots, threadSlots + count, [](const ThreadSlot& slot) {
+            return slot.used.load(std::memory_order_acquire);
+        }));
+    velocitas::logger().info("🪤 Allocation tripwire report ({} threads, steady state: {})", live,
+                             isSteadyState() ? "yes" : "no");
+    for (int i = 0; i < count; ++i) {
+        const ThreadSlot& slot = threadSlots[i];
+        if (slot.used.load(std::memory_order_acquire)) {
+            const char* name = slot.name.load(std::memory_order_relaxed);
+            print(slot, name != nullptr ? name : "<unnamed>");
+        }
+    }
+    if (exitedThreads.allocations.load(std::memory_order_relaxed) > 0) {
+        print(exitedThreads, "<exited threads>");
+    }
+    if (unattributed.load(std::memory_order_relaxed) > 0) {
+        velocitas::logger().warn(
+            "  ⚠️  {} allocations from untracked threads (more than {} alive, or exiting)",
+            unattributed.load(std::memory_order_relaxed), MAX_THREADS);
+    }
+}
+
+#else
+
+bool AllocTripwire::isEnabled() {
+    return false;
+}
+
+void AllocTripwire::setMode(Mode /*mode*/) {}
+void AllocTripwire::configureFromEnvironment() {}
+void AllocTripwire::nameThisThread(const char* /*name*/) {}
+void AllocTripwire::markSteadyState() {}
+
+bool AllocTripwire::isSteadyState() {
+    return false;
+}
+
+void AllocTripwire::report() {}
+
+#endif
+
+} // namespace runtime
+
+#if APP_ALLOC_TRIPWIRE
+
+// ============================================================================
+// Global allocation hooks
+// ============================================================================
+
+void* operator new(std::size_t size) {
+    return runtime::allocate(size, alignof(std::max_align_t), true);
+}
+
+void* operator new[](std::size_t size) {
+    return runtime::allocate(size, alignof(std::max_align_t), true);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t& /*tag*/) noexcept {
+    return runtime::allocate(size, alignof(std::max_align_t), false);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& /*tag*/) noexcept {
+    return runtime::allocate(size, alignof(std::max_align_t), false);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return runtime::allocate(size, static_cast<std::size_t>(alignment), true);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return runtime::allocate(size, static_cast<std::size_t>(alignment), true);
+}
+
+void operator delete(void* ptr) noexcept {
+    runtime::deallocate(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    runtime::deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::size_t /*size*/) noexcept {
+    runtime::deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t /*size*/) noexcept {
+    runtime::deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t /*alignment*/) noexcept {
+    runtime::deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t /*alignment*/) noexcept {
+    runtime::deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::size_t /*size*/, std::align_val_t /*alignment*/) noexcept {
+    runtime::deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t /*size*/, std::align_val_t /*alignment*/) noexcept {
+    runtime::deallocate(ptr);
+}
+
+#endif
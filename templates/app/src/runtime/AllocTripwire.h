@@ -0,0 +1,96 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef VEHICLE_APP_RUNTIME_ALLOCTRIPWIRE_H
+#define VEHICLE_APP_RUNTIME_ALLOCTRIPWIRE_H
+
+#include <cstdint>
+
+namespace runtime {
+
+/**
+ * @brief Detects heap allocations on the processing path once the app is in steady state.
+ *
+ * Built with -DAPP_ALLOC_TRIPWIRE=ON the app replaces the global operator new/delete
+ * with counting hooks that attribute every call to the calling thread. Code that
+ * must not allocate is wrapped in an AllocTripwire::Scope; any allocation inside
+ * such a scope after markSteadyState() is a violation. Depending on the mode a
+ * violation is counted (and listed by report()) or aborts the process so the
+ * offending stack can be inspected in a core dump.
+ *
+ * Without the build option every call here compiles to a no-op.
+ *
+ * Environment:
+ *   APP_ALLOC_TRIPWIRE=count|abort   (default: count)
+ */
+class AllocTripwire {
+public:
+    enum class Mode : std::uint8_t { Count, Abort };
+
+    /**
+     * @brief true if the counting hooks are compiled in.
+     */
+    static bool isEnabled();
+
+    static void setMode(Mode mode);
+    static void configureFromEnvironment();
+
+    /**
+     * @brief Give the calling thread a name for report(). The pointer must stay valid.
+     */
+    static void nameThisThread(const char* name);
+
+    /**
+     * @brief Initialisation is done - allocations inside a Scope are violations from now on.
+     */
+    static void markSteadyState();
+    static bool isSteadyState();
+
+    /**
+     * @brief Log allocation counts and violations per live thread; threads that have
+     * exited are summed into one line and their slots reused.
+     */
+    static void report();
+
+    /**
+     * @brief Marks a region of the processing path that must not allocate.
+     */
+    class Scope {
+    public:
+#if APP_ALLOC_TRIPWIRE
+        Scope() { ++guardDepth(); }
+        ~Scope() { --guardDepth(); }
+#else
+        Scope() {}
+        ~Scope() {}
+#endif
+        Scope(const Scope&)            = delete;
+        Scope& operator=(const Scope&) = delete;
+        Scope(Scope&&)                 = delete;
+        Scope& operator=(Scope&&)      = delete;
+    };
+
+#if APP_ALLOC_TRIPWIRE
+    static int& guardDepth() {
+        thread_local int depth = 0;
+        return depth;
+    }
+#endif
+};
+
+} // namespace runtime
+
+#endif // VEHICLE_APP_RUNTIME_ALLOCTRIPWIRE_H
@@ -0,0 +1,313 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "runtime/Checkpoint.h"
+
+#include "sdk/Logger.h"
+
+#include <array>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace runtime {
+
+namespace {
+
+constexpr std::array<char, 8> MAGIC{'V', 'A', 'P', 'P', 'S', 'N', 'A', 'P'};
+
+std::uint32_t crc32(const std::uint8_t* data, std::size_t size) {
+    static const auto table = [] {
+        std::array<std::uint32_t, 256> entries{};
+        for (std::uint32_t i = 0; i < entries.size(); ++i) {
+            std::uint32_t value = i;
+            for (int bit = 0; bit < 8; ++bit) {
+                value = (value & 1U) != 0 ? 0xEDB88320U ^ (value >> 1U) : value >> 1U;
+            }
+            entries[i] = value;
+        }
+        return entries;
+    }();
+
+    std::uint32_t crc = 0xFFFFFFFFU;
+    for (std::size_t i = 0; i < size; ++i) {
+        crc = table[(crc ^ data[i]) & 0xFFU] ^ (crc >> 8U);
+    }
+    return crc ^ 0xFFFFFFFFU;
+}
+
+/**
+ * @brief Read-only mapping of the snapshot file, unmapped on scope exit.
+ */
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path) {
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return;
+        }
+        struct stat info {};
+        if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+            void* data = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ,
+                                MAP_PRIVATE, fd, 0);
+            if (data != MAP_FAILED) {
+                m_data = static_cast<const std::uint8_t*>(data);
+                m_size = static_cast<std::size_t>(info.st_size);
+            }
+        }
+        ::close(fd);
+    }
+
+    ~MappedFile() {
+        if (m_data != nullptr) {
+            ::munmap(const_cast<std::uint8_t*>(m_data), m_size);
+        }
+    }
+
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&&)                 = delete;
+    MappedFile& operator=(MappedFile&&)      = delete;
+
+    [[nodiscard]] const std::uint8_t* data() const { return m_data; }
+    [[nodiscard]] std::size_t         size() const { return m_size; }
+
+private:
+    const std::uint8_t* m_data{nullptr};
+    std::size_t         m_size{0};
+};
+
+} // namespace
+
+CheckpointStore::Options CheckpointStore::Options::fromEnvironment() {
+    Options options;
+    if (const char* path = std::getenv("APP_CHECKPOINT_FILE")) {
+        options.path = path;
+    }
+    if (const char* interval = std::getenv("APP_CHECKPOINT_INTERVAL_MS")) {
+        const long millis = std::atol(interval);
+        if (millis > 0) {
+            options.interval = std::chrono::milliseconds(millis);
+        }
+    }
+    return options;
+}
+
+CheckpointStore::CheckpointStore(Options options)
+    : m_options(std::move(options)) {
+    if (isEnabled()) {
+        m_nextCheckpoint = Clock::now() + m_options.interval;
+        m_writer         = std::thread(&CheckpointStore::writerLoop, this);
+    }
+}
+
+CheckpointStore::~CheckpointStore() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_changed.notify_all();
+    if (m_writer.joinable()) {
+        m_writer.join();
+    }
+}
+
+void CheckpointStore::add(Checkpointable& component) {
+    std::lock_guard<std::mutex> lock(m_serializeMutex);
+    m_entries.push_back({&component, 0, false, {}});
+}
+
+std::size_t CheckpointStore::restore() {
+    if (!isEnabled()) {
+        return 0;
+    }
+
+    const auto       start = Clock::now();
+    const MappedFile file(m_options.path);
+    if (file.data() == nullptr) {
+        velocitas::logger().info("💾 No checkpoint at {} - starting fresh", m_options.path);
+        return 0;
+    }
+
+    std::size_t restored = 0;
+    try {
+        BinaryReader reader(file.data(), file.size());
+        const auto*  magic = reader.readBytes(MAGIC.size());
+        if (std::memcmp(magic, MAGIC.data(), MAGIC.size()) != 0) {
+            velocitas::logger().warn("⚠️  {} is not a checkpoint file - ignored", m_options.path);
+            return 0;
+        }
+        const auto formatVersion = reader.read<std::uint32_t>();
+        if (formatVersion != FORMAT_VERSION) {
+            velocitas::logger().warn("⚠️  Checkpoint format {} not supported (expected {})",
+                                     formatVersion, FORMAT_VERSION);
+            return 0;
+        }
+        const auto sectionCount = reader.read<std::uint32_t>();
+        reader.read<std::int64_t>(); // creation time, informational
+
+        std::lock_guard<std::mutex> lock(m_serializeMutex);
+        for (std::uint32_t i = 0; i < sectionCount; ++i) {
+            const auto  name        = reader.readString();
+            const auto  version     = reader.read<std::uint32_t>();
+            const auto  payloadSize = reader.read<std::uint32_t>();
+            const auto* payload     = reader.readBytes(payloadSize);
+            const auto  crc         = reader.read<std::uint32_t>();
+
+            if (crc != crc32(payload, payloadSize)) {
+                velocitas::logger().warn("⚠️  Checkpoint section '{}' corrupt - skipped", name);
+                continue;
+            }
+            for (auto& entry : m_entries) {
+                if (entry.component->getCheckpointName() != name) {
+                    continue;
+                }
+                BinaryReader sectionReader(payload, payloadSize);
+                if (entry.component->restore(sectionReader, version)) {
+                    ++restored;
+                } else {
+                    velocitas::logger().warn("⚠️  Checkpoint section '{}' v{} not restorable",
+                                             name, version);
+                }
+            }
+        }
+    } catch (const std::exception& e) {
+        velocitas::logger().warn("⚠️  Checkpoint {} truncated ({}) - partially restored",
+                                 m_options.path, e.what());
+    }
+
+    velocitas::logger().info(
+        "💾 Restored {} component(s) from {} in {} µs", restored, m_options.path,
+        std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count());
+    return restored;
+}
+
+void CheckpointStore::checkpointNow() {
+    if (!isEnabled()) {
+        return;
+    }
+
+    std::vector<std::uint8_t> image;
+    {
+        std::lock_guard<std::mutex> lock(m_serializeMutex);
+
+        BinaryWriter writer(image);
+        writer.writeBytes(MAGIC.data(), MAGIC.size());
+        writer.write(FORMAT_VERSION);
+        writer.write(static_cast<std::uint32_t>(m_entries.size()));
+        writer.write(static_cast<std::int64_t>(
+            std::chrono::system_clock::now().time_since_epoch() / std::chrono::milliseconds(1)));
+
+        for (auto& entry : m_entries) {
+            const auto generation = entry.component->getGeneration();
+            if (!entry.saved || generation != entry.savedGeneration) {
+                std::vector<std::uint8_t> payload;
+                BinaryWriter              payloadWriter(payload);
+                entry.component->save(payloadWriter);
+
+                entry.section.clear();
+                BinaryWriter sectionWriter(entry.section);
+                sectionWriter.writeString(entry.component->getCheckpointName());
+                sectionWriter.write(entry.component->getCheckpointVersion());
+                sectionWriter.write(static_cast<std::uint32_t>(payload.size()));
+                sectionWriter.writeBytes(payload.data(), payload.size());
+                sectionWriter.write(crc32(payload.data(), payload.size()));
+
+                entry.savedGeneration = generation;
+                entry.saved           = true;
+            }
+            writer.writeBytes(entry.section.data(), entry.section.size());
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending = std::move(image);
+        ++m_queuedSequence;
+    }
+    m_changed.notify_all();
+}
+
+DrainResult CheckpointStore::flush(Clock::time_point deadline) {
+    if (!isEnabled()) {
+        return {};
+    }
+    checkpointNow();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    const auto                   target  = m_queuedSequence;
+    const bool                   written = m_changed.wait_until(
+        lock, deadline, [this, target] { return m_writtenSequence >= target; });
+    return written ? DrainResult{1, 0} : DrainResult{0, 1};
+}
+
+void CheckpointStore::writerLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+        m_changed.wait(lock, [this] { return m_stopping || m_writtenSequence < m_queuedSequence; });
+        if (m_writtenSequence == m_queuedSequence && m_stopping) {
+            return;
+        }
+
+        const auto sequence = m_queuedSequence;
+        auto       image    = std::move(m_pending);
+        lock.unlock();
+        writeFile(image);
+        lock.lock();
+
+        m_writtenSequence = sequence;
+        m_changed.notify_all();
+    }
+}
+
+bool CheckpointStore::writeFile(const std::vector<std::uint8_t>& image) {
+    const auto tempPath = m_options.path + ".tmp";
+    const int  fd       = ::open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        velocitas::logger().warn("⚠️  Checkpoint write to {} failed: {}", tempPath,
+                                 std::strerror(errno));
+        return false;
+    }
+
+    std::size_t written = 0;
+    while (written < image.size()) {
+        const auto result = ::write(fd, image.data() + written, image.size() - written);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            velocitas::logger().warn("⚠️  Checkpoint write failed: {}", std::strerror(errno));
+            ::close(fd);
+            return false;
+        }
+        written += static_cast<std::size_t>(result);
+    }
+    ::fdatasync(fd);
+    ::close(fd);
+
+    if (std::rename(tempPath.c_str(), m_options.path.c_str()) != 0) {
+        velocitas::logger().warn("⚠️  Checkpoint rename failed: {}", std::strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+} // namespace runtime
@@ -0,0 +1,241 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef VEHICLE_APP_RUNTIME_CHECKPOINT_H
+#define VEHICLE_APP_RUNTIME_CHECKPOINT_H
+
+#include "runtime/Shutdown.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace runtime {
+
+/**
+ * @brief Appends trivially copyable values to a byte buffer (host byte order).
+ */
+class BinaryWriter {
+public:
+    explicit BinaryWriter(std::vector<std::uint8_t>& buffer)
+        : m_buffer(buffer) {}
+
+    template <typename T>
+    void write(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "BinaryWriter needs trivially copyable types");
+        const auto offset = m_buffer.size();
+        m_buffer.resize(offset + sizeof(T));
+        std::memcpy(m_buffer.data() + offset, &value, sizeof(T));
+    }
+
+    void writeBytes(const void* data, std::size_t size) {
+        const auto* bytes = static_cast<const std::uint8_t*>(data);
+        m_buffer.insert(m_buffer.end(), bytes, bytes + size);
+    }
+
+    void writeString(const std::string& value) {
+        write(static_cast<std::uint32_t>(value.size()));
+        writeBytes(value.data(), value.size());
+    }
+
+private:
+    std::vector<std::uint8_t>& m_buffer;
+};
+
+/**
+ * @brief Reads values written by BinaryWriter; throws std::out_of_range on truncated data.
+ */
+class BinaryReader {
+public:
+    BinaryReader(const std::uint8_t* data, std::size_t size)
+        : m_data(data)
+        , m_size(size) {}
+
+    template <typename T>
+    T read() {
+        static_assert(std::is_trivially_copyable_v<T>, "BinaryReader needs trivially copyable types");
+        T value;
+        std::memcpy(&value, take(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    const std::uint8_t* readBytes(std::size_t size) { return take(size); }
+
+    std::string readString() {
+        const auto  size = read<std::uint32_t>();
+        const auto* data = take(size);
+        return {reinterpret_cast<const char*>(data), size};
+    }
+
+    [[nodiscard]] std::size_t remaining() const { return m_size - m_offset; }
+
+private:
+    const std::uint8_t* take(std::size_t size) {
+        if (size > remaining()) {
+            throw std::out_of_range("checkpoint data truncated");
+        }
+        const auto* data = m_data + m_offset;
+        m_offset += size;
+        return data;
+    }
+
+    const std::uint8_t* m_data;
+    std::size_t         m_size;
+    std::size_t         m_offset{0};
+};
+
+/**
+ * @brief A stateful component whose state survives restarts.
+ *
+ * Components are serialised on the thread that calls CheckpointStore::tick(),
+ * i.e. the thread that owns their state, so they need no locking of their own.
+ */
+class Checkpointable {
+public:
+    virtual ~Checkpointable() = default;
+
+    /**
+     * @brief Unique section name in the snapshot file.
+     */
+    [[nodiscard]] virtual std::string getCheckpointName() const = 0;
+
+    /**
+     * @brief Schema version of save(); passed back to restore() for migrations.
+     */
+    [[nodiscard]] virtual std::uint32_t getCheckpointVersion() const { return 1; }
+
+    /**
+     * @brief Changes whenever the state changes. Unchanged components are not re-serialised.
+     */
+    [[nodiscard]] virtual std::uint64_t getGeneration() const = 0;
+
+    virtual void save(BinaryWriter& writer) const = 0;
+
+    /**
+     * @brief Restore from a section written with the given schema version.
+     * @return false if the version is not supported - the component then starts empty.
+     */
+    virtual bool restore(BinaryReader& reader, std::uint32_t version) = 0;
+};
+
+/**
+ * @brief Periodic, incremental snapshots of registered components with warm restart.
+ *
+ * The snapshot is a single binary file:
+ *
+ *   header  : magic "VAPPSNAP", format version, section count, creation time
+ *   section : name, component schema version, payload size, payload, CRC-32
+ *
+ * tick() is cheap until the interval has elapsed. Then it re-serialises only
+ * components whose generation changed and hands the assembled image to a
+ * background writer, which writes a temporary file and renames it over the old
+ * snapshot, so a crash never leaves a torn file. restore() maps the file
+ * read-only and feeds each section to the component with the same name;
+ * unknown sections, corrupt sections and unsupported versions are skipped.
+ *
+ * Environment:
+ *   APP_CHECKPOINT_FILE=/data/app.snap    enables checkpointing
+ *   APP_CHECKPOINT_INTERVAL_MS=5000       snapshot period
+ */
+class CheckpointStore {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::uint32_t FORMAT_VERSION = 1;
+
+    struct Options {
+        std::string               path;
+        std::chrono::milliseconds interval{5000};
+
+        static Options fromEnvironment();
+    };
+
+    explicit CheckpointStore(Options options);
+    ~CheckpointStore();
+
+    CheckpointStore(const CheckpointStore&)            = delete;
+    CheckpointStore& operator=(const CheckpointStore&) = delete;
+    CheckpointStore(CheckpointStore&&)                 = delete;
+    CheckpointStore& operator=(CheckpointStore&&)      = delete;
+
+    [[nodiscard]] bool isEnabled() const { return !m_options.path.empty(); }
+
+    /**
+     * @brief Register a component. The component must outlive the store.
+     */
+    void add(Checkpointable& component);
+
+    /**
+     * @brief Load the snapshot into the registered components.
+     * @return number of components restored
+     */
+    std::size_t restore();
+
+    /**
+     * @brief Call from the processing path; snapshots when the interval has elapsed.
+     */
+    void tick(Clock::time_point now = Clock::now()) {
+        if (isEnabled() && now >= m_nextCheckpoint) {
+            m_nextCheckpoint = now + m_options.interval;
+            checkpointNow();
+        }
+    }
+
+    /**
+     * @brief Serialise changed components and queue the image for writing.
+     */
+    void checkpointNow();
+
+    /**
+     * @brief Checkpoint and wait for the write to finish - usable as a shutdown drain hook.
+     */
+    DrainResult flush(Clock::time_point deadline);
+
+private:
+    struct Entry {
+        Checkpointable*           component;
+        std::uint64_t             savedGeneration{0};
+        bool                      saved{false};
+        std::vector<std::uint8_t> section;
+    };
+
+    void writerLoop();
+    bool writeFile(const std::vector<std::uint8_t>& image);
+
+    Options            m_options;
+    std::vector<Entry> m_entries;
+    Clock::time_point  m_nextCheckpoint{};
+    std::mutex         m_serializeMutex;
+
+    std::mutex                m_mutex;
+    std::condition_variable   m_changed;
+    std::vector<std::uint8_t> m_pending;
+    std::uint64_t             m_queuedSequence{0};
+    std::uint64_t             m_writtenSequence{0};
+    bool                      m_stopping{false};
+    std::thread               m_writer;
+};
+
+} // namespace runtime
+
+#endif // VEHICLE_APP_RUNTIME_CHECKPOINT_H
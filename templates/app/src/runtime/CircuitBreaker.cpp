@@ -0,0 +1,140 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "runtime/CircuitBreaker.h"
+
+#include "sdk/Logger.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+
+namespace runtime {
+
+namespace {
+
+void readMillis(const std::string& name, std::chrono::milliseconds& value) {
+    if (const char* text = std::getenv(name.c_str())) {
+        const long ms = std::atol(text);
+        if (ms > 0) {
+            value = std::chrono::milliseconds(ms);
+        }
+    }
+}
+
+} // namespace
+
+CircuitBreaker::Options CircuitBreaker::Options::withEnvironment(const std::string& sinkName) const {
+    std::string prefix = "APP_SINK_";
+    for (const char c : sinkName) {
+        prefix += c == '-' ? '_' : static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    }
+    Options options = *this;
+    readMillis(prefix + "_SLOW_MS", options.slowCall);
+    readMillis(prefix + "_OPEN_MS", options.openFor);
+    if (const char* trip = std::getenv((prefix + "_TRIP").c_str())) {
+        const long count = std::atol(trip);
+        if (count > 0) {
+            options.tripThreshold = static_cast<std::size_t>(count);
+        }
+    }
+    return options;
+}
+
+CircuitBreaker::CircuitBreaker(std::string name, Options options)
+    : m_name(std::move(name))
+    , m_options(options) {
+    m_options.window        = std::max<std::size_t>(m_options.window, 1);
+    m_options.tripThreshold = std::clamp<std::size_t>(m_options.tripThreshold, 1, m_options.window);
+    m_options.probes        = std::max<std::size_t>(m_options.probes, 1);
+    m_outcomes.assign(m_options.window, false);
+}
+
+bool CircuitBreaker::allowRequest(Clock::time_point now) {
+    switch (getState()) {
+    case State::Closed:
+    case State::HalfOpen:
+        return true;
+    case State::Open:
+        if (now < m_openUntil) {
+            return false;
+        }
+        m_goodProbes = 0;
+        m_state.store(State::HalfOpen, std::memory_order_relaxed);
+        velocitas::logger().info("🔌 Sink {}: half-open, probing", m_name);
+        return true;
+    }
+    return false;
+}
+
+void CircuitBreaker::record(bool succeeded, Clock::duration latency, Clock::time_point now) {
+    const bool bad = !succeeded || latency > m_options.slowCall;
+
+    if (getState() == State::HalfOpen) {
+        m_probeCount.fetch_add(1, std::memory_order_relaxed);
+        if (bad) {
+            trip(now);
+        } else if (++m_goodProbes >= m_options.probes) {
+            close();
+        }
+        return;
+    }
+
+    // Sliding window of the last calls
+    if (m_recorded == m_options.window && m_outcomes[m_next]) {
+        --m_bad;
+    }
+    m_outcomes[m_next] = bad;
+    m_next             = (m_next + 1) % m_options.window;
+    m_recorded         = std::min(m_recorded + 1, m_options.window);
+    if (bad) {
+        ++m_bad;
+    }
+    if (getState() == State::Closed && m_bad >= m_options.tripThreshold) {
+        trip(now);
+    }
+}
+
+const char* CircuitBreaker::getStateName() const {
+    switch (getState()) {
+    case State::Closed:
+        return "closed";
+    case State::Open:
+        return "open";
+    case State::HalfOpen:
+        return "half-open";
+    }
+    return "unknown";
+}
+
+void CircuitBreaker::trip(Clock::time_point now) {
+    m_openUntil = now + m_options.openFor;
+    m_state.store(State::Open, std::memory_order_relaxed);
+    m_trips.fetch_add(1, std::memory_order_relaxed);
+    velocitas::logger().warn("🔌 Sink {}: circuit open for {} ms ({} of last {} calls bad)", m_name,
+                             m_options.openFor.count(), m_bad, m_recorded);
+}
+
+void CircuitBreaker::close() {
+    std::fill(m_outcomes.begin(), m_outcomes.end(), false);
+    m_next     = 0;
+    m_recorded = 0;
+    m_bad      = 0;
+    m_state.store(State::Closed, std::memory_order_relaxed);
+    velocitas::logger().info("🔌 Sink {}: circuit closed", m_name);
+}
+
+} // namespace runtime
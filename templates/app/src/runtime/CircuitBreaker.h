@@ -0,0 +1,112 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef VEHICLE_APP_RUNTIME_CIRCUITBREAKER_H
+#define VEHICLE_APP_RUNTIME_CIRCUITBREAKER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace runtime {
+
+/**
+ * @brief Circuit breaker for one output sink, tripped by errors and slow calls.
+ *
+ * The outcomes of the last Options::window calls are kept; a call that failed or
+ * took longer than Options::slowCall is bad. When Options::tripThreshold of them
+ * are bad the breaker opens and allowRequest() refuses calls for Options::openFor.
+ * After that it is half-open: calls are let through as probes, and
+ * Options::probes good ones in a row close it again while a bad one reopens it.
+ *
+ * allowRequest() and record() belong to the thread that calls the sink; the
+ * state and counters can be read from any thread.
+ *
+ * Environment overrides, with NAME the upper-cased sink name ('-' becomes '_'):
+ *   APP_SINK_<NAME>_SLOW_MS=100    calls slower than this count as bad
+ *   APP_SINK_<NAME>_TRIP=10        bad calls among the last 20 that open the breaker
+ *   APP_SINK_<NAME>_OPEN_MS=5000   time before the first half-open probe
+ */
+class CircuitBreaker {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class State : std::uint8_t { Closed, Open, HalfOpen };
+
+    struct Options {
+        std::chrono::milliseconds slowCall{100};
+        std::size_t               window{20};
+        std::size_t               tripThreshold{10};
+        std::chrono::milliseconds openFor{5000};
+        std::size_t               probes{3};
+
+        Options withEnvironment(const std::string& sinkName) const;
+    };
+
+    CircuitBreaker(std::string name, Options options);
+
+    CircuitBreaker(const CircuitBreaker&)            = delete;
+    CircuitBreaker& operator=(const CircuitBreaker&) = delete;
+    CircuitBreaker(CircuitBreaker&&)                 = delete;
+    CircuitBreaker& operator=(CircuitBreaker&&)      = delete;
+
+    /**
+     * @brief True if the sink may be called now; moves Open to HalfOpen when due.
+     */
+    bool allowRequest(Clock::time_point now = Clock::now());
+
+    /**
+     * @brief Record the outcome of a sink call.
+     */
+    void record(bool succeeded, Clock::duration latency, Clock::time_point now = Clock::now());
+
+    /**
+     * @brief When an open breaker allows its next probe.
+     */
+    [[nodiscard]] Clock::time_point getRetryTime() const { return m_openUntil; }
+
+    [[nodiscard]] State getState() const { return m_state.load(std::memory_order_relaxed); }
+    [[nodiscard]] const char*   getStateName() const;
+    [[nodiscard]] std::uint64_t getTripCount() const {
+        return m_trips.load(std::memory_order_relaxed);
+    }
+    [[nodiscard]] std::uint64_t getProbeCount() const {
+        return m_probeCount.load(std::memory_order_relaxed);
+    }
+
+private:
+    void trip(Clock::time_point now);
+    void close();
+
+    std::string                m_name;
+    Options                    m_options;
+    std::vector<bool>          m_outcomes; // true = bad, ring of the last window calls
+    std::size_t                m_next{0};
+    std::size_t                m_recorded{0};
+    std::size_t                m_bad{0};
+    std::size_t                m_goodProbes{0};
+    Clock::time_point          m_openUntil{};
+    std::atomic<State>         m_state{State::Closed};
+    std::atomic<std::uint64_t> m_trips{0};
+    std::atomic<std::uint64_t> m_probeCount{0};
+};
+
+} // namespace runtime
+
+#endif // VEHICLE_APP_RUNTIME_CIRCUITBREAKER_H
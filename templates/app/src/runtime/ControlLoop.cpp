@@ -0,0 +1,140 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "runtime/ControlLoop.h"
+
+#include "runtime/LaunchOptions.h"
+#include "sdk/Logger.h"
+
+#include <cerrno>
+#include <cstdlib>
+#include <ctime>
+#include <exception>
+
+namespace runtime {
+
+namespace {
+
+constexpr std::int64_t NANOS_PER_SECOND = 1000000000;
+
+std::int64_t toNanos(const timespec& time) {
+    return static_cast<std::int64_t>(time.tv_sec) * NANOS_PER_SECOND + time.tv_nsec;
+}
+
+timespec fromNanos(std::int64_t nanos) {
+    timespec time{};
+    time.tv_sec  = static_cast<time_t>(nanos / NANOS_PER_SECOND);
+    time.tv_nsec = static_cast<long>(nanos % NANOS_PER_SECOND);
+    return time;
+}
+
+std::int64_t monotonicNow() {
+    timespec now{};
+    ::clock_gettime(CLOCK_MONOTONIC, &now);
+    return toNanos(now);
+}
+
+} // namespace
+
+ControlLoop::Options ControlLoop::Options::fromEnvironment() {
+    Options options;
+    if (const char* period = std::getenv("APP_CONTROL_PERIOD_MS")) {
+        const double millis = std::atof(period);
+        if (millis > 0.0) {
+            options.period = std::chrono::microseconds(static_cast<std::int64_t>(millis * 1000.0));
+        }
+    }
+    return options;
+}
+
+ControlLoop::ControlLoop(std::string name, Options options)
+    : m_name(std::move(name))
+    , m_options(options) {}
+
+ControlLoop::~ControlLoop() {
+    stop();
+}
+
+bool ControlLoop::start(Step step) {
+    if (!isEnabled() || m_thread.joinable()) {
+        return false;
+    }
+    m_step = std::move(step);
+    m_running.store(true);
+    m_thread = std::thread(&ControlLoop::loop, this);
+    velocitas::logger().info("⏱️  Control loop '{}' running every {} us", m_name,
+                             m_options.period.count());
+    return true;
+}
+
+void ControlLoop::stop() {
+    m_running.store(false);
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void ControlLoop::report() const {
+    if (getIterations() == 0) {
+        return;
+    }
+    velocitas::logger().info(
+        "⏱️  Control loop '{}': {} steps, {} overruns, {} missed deadlines | jitter p50 {} us "
+        "p99 {} us max {} us | step p50 {} us p99 {} us max {} us",
+        m_name, getIterations(), getOverruns(), getMissedDeadlines(),
+        m_jitter.getPercentile(0.5).count(), m_jitter.getPercentile(0.99).count(),
+        m_jitter.getMax().count(), m_execution.getPercentile(0.5).count(),
+        m_execution.getPercentile(0.99).count(), m_execution.getMax().count());
+}
+
+void ControlLoop::loop() {
+    applyToThisThread(LaunchOptions::current().processing, "control");
+
+    const std::int64_t period  = m_options.period.count() * 1000;
+    std::int64_t       release = monotonicNow() + period;
+
+    while (m_running.load(std::memory_order_relaxed)) {
+        const timespec wakeAt = fromNanos(release);
+        int            error  = 0;
+        do {
+            error = ::clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wakeAt, nullptr);
+        } while (error == EINTR);
+
+        const std::int64_t woke = monotonicNow();
+        m_jitter.record(std::chrono::nanoseconds(woke - release));
+
+        try {
+            m_step();
+        } catch (const std::exception& e) {
+            velocitas::logger().error("❌ Control loop '{}' step failed: {}", m_name, e.what());
+        }
+
+        const std::int64_t finished = monotonicNow();
+        m_execution.record(std::chrono::nanoseconds(finished - woke));
+        m_iterations.fetch_add(1, std::memory_order_relaxed);
+
+        release += period;
+        if (finished > release) {
+            // Overrun: skip the release times already in the past, stay on the grid.
+            const std::int64_t skipped = (finished - release) / period + 1;
+            m_overruns.fetch_add(1, std::memory_order_relaxed);
+            m_missed.fetch_add(static_cast<std::uint64_t>(skipped), std::memory_order_relaxed);
+            release += skipped * period;
+        }
+    }
+}
+
+} // namespace runtime
@@ -0,0 +1,118 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef VEHICLE_APP_RUNTIME_CONTROLLOOP_H
+#define VEHICLE_APP_RUNTIME_CONTROLLOOP_H
+
+#include "runtime/Histogram.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+
+namespace runtime {
+
+/**
+ * @brief Runs a control step at a fixed rate on its own thread.
+ *
+ * The thread sleeps with clock_nanosleep(TIMER_ABSTIME) towards absolute
+ * CLOCK_MONOTONIC release times, so the period does not drift with the step's
+ * execution time or scheduling noise. The step should read its inputs from
+ * latest-value state (SignalTable) and hand outputs to the ActuatorQueue -
+ * never block on the databroker.
+ *
+ * Recorded per loop:
+ * - jitter: how late the thread woke up relative to its release time
+ * - execution time of the step
+ * - overruns: steps that finished after the next release time
+ * - missed deadlines: release times skipped entirely because of an overrun
+ *   (the loop re-aligns to the period grid instead of running catch-up steps)
+ *
+ * The thread uses the "processing" launch options (CPU pinning, SCHED_FIFO).
+ *
+ * Environment:
+ *   APP_CONTROL_PERIOD_MS=100   enable the template's control loop with this period
+ */
+class ControlLoop {
+public:
+    using Step = std::function<void()>;
+
+    struct Options {
+        std::chrono::microseconds period{0}; // 0 = disabled
+
+        static Options fromEnvironment();
+    };
+
+    ControlLoop(std::string name, Options options);
+    ~ControlLoop();
+
+    ControlLoop(const ControlLoop&)            = delete;
+    ControlLoop& operator=(const ControlLoop&) = delete;
+    ControlLoop(ControlLoop&&)                 = delete;
+    ControlLoop& operator=(ControlLoop&&)      = delete;
+
+    /**
+     * @brief Start calling step once per period. Returns false if disabled.
+     */
+    bool start(Step step);
+
+    /**
+     * @brief Stop after the current step; returns within one period. Idempotent.
+     */
+    void stop();
+
+    /**
+     * @brief Log iteration counts and jitter/execution percentiles.
+     */
+    void report() const;
+
+    [[nodiscard]] bool                      isEnabled() const { return m_options.period.count() > 0; }
+    [[nodiscard]] std::chrono::microseconds getPeriod() const { return m_options.period; }
+
+    [[nodiscard]] std::uint64_t getIterations() const {
+        return m_iterations.load(std::memory_order_relaxed);
+    }
+    [[nodiscard]] std::uint64_t getOverruns() const {
+        return m_overruns.load(std::memory_order_relaxed);
+    }
+    [[nodiscard]] std::uint64_t getMissedDeadlines() const {
+        return m_missed.load(std::memory_order_relaxed);
+    }
+    [[nodiscard]] const LatencyHistogram& getJitter() const { return m_jitter; }
+    [[nodiscard]] const LatencyHistogram& getExecutionTime() const { return m_execution; }
+
+private:
+    void loop();
+
+    std::string       m_name;
+    Options           m_options;
+    Step              m_step;
+    std::thread       m_thread;
+    std::atomic<bool> m_running{false};
+
+    std::atomic<std::uint64_t> m_iterations{0};
+    std::atomic<std::uint64_t> m_overruns{0};
+    std::atomic<std::uint64_t> m_missed{0};
+    LatencyHistogram           m_jitter;
+    LatencyHistogram           m_execution;
+};
+
+} // namespace runtime
+
+#endif // VEHICLE_APP_RUNTIME_CONTROLLOOP_H
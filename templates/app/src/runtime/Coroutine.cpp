@@ -0,0 +1,317 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "runtime/Coroutine.h"
+
+#include "runtime/LaunchOptions.h"
+#include "sdk/Logger.h"
+
+#include <array>
+#include <atomic>
+
+namespace runtime {
+
+namespace {
+
+// Size classes 128, 256, ... 4096 bytes
+constexpr std::size_t MIN_CLASS_SHIFT   = 7;
+constexpr std::size_t CLASS_COUNT       = 6;
+constexpr std::size_t FRAMES_PER_REFILL = 16;
+
+static_assert((std::size_t{1} << (MIN_CLASS_SHIFT + CLASS_COUNT - 1)) ==
+              FramePool::MAX_POOLED_FRAME);
+
+struct FreeFrame {
+    FreeFrame* next;
+};
+
+struct SizeClass {
+    std::mutex mutex;
+    FreeFrame* free{nullptr};
+};
+
+std::array<SizeClass, CLASS_COUNT>& sizeClasses() {
+    static std::array<SizeClass, CLASS_COUNT> classes;
+    return classes;
+}
+
+std::atomic<std::uint64_t> pooledCount{0};
+std::atomic<std::uint64_t> heapCount{0};
+
+std::size_t classIndex(std::size_t bytes) {
+    std::size_t index = 0;
+    while ((std::size_t{1} << (MIN_CLASS_SHIFT + index)) < bytes) {
+        ++index;
+    }
+    return index;
+}
+
+thread_local CoScheduler* currentScheduler = nullptr;
+
+} // namespace
+
+void* FramePool::allocate(std::size_t bytes) {
+    if (bytes > MAX_POOLED_FRAME) {
+        heapCount.fetch_add(1, std::memory_order_relaxed);
+        return ::operator new(bytes);
+    }
+    pooledCount.fetch_add(1, std::memory_order_relaxed);
+
+    const std::size_t           index = classIndex(bytes);
+    auto&                       pool  = sizeClasses()[index];
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    if (pool.free == nullptr) {
+        // Chunks stay allocated for the lifetime of the process
+        const std::size_t frameSize = std::size_t{1} << (MIN_CLASS_SHIFT + index);
+        auto* chunk = static_cast<std::byte*>(::operator new(frameSize * FRAMES_PER_REFILL));
+        for (std::size_t i = 0; i < FRAMES_PER_REFILL; ++i) {
+            auto* frame = reinterpret_cast<FreeFrame*>(chunk + i * frameSize);
+            frame->next = pool.free;
+            pool.free   = frame;
+        }
+    }
+    FreeFrame* frame = pool.free;
+    pool.free        = frame->next;
+    return frame;
+}
+
+void FramePool::deallocate(void* frame, std::size_t bytes) noexcept {
+    if (bytes > MAX_POOLED_FRAME) {
+        ::operator delete(frame);
+        return;
+    }
+    auto&                       pool = sizeClasses()[classIndex(bytes)];
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    auto*                       freed = static_cast<FreeFrame*>(frame);
+    freed->next                       = pool.free;
+    pool.free                         = freed;
+}
+
+std::uint64_t FramePool::getPooledCount() {
+    return pooledCount.load(std::memory_order_relaxed);
+}
+
+std::uint64_t FramePool::getHeapCount() {
+    return heapCount.load(std::memory_order_relaxed);
+}
+
+/**
+ * Starts suspended so spawn() can queue it; on completion it reports to the
+ * scheduler and destroys its own frame.
+ */
+struct CoScheduler::Detached {
+    struct promise_type : detail::PooledFrame {
+        // Receives the coroutine's own parameters, which live in the frame
+        promise_type(CoScheduler& owner, const std::string& taskName, Task<void>& /*task*/)
+            : scheduler(owner)
+            , name(taskName) {}
+
+        struct Finish {
+            [[nodiscard]] bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<promise_type> self) const noexcept {
+                self.promise().scheduler.finished(self, self.promise().failed);
+            }
+            void await_resume() const noexcept {}
+        };
+
+        Detached get_return_object() {
+            return {std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        Finish              final_suspend() const noexcept { return {}; }
+        void                return_void() const noexcept {}
+
+        void unhandled_exception() noexcept {
+            failed = true;
+            try {
+                throw;
+            } catch (const std::exception& e) {
+                velocitas::logger().error("❌ Coroutine '{}' failed: {}", name, e.what());
+            } catch (...) {
+                velocitas::logger().error("❌ Coroutine '{}' failed", name);
+            }
+        }
+
+        CoScheduler&       scheduler;
+        const std::string& name;
+        bool               failed{false};
+    };
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+CoScheduler::Detached CoScheduler::runDetached(CoScheduler& /*scheduler*/, std::string /*name*/,
+                                               Task<void> task) {
+    co_await std::move(task);
+}
+
+CoScheduler* CoScheduler::current() {
+    return currentScheduler;
+}
+
+CoScheduler& CoScheduler::requireCurrent() {
+    if (currentScheduler == nullptr) {
+        throw std::logic_error("co_await outside a CoScheduler thread");
+    }
+    return *currentScheduler;
+}
+
+CoScheduler::CoScheduler(std::string name)
+    : m_name(std::move(name)) {
+    m_ready.reserve(64);
+}
+
+CoScheduler::~CoScheduler() {
+    stop();
+}
+
+void CoScheduler::start() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_thread.joinable() || m_stopped) {
+        return;
+    }
+    m_thread = std::thread(&CoScheduler::loop, this);
+}
+
+void CoScheduler::spawn(std::string name, Task<void> task) {
+    auto detached = runDetached(*this, std::move(name), std::move(task)).handle;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_stopped) {
+            detached.destroy();
+            return;
+        }
+        m_live.insert(detached.address());
+        m_ready.push_back(detached);
+        ++m_spawned;
+    }
+    m_wake.notify_one();
+}
+
+void CoScheduler::post(std::coroutine_handle<> handle) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_stopped) {
+            return;
+        }
+        m_ready.push_back(handle);
+    }
+    m_wake.notify_one();
+}
+
+void CoScheduler::resumeAt(Clock::time_point due, std::coroutine_handle<> handle) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_timers.push({due, handle});
+}
+
+DrainResult CoScheduler::stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+
+    std::unordered_set<void*> cancelled;
+    DrainResult               result;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_stopped) {
+            return result;
+        }
+        m_stopped = true;
+        m_ready.clear();
+        m_timers = TimerQueue{};
+        cancelled.swap(m_live);
+        result.drained = m_completed;
+    }
+    // Destroying a detached frame destroys the task chain it is awaiting
+    for (void* frame : cancelled) {
+        std::coroutine_handle<>::from_address(frame).destroy();
+    }
+    result.dropped = cancelled.size();
+    if (result.dropped > 0) {
+        velocitas::logger().info("🧵 Coroutine scheduler '{}': cancelled {} suspended tasks",
+                                 m_name, result.dropped);
+    }
+    return result;
+}
+
+std::uint64_t CoScheduler::getSpawnedCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_spawned;
+}
+
+std::uint64_t CoScheduler::getCompletedCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_completed;
+}
+
+std::uint64_t CoScheduler::getFailedCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_failed;
+}
+
+void CoScheduler::finished(std::coroutine_handle<> detached, bool failed) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_live.erase(detached.address());
+        ++m_completed;
+        if (failed) {
+            ++m_failed;
+        }
+    }
+    detached.destroy();
+}
+
+void CoScheduler::loop() {
+    applyToThisThread(LaunchOptions::current().processing, "coroutines");
+    currentScheduler = this;
+
+    std::vector<std::coroutine_handle<>> batch;
+    batch.reserve(m_ready.capacity());
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_stopping) {
+        const auto now = Clock::now();
+        while (!m_timers.empty() && m_timers.top().due <= now) {
+            m_ready.push_back(m_timers.top().handle);
+            m_timers.pop();
+        }
+        if (m_ready.empty()) {
+            if (m_timers.empty()) {
+                m_wake.wait(lock);
+            } else {
+                m_wake.wait_until(lock, m_timers.top().due);
+            }
+            continue;
+        }
+
+        // Swap keeps both buffers' capacity, so steady-state scheduling does not allocate
+        batch.swap(m_ready);
+        lock.unlock();
+        for (auto handle : batch) {
+            handle.resume();
+        }
+        batch.clear();
+        lock.lock();
+    }
+    currentScheduler = nullptr;
+}
+
+} // namespace runtime
@@ -0,0 +1,522 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef VEHICLE_APP_RUNTIME_COROUTINE_H
+#define VEHICLE_APP_RUNTIME_COROUTINE_H
+
+#include "runtime/Shutdown.h"
+#include "sdk/AsyncResult.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace runtime {
+
+/**
+ * @brief Error reported by the databroker for an awaited get/set or subscription.
+ */
+class AsyncError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+/**
+ * @brief Size-class free lists for coroutine frames.
+ *
+ * Frames are carved from chunks that are never returned to the heap, so once a
+ * routine has run once, starting it again costs a list pop instead of malloc.
+ * Frames larger than the biggest class fall back to operator new and are counted.
+ */
+class FramePool {
+public:
+    static constexpr std::size_t MAX_POOLED_FRAME = 4096;
+
+    static void* allocate(std::size_t bytes);
+    static void  deallocate(void* frame, std::size_t bytes) noexcept;
+
+    [[nodiscard]] static std::uint64_t getPooledCount();
+    [[nodiscard]] static std::uint64_t getHeapCount();
+};
+
+template <typename T = void>
+class Task;
+
+namespace detail {
+
+struct PooledFrame {
+    static void* operator new(std::size_t bytes) { return FramePool::allocate(bytes); }
+    static void  operator delete(void* frame, std::size_t bytes) noexcept {
+        FramePool::deallocate(frame, bytes);
+    }
+};
+
+struct ResumeContinuation {
+    [[nodiscard]] bool await_ready() const noexcept { return false; }
+
+    template <typename Promise>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> self) const noexcept {
+        if (auto continuation = self.promise().continuation) {
+            return continuation;
+        }
+        return std::noop_coroutine();
+    }
+
+    void await_resume() const noexcept {}
+};
+
+struct TaskPromiseBase : PooledFrame {
+    std::coroutine_handle<> continuation;
+    std::exception_ptr      error;
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    ResumeContinuation  final_suspend() const noexcept { return {}; }
+    void                unhandled_exception() noexcept { error = std::current_exception(); }
+};
+
+template <typename T>
+struct TaskPromise : TaskPromiseBase {
+    std::optional<T> value;
+
+    Task<T> get_return_object();
+
+    template <typename U>
+    void return_value(U&& result) {
+        value.emplace(std::forward<U>(result));
+    }
+
+    T take() {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        return std::move(*value);
+    }
+};
+
+template <>
+struct TaskPromise<void> : TaskPromiseBase {
+    Task<void> get_return_object();
+
+    void return_void() const noexcept {}
+
+    void take() const {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief Lazily started coroutine returning T.
+ *
+ * A Task does nothing until it is awaited (co_await task) or handed to
+ * CoScheduler::spawn(). Completion resumes the awaiting coroutine directly, and
+ * exceptions thrown in the task are rethrown at the co_await.
+ */
+template <typename T>
+class [[nodiscard]] Task {
+public:
+    using promise_type = detail::TaskPromise<T>;
+
+    explicit Task(std::coroutine_handle<promise_type> handle)
+        : m_handle(handle) {}
+
+    Task(Task&& other) noexcept
+        : m_handle(std::exchange(other.m_handle, {})) {}
+
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            reset();
+            m_handle = std::exchange(other.m_handle, {});
+        }
+        return *this;
+    }
+
+    Task(const Task&)            = delete;
+    Task& operator=(const Task&) = delete;
+
+    ~Task() { reset(); }
+
+    auto operator co_await() && noexcept {
+        struct Awaiter {
+            std::coroutine_handle<promise_type> handle;
+
+            [[nodiscard]] bool await_ready() const noexcept { return !handle || handle.done(); }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+                handle.promise().continuation = awaiting;
+                return handle;
+            }
+
+            T await_resume() { return handle.promise().take(); }
+        };
+        return Awaiter{m_handle};
+    }
+
+private:
+    void reset() {
+        if (m_handle) {
+            m_handle.destroy();
+            m_handle = {};
+        }
+    }
+
+    std::coroutine_handle<promise_type> m_handle;
+};
+
+namespace detail {
+
+template <typename T>
+Task<T> TaskPromise<T>::get_return_object() {
+    return Task<T>{std::coroutine_handle<TaskPromise<T>>::from_promise(*this)};
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() {
+    return Task<void>{std::coroutine_handle<TaskPromise<void>>::from_promise(*this)};
+}
+
+} // namespace detail
+
+/**
+ * @brief Single-threaded scheduler that runs spawned tasks on one thread.
+ *
+ * Every coroutine resumes on the scheduler thread, so routines never race with
+ * each other and need no locks for state they share. Databroker callbacks arrive
+ * on SDK threads and only post the waiting coroutine back to the scheduler;
+ * timers are kept in a heap and served by the same thread. Waiting costs a
+ * suspended frame (pooled, a few hundred bytes) instead of a blocked thread.
+ *
+ * The thread uses the "processing" launch options (CPU pinning, SCHED_FIFO).
+ * stop() destroys tasks that are still suspended: their locals are destructed
+ * at the co_await they were waiting on, and the code after it does not run.
+ */
+class CoScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit CoScheduler(std::string name);
+    ~CoScheduler();
+
+    CoScheduler(const CoScheduler&)            = delete;
+    CoScheduler& operator=(const CoScheduler&) = delete;
+    CoScheduler(CoScheduler&&)                 = delete;
+    CoScheduler& operator=(CoScheduler&&)      = delete;
+
+    /**
+     * @brief Start the scheduler thread. Tasks spawned earlier start running now.
+     */
+    void start();
+
+    /**
+     * @brief Run a task to completion on the scheduler. Callable from any thread.
+     *
+     * An exception escaping the task is logged with the given name.
+     */
+    void spawn(std::string name, Task<void> task);
+
+    /**
+     * @brief Destroy unfinished tasks and join the thread - use as a Shutdown drain hook.
+     * @return tasks that completed, and tasks cancelled as dropped
+     */
+    DrainResult stop();
+
+    /**
+     * @brief Queue a suspended coroutine for resumption. Callable from any thread.
+     */
+    void post(std::coroutine_handle<> handle);
+
+    /**
+     * @brief Resume a coroutine at the given time. Scheduler thread only.
+     */
+    void resumeAt(Clock::time_point due, std::coroutine_handle<> handle);
+
+    /**
+     * @brief The scheduler running on the calling thread, or nullptr.
+     */
+    static CoScheduler* current();
+
+    /**
+     * @brief current(), or std::logic_error when awaited outside a scheduler.
+     */
+    static CoScheduler& requireCurrent();
+
+    [[nodiscard]] std::uint64_t getSpawnedCount() const;
+    [[nodiscard]] std::uint64_t getCompletedCount() const;
+    [[nodiscard]] std::uint64_t getFailedCount() const;
+
+private:
+    struct Timer {
+        Clock::time_point       due;
+        std::coroutine_handle<> handle;
+
+        bool operator>(const Timer& other) const { return due > other.due; }
+    };
+
+    using TimerQueue = std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>>;
+
+    struct Detached; // self-destroying wrapper that owns one spawned task
+
+    static Detached runDetached(CoScheduler& scheduler, std::string name, Task<void> task);
+
+    void loop();
+    void finished(std::coroutine_handle<> detached, bool failed);
+
+    std::string m_name;
+
+    mutable std::mutex                   m_mutex;
+    std::condition_variable              m_wake;
+    std::vector<std::coroutine_handle<>> m_ready;
+    TimerQueue                           m_timers;
+    std::unordered_set<void*>            m_live; // detached frames not yet finished
+    bool                                 m_stopping{false};
+    bool                                 m_stopped{false};
+    std::thread                          m_thread;
+
+    std::uint64_t m_spawned{0};
+    std::uint64_t m_completed{0};
+    std::uint64_t m_failed{0};
+};
+
+/**
+ * @brief Awaitable that resumes the coroutine after a delay.
+ *
+ *   co_await runtime::sleepFor(std::chrono::seconds(5));
+ */
+class SleepAwaiter {
+public:
+    explicit SleepAwaiter(CoScheduler::Clock::time_point due)
+        : m_due(due) {}
+
+    [[nodiscard]] bool await_ready() const noexcept { return m_due <= CoScheduler::Clock::now(); }
+    void               await_suspend(std::coroutine_handle<> handle) const {
+        CoScheduler::requireCurrent().resumeAt(m_due, handle);
+    }
+    void await_resume() const noexcept {}
+
+private:
+    CoScheduler::Clock::time_point m_due;
+};
+
+inline SleepAwaiter sleepUntil(CoScheduler::Clock::time_point due) {
+    return SleepAwaiter{due};
+}
+
+template <typename Rep, typename Period>
+SleepAwaiter sleepFor(std::chrono::duration<Rep, Period> delay) {
+    return SleepAwaiter{CoScheduler::Clock::now() +
+                        std::chrono::duration_cast<CoScheduler::Clock::duration>(delay)};
+}
+
+/**
+ * @brief Awaitable over an SDK AsyncResult - a get, set or any other databroker call.
+ *
+ *   auto temperature = co_await runtime::awaitResult(Vehicle.Cabin.HVAC.AmbientAirTemperature.get());
+ *
+ * The result is delivered on an SDK thread and handed back to the scheduler, so
+ * the coroutine continues on the scheduler thread. Errors throw AsyncError.
+ */
+template <typename T>
+class ResultAwaiter {
+public:
+    explicit ResultAwaiter(velocitas::AsyncResultPtr_t<T> result)
+        : m_result(std::move(result))
+        , m_state(std::make_shared<State>()) {}
+
+    [[nodiscard]] bool await_ready() const noexcept { return false; }
+
+    ResultAwaiter(const ResultAwaiter&)            = delete;
+    ResultAwaiter& operator=(const ResultAwaiter&) = delete;
+    ResultAwaiter(ResultAwaiter&&)                 = default;
+    ResultAwaiter& operator=(ResultAwaiter&&)      = default;
+
+    ~ResultAwaiter() {
+        // A task destroyed while waiting must not be resumed by a late result
+        if (m_state) {
+            std::lock_guard<std::mutex> lock(m_state->mutex);
+            m_state->handle = {};
+        }
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) {
+        {
+            std::lock_guard<std::mutex> lock(m_state->mutex);
+            m_state->scheduler = &CoScheduler::requireCurrent();
+            m_state->handle    = handle;
+        }
+        m_result->onResult([state = m_state](auto&& value) {
+            state->complete([&] { state->value.emplace(std::forward<decltype(value)>(value)); });
+        });
+        m_result->onError([state = m_state](auto&& status) {
+            state->complete([&] { state->error = status.errorMessage(); });
+        });
+    }
+
+    T await_resume() {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        if (!m_state->value) {
+            throw AsyncError(m_state->error);
+        }
+        return std::move(*m_state->value);
+    }
+
+private:
+    struct State {
+        std::mutex              mutex;
+        CoScheduler*            scheduler{nullptr};
+        std::coroutine_handle<> handle;
+        std::optional<T>        value;
+        std::string             error;
+
+        template <typename Update>
+        void complete(Update&& update) {
+            std::lock_guard<std::mutex> lock(mutex);
+            update();
+            if (handle) {
+                scheduler->post(std::exchange(handle, {}));
+            }
+        }
+    };
+
+    velocitas::AsyncResultPtr_t<T> m_result;
+    std::shared_ptr<State>         m_state;
+};
+
+template <typename T>
+ResultAwaiter<T> awaitResult(velocitas::AsyncResultPtr_t<T> result) {
+    return ResultAwaiter<T>{std::move(result)};
+}
+
+/**
+ * @brief Awaitable view of a subscription: co_await next() waits for the next item.
+ *
+ *   runtime::SignalStream speed{subscribeDataPoints(QueryBuilder::select(Vehicle.Speed).build())};
+ *   auto reply = co_await speed.next();
+ *
+ * Items that arrive while the coroutine is busy are coalesced - next() returns
+ * the newest one and the rest are counted. A subscription error throws AsyncError.
+ */
+template <typename T>
+class SignalStream {
+public:
+    explicit SignalStream(velocitas::AsyncSubscriptionPtr_t<T> subscription)
+        : m_subscription(std::move(subscription))
+        , m_state(std::make_shared<State>()) {
+        m_subscription->onItem([state = m_state](auto&& item) {
+            state->deliver([&] {
+                if (state->latest) {
+                    ++state->coalesced;
+                }
+                state->latest.emplace(std::forward<decltype(item)>(item));
+            });
+        });
+        m_subscription->onError([state = m_state](auto&& status) {
+            state->deliver([&] {
+                state->failed = true;
+                state->error  = status.errorMessage();
+            });
+        });
+    }
+
+    SignalStream(const SignalStream&)            = delete;
+    SignalStream& operator=(const SignalStream&) = delete;
+    SignalStream(SignalStream&&)                 = default;
+    SignalStream& operator=(SignalStream&&)      = default;
+
+    ~SignalStream() {
+        // The subscription outlives the stream; later items must not resume a destroyed task
+        if (m_state) {
+            std::lock_guard<std::mutex> lock(m_state->mutex);
+            m_state->waiter = {};
+        }
+    }
+
+    auto next() {
+        struct Awaiter {
+            State* state;
+
+            [[nodiscard]] bool await_ready() const noexcept { return false; }
+
+            bool await_suspend(std::coroutine_handle<> handle) {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                if (state->latest || state->failed) {
+                    return false;
+                }
+                state->scheduler = &CoScheduler::requireCurrent();
+                state->waiter    = handle;
+                return true;
+            }
+
+            T await_resume() {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                if (!state->latest) {
+                    throw AsyncError(state->error);
+                }
+                T item = std::move(*state->latest);
+                state->latest.reset();
+                return item;
+            }
+        };
+        return Awaiter{m_state.get()};
+    }
+
+    [[nodiscard]] std::uint64_t getCoalescedCount() const {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        return m_state->coalesced;
+    }
+
+private:
+    struct State {
+        std::mutex              mutex;
+        std::optional<T>        latest;
+        bool                    failed{false};
+        std::string             error;
+        std::uint64_t           coalesced{0};
+        CoScheduler*            scheduler{nullptr};
+        std::coroutine_handle<> waiter;
+
+        template <typename Update>
+        void deliver(Update&& update) {
+            std::lock_guard<std::mutex> lock(mutex);
+            update();
+            if (waiter) {
+                scheduler->post(std::exchange(waiter, {}));
+            }
+        }
+    };
+
+    velocitas::AsyncSubscriptionPtr_t<T> m_subscription;
+    std::shared_ptr<State>               m_state;
+};
+
+} // namespace runtime
+
+#endif // VEHICLE_APP_RUNTIME_COROUTINE_H
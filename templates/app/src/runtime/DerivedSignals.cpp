@@ -0,0 +1,160 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "runtime/DerivedSignals.h"
+
+#include "sdk/Logger.h"
+
+#include <cstdlib>
+#include <exception>
+
+namespace runtime {
+
+DerivedSignalPublisher::Options DerivedSignalPublisher::Options::fromEnvironment() {
+    Options options;
+    if (const char* interval = std::getenv("APP_DERIVED_PUBLISH_MS")) {
+        const long millis = std::atol(interval);
+        if (millis > 0) {
+            options.interval = std::chrono::milliseconds(millis);
+        }
+    }
+    return options;
+}
+
+DerivedSignalPublisher::DerivedSignalPublisher(const SignalTable& table, Options options)
+    : m_table(table)
+    , m_options(options) {}
+
+DerivedSignalPublisher::~DerivedSignalPublisher() {
+    stopThread();
+}
+
+void DerivedSignalPublisher::publish(int slot, VssDataType type, std::string vssPath) {
+    if (slot < 0) {
+        return;
+    }
+    if (vssPath.empty()) {
+        vssPath = std::string(m_table.getPath(slot));
+    }
+    m_entries.push_back({slot, type, std::move(vssPath)});
+}
+
+bool DerivedSignalPublisher::start(Sink sink) {
+    if (!isEnabled() || m_entries.empty() || m_thread.joinable()) {
+        return false;
+    }
+    m_sink = std::move(sink);
+    m_batch.reserve(m_entries.size());
+    m_thread = std::thread(&DerivedSignalPublisher::loop, this);
+    velocitas::logger().info("📤 Publishing {} derived signal(s) every {} ms", m_entries.size(),
+                             m_options.interval.count());
+    return true;
+}
+
+DrainResult DerivedSignalPublisher::flush(Clock::time_point deadline) {
+    stopThread();
+    if (!m_sink || Clock::now() >= deadline) {
+        return {};
+    }
+    DrainResult result;
+    result.drained = publishChanged();
+    SignalSample sample;
+    for (const auto& entry : m_entries) {
+        if (m_table.read(entry.slot, sample) && sample.updateCount != entry.lastSent) {
+            ++result.dropped;
+        }
+    }
+    return result;
+}
+
+void DerivedSignalPublisher::loop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto                         next = Clock::now() + m_options.interval;
+    while (!m_wake.wait_until(lock, next, [this] { return m_stopping; })) {
+        lock.unlock();
+        publishChanged();
+        lock.lock();
+        // Fixed cadence; after a slow batch skip ahead instead of bursting.
+        next += m_options.interval;
+        const auto now = Clock::now();
+        if (next < now) {
+            next = now + m_options.interval;
+        }
+    }
+}
+
+std::size_t DerivedSignalPublisher::publishChanged() {
+    std::lock_guard<std::mutex> lock(m_publishMutex);
+
+    m_batch.clear();
+    SignalSample sample;
+    for (auto& entry : m_entries) {
+        if (m_table.read(entry.slot, sample) && sample.updateCount != entry.lastSent) {
+            entry.pending = sample.updateCount;
+            m_batch.push_back({&entry.path, entry.type, sample.value, sample.timestampNs});
+        } else {
+            entry.pending = entry.lastSent;
+        }
+    }
+    if (m_batch.empty()) {
+        return 0;
+    }
+
+    bool delivered = false;
+    try {
+        delivered = m_sink(m_batch);
+    } catch (const std::exception& e) {
+        velocitas::logger().warn("⚠️  Derived signal batch failed: {}", e.what());
+    }
+    m_batches.fetch_add(1, std::memory_order_relaxed);
+    if (!delivered) {
+        m_failed.fetch_add(1, std::memory_order_relaxed);
+        return 0;
+    }
+
+    // m_batch holds the dirty entries in m_entries order
+    std::size_t accepted = 0;
+    auto        update   = m_batch.begin();
+    for (auto& entry : m_entries) {
+        if (entry.pending == entry.lastSent) {
+            continue;
+        }
+        if ((update++)->accepted) {
+            // Updates between two batches collapse into the one value that was sent.
+            m_coalesced.fetch_add(entry.pending - entry.lastSent - 1, std::memory_order_relaxed);
+            entry.lastSent = entry.pending;
+            ++accepted;
+        }
+    }
+    if (accepted < m_batch.size()) {
+        m_failed.fetch_add(1, std::memory_order_relaxed);
+    }
+    m_published.fetch_add(accepted, std::memory_order_relaxed);
+    return accepted;
+}
+
+void DerivedSignalPublisher::stopThread() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+} // namespace runtime
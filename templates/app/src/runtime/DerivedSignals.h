@@ -0,0 +1,153 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef VEHICLE_APP_RUNTIME_DERIVEDSIGNALS_H
+#define VEHICLE_APP_RUNTIME_DERIVEDSIGNALS_H
+
+#include "runtime/Shutdown.h"
+#include "runtime/SignalTable.h"
+#include "runtime/VssCatalogLayout.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace runtime {
+
+/**
+ * @brief One derived value handed to the sink. The sink clears accepted for
+ * entries the databroker rejected.
+ */
+struct DerivedUpdate {
+    const std::string* path; // VSS path in the databroker
+    VssDataType        type; // VSS datatype to send the value as
+    double             value;
+    std::int64_t       timestampNs; // CLOCK_MONOTONIC of the latest update
+    bool               accepted{true};
+};
+
+/**
+ * @brief Publishes computed values back to the databroker in batches.
+ *
+ * Derived values (trip distance, smoothed speed, ...) are written to the
+ * SignalTable like any other signal - which also makes them visible to the
+ * query API and the live stream. The publisher wakes up every interval,
+ * collects the slots that changed since the last batch and hands them to the
+ * sink in one call, so a signal updated ten times per interval costs one
+ * entry in one request instead of ten RPCs. Failures are not retried as such:
+ * a rejected entry, or every entry of a failed call, stays dirty and goes out
+ * with its newest value next time.
+ *
+ * Environment:
+ *   APP_DERIVED_PUBLISH_MS=100   enable publishing with this cadence
+ */
+class DerivedSignalPublisher {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Sends one batch; returns false if the call as a whole failed.
+     */
+    using Sink = std::function<bool(std::vector<DerivedUpdate>& batch)>;
+
+    struct Options {
+        std::chrono::milliseconds interval{0}; // 0 = disabled
+
+        static Options fromEnvironment();
+    };
+
+    DerivedSignalPublisher(const SignalTable& table, Options options);
+    ~DerivedSignalPublisher();
+
+    DerivedSignalPublisher(const DerivedSignalPublisher&)            = delete;
+    DerivedSignalPublisher& operator=(const DerivedSignalPublisher&) = delete;
+    DerivedSignalPublisher(DerivedSignalPublisher&&)                 = delete;
+    DerivedSignalPublisher& operator=(DerivedSignalPublisher&&)      = delete;
+
+    /**
+     * @brief Publish a table slot. Call before start().
+     * @param type    VSS datatype of the databroker signal
+     * @param vssPath databroker path, defaults to the slot's table path
+     */
+    void publish(int slot, VssDataType type, std::string vssPath = {});
+
+    /**
+     * @brief Start the publishing thread.
+     * @return false if disabled or nothing was registered with publish()
+     */
+    bool start(Sink sink);
+
+    /**
+     * @brief Stop the thread and send one final batch - use as a Shutdown drain hook.
+     */
+    DrainResult flush(Clock::time_point deadline);
+
+    [[nodiscard]] bool isEnabled() const { return m_options.interval.count() > 0; }
+
+    [[nodiscard]] std::uint64_t getBatchCount() const {
+        return m_batches.load(std::memory_order_relaxed);
+    }
+    [[nodiscard]] std::uint64_t getPublishedCount() const {
+        return m_published.load(std::memory_order_relaxed);
+    }
+    [[nodiscard]] std::uint64_t getCoalescedCount() const {
+        return m_coalesced.load(std::memory_order_relaxed);
+    }
+    // Batches with a failed call or at least one rejected entry
+    [[nodiscard]] std::uint64_t getFailedBatches() const {
+        return m_failed.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Entry {
+        int           slot;
+        VssDataType   type;
+        std::string   path;
+        std::uint64_t lastSent{0}; // table update count of the last published value
+        std::uint64_t pending{0};  // update count included in the batch in flight
+    };
+
+    void        loop();
+    std::size_t publishChanged();
+    void        stopThread();
+
+    const SignalTable&         m_table;
+    Options                    m_options;
+    Sink                       m_sink;
+    std::vector<Entry>         m_entries;
+    std::vector<DerivedUpdate> m_batch;        // reused, entries point into m_entries
+    std::mutex                 m_publishMutex; // one batch at a time (thread vs. flush)
+
+    std::mutex              m_mutex;
+    std::condition_variable m_wake;
+    bool                    m_stopping{false};
+    std::thread             m_thread;
+
+    std::atomic<std::uint64_t> m_batches{0};
+    std::atomic<std::uint64_t> m_published{0};
+    std::atomic<std::uint64_t> m_coalesced{0};
+    std::atomic<std::uint64_t> m_failed{0};
+};
+
+} // namespace runtime
+
+#endif // VEHICLE_APP_RUNTIME_DERIVEDSIGNALS_H
@@ -0,0 +1,193 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "runtime/FastLane.h"
+
+#include "runtime/AllocTripwire.h"
+#include "runtime/LaunchOptions.h"
+#include "sdk/Logger.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+
+namespace runtime {
+
+FastLane::Options FastLane::Options::fromEnvironment() {
+    Options options;
+    if (const char* enabled = std::getenv("APP_FAST_LANE")) {
+        options.enabled = std::strcmp(enabled, "1") == 0 || std::strcmp(enabled, "true") == 0;
+    }
+    if (const char* queue = std::getenv("APP_FAST_LANE_QUEUE")) {
+        const long capacity = std::atol(queue);
+        if (capacity > 0) {
+            options.queueCapacity = static_cast<std::size_t>(capacity);
+        }
+    }
+    return options;
+}
+
+FastLane::FastLane(Options options)
+    : m_options(options) {}
+
+FastLane::~FastLane() {
+    flush(Clock::now());
+}
+
+int FastLane::addSignal(std::string path, Handler handler, Handler followUp) {
+    auto signal      = std::make_unique<Signal>();
+    signal->path     = std::move(path);
+    signal->handler  = std::move(handler);
+    signal->followUp = std::move(followUp);
+    signal->queue    = std::make_unique<RingBuffer<CriticalEvent>>(m_options.queueCapacity);
+    m_signals.push_back(std::move(signal));
+    return static_cast<int>(m_signals.size() - 1);
+}
+
+bool FastLane::start() {
+    if (!isEnabled() || m_signals.empty() || m_running.exchange(true)) {
+        return false;
+    }
+    m_thread = std::thread(&FastLane::loop, this);
+    velocitas::logger().info("🚨 Fast lane: {} critical signals on a dedicated thread",
+                             m_signals.size());
+    return true;
+}
+
+void FastLane::post(int signal, double value, Clock::time_point received) {
+    auto& target = *m_signals[signal];
+    if (!target.queue->tryPush(CriticalEvent{signal, value, received})) {
+        target.metrics.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    // Pairs with the fence in loop(): either we see the thread asleep or it sees the event
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_sleeping.load(std::memory_order_relaxed)) {
+        { std::lock_guard<std::mutex> lock(m_wakeMutex); }
+        m_wakeUp.notify_one();
+    }
+}
+
+DrainResult FastLane::flush(Clock::time_point deadline) {
+    DrainResult result;
+    if (!m_running.load()) {
+        return result;
+    }
+    std::uint64_t handledBefore = 0;
+    for (const auto& signal : m_signals) {
+        handledBefore += signal->metrics.handled.load();
+    }
+    while (hasInput() && Clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_running.store(false);
+    }
+    m_wakeUp.notify_all();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    for (const auto& signal : m_signals) {
+        result.drained += signal->metrics.handled.load();
+        result.dropped += signal->queue->size();
+    }
+    result.drained -= handledBefore;
+    return result;
+}
+
+void FastLane::report() const {
+    for (const auto& signal : m_signals) {
+        const auto& m = signal->metrics;
+        velocitas::logger().info(
+            "🚨 Fast lane {}: {} handled, {} dropped | latency p50 {} us p99 {} us max {} us | "
+            "service p99 {} us",
+            signal->path, m.handled.load(), m.dropped.load(), m.latency.getPercentile(0.5).count(),
+            m.latency.getPercentile(0.99).count(), m.latency.getMax().count(),
+            m.service.getPercentile(0.99).count());
+    }
+}
+
+bool FastLane::hasInput() const {
+    for (const auto& signal : m_signals) {
+        if (!signal->queue->empty()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool FastLane::drainOnce() {
+    bool          any = false;
+    CriticalEvent event;
+    // Signals are served in registration order - register the most urgent first
+    for (auto& signal : m_signals) {
+        while (signal->queue->tryPop(event)) {
+            any               = true;
+            const auto begin  = Clock::now();
+            bool       failed = false;
+            {
+                AllocTripwire::Scope noAlloc;
+                try {
+                    signal->handler(event);
+                } catch (const std::exception& e) {
+                    // Copied, not logged: logging allocates
+                    std::strncpy(m_failure.data(), e.what(), m_failure.size() - 1);
+                    failed = true;
+                }
+            }
+            const auto end = Clock::now();
+            signal->metrics.service.record(end - begin);
+            signal->metrics.latency.record(end - event.received);
+            signal->metrics.handled.fetch_add(1, std::memory_order_relaxed);
+
+            if (failed) {
+                velocitas::logger().error("❌ Fast lane handler for {} failed: {}", signal->path,
+                                          m_failure.data());
+            }
+            if (signal->followUp) {
+                try {
+                    signal->followUp(event);
+                } catch (const std::exception& e) {
+                    velocitas::logger().error("❌ Fast lane follow-up for {} failed: {}",
+                                              signal->path, e.what());
+                }
+            }
+        }
+    }
+    return any;
+}
+
+void FastLane::loop() {
+    // Pins, prioritises and pre-faults the stack before the first event
+    applyToThisThread(LaunchOptions::current().critical, "critical");
+    AllocTripwire::nameThisThread("critical");
+
+    while (m_running.load(std::memory_order_acquire)) {
+        if (drainOnce()) {
+            continue;
+        }
+        m_sleeping.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        {
+            std::unique_lock<std::mutex> lock(m_wakeMutex);
+            m_wakeUp.wait(lock, [this] { return hasInput() || !m_running.load(); });
+        }
+        m_sleeping.store(false, std::memory_order_relaxed);
+    }
+}
+
+} // namespace runtime
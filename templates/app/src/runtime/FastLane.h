@@ -0,0 +1,158 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef VEHICLE_APP_RUNTIME_FASTLANE_H
+#define VEHICLE_APP_RUNTIME_FASTLANE_H
+
+#include "runtime/Histogram.h"
+#include "runtime/RingBuffer.h"
+#include "runtime/Shutdown.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace runtime {
+
+/**
+ * @brief One decoded sample of a critical signal.
+ */
+struct CriticalEvent {
+    int                                   signal{-1}; // id returned by FastLane::addSignal()
+    double                                value{0.0};
+    std::chrono::steady_clock::time_point received;
+};
+
+/**
+ * @brief Dedicated high-priority dispatch path for safety-critical signals.
+ *
+ * Critical signals are registered up front with addSignal(); each gets its own
+ * preallocated single-producer/single-consumer queue, fed by post() from that
+ * signal's subscription callback. The callback decodes the value itself, so
+ * nothing on the path from callback to handler allocates. One dedicated thread,
+ * tuned with the "critical" launch options (APP_CRITICAL_CPUS,
+ * APP_CRITICAL_PRIORITY), runs the handlers - it never shares a queue or a core
+ * with the batched pipeline.
+ *
+ * Handlers run inside an AllocTripwire::Scope. Anything that allocates, such as
+ * logging, belongs in the optional follow-up: the handler records what happened
+ * in state it owns, and the follow-up reports it after the scope has closed.
+ *
+ * Latency from post() to the end of the handler and the handler's service time
+ * are recorded per signal, separately from the pipeline's metrics.
+ *
+ * Environment:
+ *   APP_FAST_LANE=1           enable the fast lane
+ *   APP_FAST_LANE_QUEUE=64    queue capacity per critical signal
+ */
+class FastLane {
+public:
+    using Clock   = std::chrono::steady_clock;
+    using Handler = std::function<void(const CriticalEvent& event)>;
+
+    struct Options {
+        bool        enabled{false};
+        std::size_t queueCapacity{64};
+
+        static Options fromEnvironment();
+    };
+
+    struct SignalMetrics {
+        std::atomic<std::uint64_t> handled{0};
+        std::atomic<std::uint64_t> dropped{0}; // queue full
+        LatencyHistogram           latency;    // post() to end of handler
+        LatencyHistogram           service;    // time spent in the handler
+    };
+
+    explicit FastLane(Options options);
+    ~FastLane();
+
+    FastLane(const FastLane&)            = delete;
+    FastLane& operator=(const FastLane&) = delete;
+    FastLane(FastLane&&)                 = delete;
+    FastLane& operator=(FastLane&&)      = delete;
+
+    /**
+     * @brief Register a critical signal and allocate its queue. Call before start().
+     * @param followUp runs after the handler, outside its no-allocation scope
+     * @return signal id for post()
+     */
+    int addSignal(std::string path, Handler handler, Handler followUp = {});
+
+    /**
+     * @brief Start the fast lane thread. Returns false if disabled or without signals.
+     */
+    bool start();
+
+    /**
+     * @brief Queue a sample - call only from the signal's subscription callback.
+     *
+     * Never blocks or allocates; a full queue drops the sample and counts it.
+     */
+    void post(int signal, double value, Clock::time_point received = Clock::now());
+
+    /**
+     * @brief Handle queued samples, then stop the thread - use as a Shutdown drain hook.
+     */
+    DrainResult flush(Clock::time_point deadline);
+
+    /**
+     * @brief Log per-signal counts and latency percentiles.
+     */
+    void report() const;
+
+    [[nodiscard]] bool                 isEnabled() const { return m_options.enabled; }
+    [[nodiscard]] std::size_t          getSignalCount() const { return m_signals.size(); }
+    [[nodiscard]] const std::string&   getPath(int signal) const { return m_signals[signal]->path; }
+    [[nodiscard]] const SignalMetrics& getMetrics(int signal) const {
+        return m_signals[signal]->metrics;
+    }
+
+private:
+    struct Signal {
+        std::string                                path;
+        Handler                                    handler;
+        Handler                                    followUp;
+        std::unique_ptr<RingBuffer<CriticalEvent>> queue;
+        SignalMetrics                              metrics;
+    };
+
+    void loop();
+    bool drainOnce();
+    bool hasInput() const;
+
+    Options                              m_options;
+    std::vector<std::unique_ptr<Signal>> m_signals;
+    std::atomic<bool>                    m_running{false};
+    std::atomic<bool>                    m_sleeping{false};
+    std::mutex                           m_wakeMutex;
+    std::condition_variable              m_wakeUp;
+    std::thread                          m_thread;
+    std::array<char, 256>                m_failure{}; // handler error, logged after the scope
+};
+
+} // namespace runtime
+
+#endif // VEHICLE_APP_RUNTIME_FASTLANE_H
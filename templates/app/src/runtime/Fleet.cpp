@@ -0,0 +1,225 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "runtime/Fleet.h"
+
+#include "runtime/TimerWheel.h"
+#include "sdk/Logger.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+#include <fstream>
+#include <thread>
+#include <unistd.h>
+
+namespace runtime {
+
+namespace {
+
+constexpr std::chrono::milliseconds MAX_TICK{10};
+
+long readPositive(const char* name, long fallback) {
+    if (const char* text = std::getenv(name)) {
+        const long value = std::atol(text);
+        if (value > 0) {
+            return value;
+        }
+    }
+    return fallback;
+}
+
+// Whole ticks covering period, rounded up
+std::uint64_t ticksFor(std::chrono::milliseconds period, std::chrono::milliseconds tick) {
+    return static_cast<std::uint64_t>((period.count() + tick.count() - 1) / tick.count());
+}
+
+// Resident set size from /proc/self/statm, 0 where unavailable
+std::size_t residentBytes() {
+    std::ifstream statm("/proc/self/statm");
+    std::size_t   pages    = 0;
+    std::size_t   resident = 0;
+    if (!(statm >> pages >> resident)) {
+        return 0;
+    }
+    return resident * static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+}
+
+} // namespace
+
+FleetPublisher::FleetPublisher(std::size_t vehicles)
+    : m_slots(std::make_unique<Slot[]>(vehicles))
+    , m_count(vehicles) {
+    m_batch.reserve(vehicles);
+}
+
+void FleetPublisher::publish(std::uint32_t vehicle, double value, bool alert) {
+    Slot& slot = m_slots[vehicle];
+    slot.value.store(value, std::memory_order_relaxed);
+    slot.alert.store(alert, std::memory_order_relaxed);
+    slot.dirty.store(true, std::memory_order_release);
+}
+
+std::size_t FleetPublisher::flush(const Sink& sink) {
+    m_batch.clear();
+    for (std::size_t i = 0; i < m_count; ++i) {
+        Slot& slot = m_slots[i];
+        if (!slot.dirty.exchange(false, std::memory_order_acquire)) {
+            continue;
+        }
+        m_batch.push_back({static_cast<std::uint32_t>(i), slot.value.load(std::memory_order_relaxed),
+                           slot.alert.load(std::memory_order_relaxed)});
+    }
+    if (!m_batch.empty()) {
+        sink(m_batch);
+        m_published.fetch_add(m_batch.size(), std::memory_order_relaxed);
+    }
+    return m_batch.size();
+}
+
+double FleetSimulation::Drive::next(double seconds) {
+    // xorshift32 - cheap, and each vehicle's cycle is reproducible from its id
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    if (state % 200 == 0) {
+        const std::uint32_t pick = state >> 8;
+        target                   = pick % 4 == 0 ? 0.0 : static_cast<double>(pick % 3600) / 100.0;
+    }
+    const double step = 3.0 * seconds; // at most 3 m/s² either way
+    speed += std::clamp(target - speed, -step, step);
+    return speed;
+}
+
+FleetSimulation::Options FleetSimulation::Options::fromEnvironment() {
+    Options options;
+    options.vehicles        = static_cast<std::size_t>(readPositive("APP_FLEET_SIZE", 0));
+    options.samplePeriod    = std::chrono::milliseconds(readPositive("APP_FLEET_SAMPLE_MS", 100));
+    options.publishInterval = std::chrono::milliseconds(readPositive("APP_FLEET_PUBLISH_MS", 1000));
+    options.duration        = std::chrono::seconds(readPositive("APP_FLEET_DURATION_S", 0));
+    return options;
+}
+
+FleetSimulation::FleetSimulation(Options options, WorkerPool& workers)
+    : m_options(options)
+    , m_workers(workers) {}
+
+void FleetSimulation::run(const Factory& factory, const FleetPublisher::Sink& sink) {
+    if (!isEnabled()) {
+        return;
+    }
+    const std::size_t count = m_options.vehicles;
+
+    m_footprint.residentBefore = residentBytes();
+    m_publisher                = std::make_unique<FleetPublisher>(count);
+    m_instances.reserve(count);
+    m_drives.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto vehicle = static_cast<std::uint32_t>(i);
+        m_instances.push_back(factory(vehicle));
+        m_drives.push_back(Drive{vehicle * 2654435761U + 1U});
+        m_drives.back().target = static_cast<double>(m_drives.back().state % 3000) / 100.0;
+    }
+    m_footprint.residentAfter = residentBytes();
+    if (m_footprint.residentAfter > m_footprint.residentBefore) {
+        m_footprint.perVehicle =
+            (m_footprint.residentAfter - m_footprint.residentBefore) / count;
+    }
+    velocitas::logger().info("🚙 Fleet: {} vehicles, {:.1f} MiB resident, ~{} bytes per vehicle",
+                             count, m_footprint.residentAfter / (1024.0 * 1024.0),
+                             m_footprint.perVehicle);
+
+    // One wheel tick is at most 10 ms; every vehicle fires once per sample period,
+    // rounded up to whole ticks - the drive integrates over the period it really gets
+    const auto tick = std::min<std::chrono::milliseconds>(m_options.samplePeriod, MAX_TICK);
+    const std::uint64_t periodTicks  = ticksFor(m_options.samplePeriod, tick);
+    const std::uint64_t publishTicks = std::max<std::uint64_t>(1, m_options.publishInterval / tick);
+    const auto          period       = tick * static_cast<std::int64_t>(periodTicks);
+    const double        seconds      = std::chrono::duration<double>(period).count();
+    if (period != m_options.samplePeriod) {
+        velocitas::logger().warn("🚙 Fleet: sample period {} ms is not a multiple of the {} ms "
+                                 "tick - sampling every {} ms",
+                                 m_options.samplePeriod.count(), tick.count(), period.count());
+    }
+
+    TimerWheel wheel(static_cast<std::size_t>(periodTicks));
+    for (std::size_t i = 0; i < count; ++i) {
+        wheel.scheduleIn(static_cast<std::uint32_t>(i), 1 + i % periodTicks);
+    }
+
+    const auto start = Clock::now();
+    for (std::uint64_t current = 1; !m_stopping.load(std::memory_order_acquire); ++current) {
+        const auto due = start + tick * current;
+        const auto now = Clock::now();
+        if (now < due) {
+            std::this_thread::sleep_until(due);
+        } else if (now - due > tick) {
+            ++m_lateTicks; // the timer thread cannot keep up with the fleet
+        }
+
+        wheel.advance(current, [&](std::uint32_t vehicle) {
+            const float speed = static_cast<float>(m_drives[vehicle].next(seconds));
+            // Vehicle and speed packed with this into 16 bytes fit std::function's
+            // inline storage - no allocation per sample
+            const std::uint64_t sample =
+                (std::uint64_t{vehicle} << 32) | std::bit_cast<std::uint32_t>(speed);
+            m_workers.submit(vehicle, [this, sample] {
+                const auto id = static_cast<std::uint32_t>(sample >> 32);
+                m_instances[id]->onSample(
+                    id, std::bit_cast<float>(static_cast<std::uint32_t>(sample)), *m_publisher);
+            });
+            m_samples.fetch_add(1, std::memory_order_relaxed);
+            wheel.scheduleIn(vehicle, periodTicks);
+        });
+
+        if (current % publishTicks == 0) {
+            m_publisher->flush(sink);
+            ++m_flushes;
+        }
+        if (m_options.duration.count() > 0 && Clock::now() - start >= m_options.duration) {
+            break;
+        }
+    }
+    m_elapsed = Clock::now() - start;
+
+    // Finish queued samples, then publish what they produced
+    const auto drained = m_workers.flush(Clock::now() + m_options.publishInterval);
+    if (drained.dropped > 0) {
+        velocitas::logger().warn("🚙 Fleet: {} samples not processed before stop", drained.dropped);
+    }
+    m_publisher->flush(sink);
+    ++m_flushes;
+}
+
+void FleetSimulation::stop() {
+    m_stopping.store(true, std::memory_order_release);
+}
+
+void FleetSimulation::report() const {
+    if (!isEnabled() || m_publisher == nullptr) {
+        return;
+    }
+    const double seconds = std::chrono::duration<double>(m_elapsed).count();
+    const auto   samples = getSampleCount();
+    velocitas::logger().info("🚙 Fleet: {} samples in {:.1f}s ({:.0f}/s), {} updates in {} flushes, "
+                             "{} late ticks",
+                             samples, seconds, seconds > 0 ? samples / seconds : 0.0,
+                             m_publisher->getPublishedCount(), m_flushes, m_lateTicks);
+    velocitas::logger().info("🚙 Fleet: {} bytes resident per vehicle ({} vehicles)",
+                             m_footprint.perVehicle, m_options.vehicles);
+}
+
+} // namespace runtime
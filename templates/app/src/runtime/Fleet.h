@@ -0,0 +1,203 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef VEHICLE_APP_RUNTIME_FLEET_H
+#define VEHICLE_APP_RUNTIME_FLEET_H
+
+#include "runtime/RingBuffer.h"
+#include "runtime/WorkerPool.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace runtime {
+
+/**
+ * @brief Latest output of one simulated vehicle, handed to the fleet sink.
+ */
+struct FleetUpdate {
+    std::uint32_t vehicle;
+    double        value;
+    bool          alert;
+};
+
+/**
+ * @brief Publisher shared by every vehicle of a fleet simulation.
+ *
+ * publish() stores a vehicle's latest output in its own slot (lock-free, one
+ * cache line per vehicle); flush() collects the slots that changed since the
+ * last flush and hands them to the sink as one batch. Repeated outputs of a
+ * vehicle between flushes coalesce, like DerivedSignalPublisher does for slots.
+ */
+class FleetPublisher {
+public:
+    using Sink = std::function<void(const std::vector<FleetUpdate>&)>;
+
+    explicit FleetPublisher(std::size_t vehicles);
+
+    FleetPublisher(const FleetPublisher&)            = delete;
+    FleetPublisher& operator=(const FleetPublisher&) = delete;
+    FleetPublisher(FleetPublisher&&)                 = delete;
+    FleetPublisher& operator=(FleetPublisher&&)      = delete;
+
+    /**
+     * @brief Record a vehicle's latest output - called from worker threads.
+     */
+    void publish(std::uint32_t vehicle, double value, bool alert);
+
+    /**
+     * @brief Send changed outputs to sink. Returns the number of updates sent.
+     */
+    std::size_t flush(const Sink& sink);
+
+    [[nodiscard]] std::uint64_t getPublishedCount() const {
+        return m_published.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct alignas(CACHE_LINE_SIZE) Slot {
+        std::atomic<double> value{0.0};
+        std::atomic<bool>   alert{false};
+        std::atomic<bool>   dirty{false};
+    };
+
+    std::unique_ptr<Slot[]>    m_slots;
+    std::size_t                m_count;
+    std::vector<FleetUpdate>   m_batch;
+    std::atomic<std::uint64_t> m_published{0};
+};
+
+/**
+ * @brief Per-vehicle application state hosted by a FleetSimulation.
+ *
+ * onSample() runs on the shared worker pool; samples of one vehicle never run
+ * concurrently and arrive in order, so implementations need no locking.
+ */
+class FleetInstance {
+public:
+    FleetInstance()          = default;
+    virtual ~FleetInstance() = default;
+
+    FleetInstance(const FleetInstance&)            = delete;
+    FleetInstance& operator=(const FleetInstance&) = delete;
+    FleetInstance(FleetInstance&&)                 = delete;
+    FleetInstance& operator=(FleetInstance&&)      = delete;
+
+    virtual void onSample(std::uint32_t vehicle, double speed, FleetPublisher& publisher) = 0;
+};
+
+/**
+ * @brief Hosts many lightweight vehicle app instances in one process.
+ *
+ * Every vehicle gets a FleetInstance from the factory and its own simulated
+ * speed stream (a seeded random drive cycle). All vehicles share:
+ * - one TimerWheel, advanced by the thread that calls run(), which generates
+ *   each vehicle's samples at its sample period (phases are spread evenly)
+ * - one WorkerPool that processes the samples, keyed by vehicle
+ * - one FleetPublisher, flushed to the sink every publish interval
+ *
+ * There is no databroker connection per vehicle. After construction the
+ * resident memory added per vehicle is logged, so capacity can be planned from
+ * a run with a representative fleet size.
+ *
+ * Environment:
+ *   APP_FLEET_SIZE=1000          number of simulated vehicles (0 = normal app)
+ *   APP_FLEET_SAMPLE_MS=100      sample period per vehicle (rounded up to 10 ms ticks above 10)
+ *   APP_FLEET_PUBLISH_MS=1000    publisher flush interval
+ *   APP_FLEET_DURATION_S=60      stop after this long (0 = until Ctrl+C)
+ */
+class FleetSimulation {
+public:
+    using Clock   = std::chrono::steady_clock;
+    using Factory = std::function<std::unique_ptr<FleetInstance>(std::uint32_t vehicle)>;
+
+    struct Options {
+        std::size_t               vehicles{0};
+        std::chrono::milliseconds samplePeriod{100};
+        std::chrono::milliseconds publishInterval{1000};
+        std::chrono::seconds      duration{0};
+
+        static Options fromEnvironment();
+    };
+
+    struct Footprint {
+        std::size_t residentBefore{0}; // bytes, before the instances were created
+        std::size_t residentAfter{0};
+        std::size_t perVehicle{0};
+    };
+
+    FleetSimulation(Options options, WorkerPool& workers);
+
+    FleetSimulation(const FleetSimulation&)            = delete;
+    FleetSimulation& operator=(const FleetSimulation&) = delete;
+    FleetSimulation(FleetSimulation&&)                 = delete;
+    FleetSimulation& operator=(FleetSimulation&&)      = delete;
+
+    /**
+     * @brief Create the fleet, then simulate until stop() or Options::duration.
+     *
+     * Blocks the calling thread, which drives the timer wheel and the publisher.
+     */
+    void run(const Factory& factory, const FleetPublisher::Sink& sink);
+
+    /**
+     * @brief Make run() return - safe to call from any thread.
+     */
+    void stop();
+
+    /**
+     * @brief Log sample counts, publisher throughput and the memory footprint.
+     */
+    void report() const;
+
+    [[nodiscard]] bool          isEnabled() const { return m_options.vehicles > 0; }
+    [[nodiscard]] Footprint     getFootprint() const { return m_footprint; }
+    [[nodiscard]] std::uint64_t getSampleCount() const {
+        return m_samples.load(std::memory_order_relaxed);
+    }
+
+private:
+    // Seeded random drive cycle: accelerates towards a target speed that
+    // changes now and then, including stops
+    struct Drive {
+        std::uint32_t state;
+        double        speed{0.0};
+        double        target{0.0};
+
+        double next(double seconds);
+    };
+
+    Options                                     m_options;
+    WorkerPool&                                 m_workers;
+    std::unique_ptr<FleetPublisher>             m_publisher;
+    std::vector<std::unique_ptr<FleetInstance>> m_instances;
+    std::vector<Drive>                          m_drives;
+    Footprint                                   m_footprint;
+    std::atomic<bool>                           m_stopping{false};
+    std::atomic<std::uint64_t>                  m_samples{0};
+    std::uint64_t                               m_flushes{0};
+    std::uint64_t                               m_lateTicks{0};
+    Clock::duration                             m_elapsed{};
+};
+
+} // namespace runtime
+
+#endif // VEHICLE_APP_RUNTIME_FLEET_H
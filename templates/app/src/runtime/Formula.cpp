@@ -0,0 +1,694 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "runtime/Formula.h"
+
+#include "sdk/Logger.h"
+
+#include <algorithm>
+#include <bit>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <set>
+#include <utility>
+
+namespace runtime {
+
+namespace {
+
+bool isNameChar(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) != 0 || c == '_' || c == '.';
+}
+
+std::string_view trim(std::string_view text) {
+    const auto begin = text.find_first_not_of(" \t\r\n");
+    if (begin == std::string_view::npos) {
+        return {};
+    }
+    return text.substr(begin, text.find_last_not_of(" \t\r\n") - begin + 1);
+}
+
+} // namespace
+
+/**
+ * @brief Recursive-descent parser that emits code while it parses - there is no syntax tree.
+ */
+class FormulaSet::Compiler {
+public:
+    Compiler(FormulaSet& set, std::string_view text, int outputSlot)
+        : m_set(set)
+        , m_text(text)
+        , m_outputSlot(outputSlot) {}
+
+    std::uint32_t compile() {
+        const auto result = parseOr();
+        skipSpace();
+        if (m_pos < m_text.size()) {
+            fail(std::string("unexpected '") + m_text[m_pos] + "'");
+        }
+        return result;
+    }
+
+    [[nodiscard]] std::vector<std::uint32_t> getInputs() const {
+        return {m_inputs.begin(), m_inputs.end()};
+    }
+
+private:
+    using Op = FormulaSet::Op;
+
+    [[noreturn]] void fail(const std::string& message) const { throw FormulaError(message, m_pos); }
+
+    void skipSpace() {
+        while (m_pos < m_text.size() && std::isspace(static_cast<unsigned char>(m_text[m_pos]))) {
+            ++m_pos;
+        }
+    }
+
+    bool consume(std::string_view token) {
+        skipSpace();
+        if (m_text.substr(m_pos, token.size()) != token) {
+            return false;
+        }
+        m_pos += token.size();
+        return true;
+    }
+
+    void expect(char c) {
+        if (!consume(std::string_view(&c, 1))) {
+            fail(std::string("expected '") + c + "'");
+        }
+    }
+
+    std::uint32_t parseOr() {
+        auto value = parseAnd();
+        while (consume("||")) {
+            value = m_set.emit(Op::Or, value, parseAnd());
+        }
+        return value;
+    }
+
+    std::uint32_t parseAnd() {
+        auto value = parseComparison();
+        while (consume("&&")) {
+            value = m_set.emit(Op::And, value, parseComparison());
+        }
+        return value;
+    }
+
+    std::uint32_t parseComparison() {
+        static constexpr std::pair<std::string_view, Op> OPERATORS[] = {
+            {"<=", Op::LessEqual}, {">=", Op::GreaterEqual}, {"==", Op::Equal},
+            {"!=", Op::NotEqual},  {"<", Op::Less},          {">", Op::Greater}};
+        const auto left = parseAdditive();
+        for (const auto& [token, op] : OPERATORS) {
+            if (consume(token)) {
+                return m_set.emit(op, left, parseAdditive());
+            }
+        }
+        return left;
+    }
+
+    std::uint32_t parseAdditive() {
+        auto value = parseTerm();
+        while (true) {
+            if (consume("+")) {
+                value = m_set.emit(Op::Add, value, parseTerm());
+            } else if (consume("-")) {
+                value = m_set.emit(Op::Subtract, value, parseTerm());
+            } else {
+                return value;
+            }
+        }
+    }
+
+    std::uint32_t parseTerm() {
+        auto value = parseUnary();
+        while (true) {
+            if (consume("*")) {
+                value = m_set.emit(Op::Multiply, value, parseUnary());
+            } else if (consume("/")) {
+                value = m_set.emit(Op::Divide, value, parseUnary());
+            } else {
+                return value;
+            }
+        }
+    }
+
+    std::uint32_t parseUnary() {
+        if (consume("-")) {
+            return m_set.emit(Op::Negate, parseUnary());
+        }
+        if (consume("!")) {
+            return m_set.emit(Op::Not, parseUnary());
+        }
+        return parsePower();
+    }
+
+    // Right-associative and binds tighter than unary minus: -2^2 == -4
+    std::uint32_t parsePower() {
+        const auto base = parsePrimary();
+        if (consume("^")) {
+            return m_set.emit(Op::Power, base, parseUnary());
+        }
+        return base;
+    }
+
+    std::uint32_t parsePrimary() {
+        skipSpace();
+        if (m_pos >= m_text.size()) {
+            fail("unexpected end of formula");
+        }
+        const char c = m_text[m_pos];
+        if (c == '(') {
+            ++m_pos;
+            const auto value = parseOr();
+            expect(')');
+            return value;
+        }
+        if (std::isdigit(static_cast<unsigned char>(c)) != 0 || c == '.') {
+            return parseNumber();
+        }
+        if (!isNameChar(c)) {
+            fail(std::string("unexpected '") + c + "'");
+        }
+        const auto start = m_pos;
+        while (m_pos < m_text.size() && isNameChar(m_text[m_pos])) {
+            ++m_pos;
+        }
+        const auto name = m_text.substr(start, m_pos - start);
+        if (consume("(")) {
+            return parseCall(name, start);
+        }
+        return parseSignal(name, start);
+    }
+
+    std::uint32_t parseNumber() {
+        double      value = 0.0;
+        const auto* begin = m_text.data() + m_pos;
+        const auto [end, error] =
+            std::from_chars(begin, m_text.data() + m_text.size(), value);
+        if (error != std::errc()) {
+            fail("invalid number");
+        }
+        m_pos += static_cast<std::size_t>(end - begin);
+        return m_set.constant(value);
+    }
+
+    std::uint32_t parseCall(std::string_view name, std::size_t start) {
+        std::vector<std::uint32_t> args;
+        if (!consume(")")) {
+            do {
+                args.push_back(parseOr());
+            } while (consume(","));
+            expect(')');
+        }
+        const auto arity = [&](std::size_t count) {
+            if (args.size() != count) {
+                m_pos = start;
+                fail(std::string(name) + "() takes " + std::to_string(count) + " argument(s)");
+            }
+        };
+        if (name == "abs" || name == "sqrt") {
+            arity(1);
+            return m_set.emit(name == "abs" ? Op::Abs : Op::Sqrt, args[0]);
+        }
+        if (name == "min" || name == "max") {
+            arity(2);
+            return m_set.emit(name == "min" ? Op::Min : Op::Max, args[0], args[1]);
+        }
+        if (name == "clamp") {
+            arity(3);
+            return m_set.emit(Op::Min, m_set.emit(Op::Max, args[0], args[1]), args[2]);
+        }
+        if (name == "if") {
+            arity(3);
+            return m_set.emit(Op::Select, args[0], args[1], args[2]);
+        }
+        m_pos = start;
+        fail("unknown function " + std::string(name) + "()");
+    }
+
+    std::uint32_t parseSignal(std::string_view path, std::size_t start) {
+        const int existing = m_set.m_table.find(path);
+        if (existing >= 0 && existing == m_outputSlot) {
+            m_pos = start;
+            fail("formula reads its own output");
+        }
+        // An earlier formula's output: use its register, not last pass's table value
+        if (const auto formula = m_set.m_outputIndex.find(existing);
+            existing >= 0 && formula != m_set.m_outputIndex.end()) {
+            const auto& output = m_set.m_outputs[formula->second];
+            m_inputs.insert(output.inputs.begin(), output.inputs.end());
+            return output.reg;
+        }
+        const int slot = existing >= 0 ? existing : m_set.m_table.registerSignal(path);
+        if (slot < 0) {
+            m_pos = start;
+            fail("signal table full or path too long");
+        }
+        const auto reg = m_set.input(slot);
+        for (std::uint32_t i = 0; i < m_set.m_inputs.size(); ++i) {
+            if (m_set.m_inputs[i].reg == reg) {
+                m_inputs.insert(i);
+            }
+        }
+        return reg;
+    }
+
+    FormulaSet&             m_set;
+    std::string_view        m_text;
+    int                     m_outputSlot;
+    std::size_t             m_pos{0};
+    std::set<std::uint32_t> m_inputs;
+};
+
+FormulaSet::Options FormulaSet::Options::fromEnvironment() {
+    Options options;
+    if (const char* file = std::getenv("APP_FORMULAS_FILE")) {
+        options.file = file;
+    }
+    if (const char* formulas = std::getenv("APP_FORMULAS")) {
+        options.formulas = formulas;
+    }
+    return options;
+}
+
+FormulaSet::FormulaSet(SignalTable& table)
+    : m_table(table) {}
+
+int FormulaSet::add(std::string_view output, std::string_view expression) {
+    output = trim(output);
+    if (output.empty() || !std::all_of(output.begin(), output.end(), isNameChar)) {
+        throw FormulaError("invalid output path '" + std::string(output) + "'", 0);
+    }
+    // Slots for the output and new inputs are registered as the formula compiles
+    const auto slotCount = m_table.getCount();
+    const int  slot      = m_table.registerSignal(output);
+    if (slot < 0) {
+        throw FormulaError("signal table full or output path too long", 0);
+    }
+    if (m_outputIndex.count(slot) > 0) {
+        throw FormulaError(std::string(output) + " is already defined", 0);
+    }
+    if (m_inputRegs.count(slot) > 0) {
+        throw FormulaError(std::string(output) + " is read by an earlier formula - define it first",
+                           0);
+    }
+
+    // Compile straight into the shared program; roll back if the formula is invalid
+    const auto codeSize      = m_code.size();
+    const auto registerCount = static_cast<std::uint32_t>(m_registers.size());
+    const auto inputCount    = m_inputs.size();
+    const auto folded        = m_folded;
+    const auto reused        = m_reused;
+    try {
+        Compiler   compiler(*this, expression, slot);
+        const auto reg = compiler.compile();
+        m_outputIndex.emplace(slot, m_outputs.size());
+        m_outputs.push_back(Output{slot, reg, compiler.getInputs(), std::string(trim(expression))});
+    } catch (...) {
+        const auto added = [registerCount](const auto& entry) {
+            return entry.second >= registerCount;
+        };
+        m_code.resize(codeSize);
+        m_registers.resize(registerCount);
+        m_isConstant.resize(registerCount);
+        m_inputs.resize(inputCount);
+        m_inputValid.resize(inputCount);
+        std::erase_if(m_constants, added);
+        std::erase_if(m_inputRegs, added);
+        std::erase_if(m_shared, added);
+        m_folded = folded;
+        m_reused = reused;
+        m_table.truncate(slotCount);
+        throw;
+    }
+
+    // Batch registers: constants are broadcast once, everything else is written per block
+    m_lanes.assign(m_registers.size() * BATCH_LANES, 0.0);
+    for (std::size_t reg = 0; reg < m_registers.size(); ++reg) {
+        if (m_isConstant[reg] != 0) {
+            std::fill_n(m_lanes.begin() + static_cast<std::ptrdiff_t>(reg * BATCH_LANES),
+                        BATCH_LANES, m_registers[reg]);
+        }
+    }
+    return slot;
+}
+
+std::size_t FormulaSet::load(const Options& options) {
+    std::size_t added   = 0;
+    const auto  compile = [&](std::string_view definition, const std::string& origin) {
+        definition = trim(definition);
+        if (definition.empty()) {
+            return;
+        }
+        const auto equals = definition.find('=');
+        if (equals == std::string_view::npos) {
+            velocitas::logger().error("❌ Formula ({}): expected 'Output.Path = expression'",
+                                      origin);
+            return;
+        }
+        const auto output     = trim(definition.substr(0, equals));
+        const auto expression = definition.substr(equals + 1);
+        try {
+            add(output, expression);
+            ++added;
+        } catch (const FormulaError& e) {
+            velocitas::logger().error("❌ Formula {} ({}): {} at column {}", output, origin,
+                                      e.what(), e.getPosition() + 1);
+        }
+    };
+
+    if (!options.file.empty()) {
+        std::ifstream file(options.file);
+        if (!file) {
+            velocitas::logger().error("❌ Formulas file {} not readable", options.file);
+        }
+        // Indented lines continue the previous formula
+        std::string line;
+        std::string definition;
+        std::size_t lineNumber = 0;
+        std::size_t firstLine  = 0;
+        while (std::getline(file, line)) {
+            ++lineNumber;
+            line = std::string(line.substr(0, line.find('#')));
+            if (!line.empty() && (line.front() == ' ' || line.front() == '\t')) {
+                definition += line;
+                continue;
+            }
+            compile(definition, options.file + ":" + std::to_string(firstLine));
+            definition = line;
+            firstLine  = lineNumber;
+        }
+        compile(definition, options.file + ":" + std::to_string(firstLine));
+    }
+
+    std::string_view formulas = options.formulas;
+    while (!formulas.empty()) {
+        const auto end = formulas.find(';');
+        compile(formulas.substr(0, end), "APP_FORMULAS");
+        formulas = end == std::string_view::npos ? std::string_view{} : formulas.substr(end + 1);
+    }
+
+    if (added > 0) {
+        velocitas::logger().info(
+            "🧮 Formulas: {} compiled to {} instructions over {} inputs ({} folded, {} shared)",
+            m_outputs.size(), m_code.size(), m_inputs.size(), m_folded, m_reused);
+    }
+    return added;
+}
+
+double FormulaSet::apply(Op op, double a, double b, double c) {
+    switch (op) {
+    case Op::Add:
+        return a + b;
+    case Op::Subtract:
+        return a - b;
+    case Op::Multiply:
+        return a * b;
+    case Op::Divide:
+        return a / b;
+    case Op::Power:
+        return std::pow(a, b);
+    case Op::Negate:
+        return -a;
+    case Op::Not:
+        return a == 0.0 ? 1.0 : 0.0;
+    case Op::Abs:
+        return std::fabs(a);
+    case Op::Sqrt:
+        return std::sqrt(a);
+    case Op::Min:
+        return b < a ? b : a;
+    case Op::Max:
+        return a < b ? b : a;
+    case Op::Less:
+        return a < b ? 1.0 : 0.0;
+    case Op::LessEqual:
+        return a <= b ? 1.0 : 0.0;
+    case Op::Greater:
+        return a > b ? 1.0 : 0.0;
+    case Op::GreaterEqual:
+        return a >= b ? 1.0 : 0.0;
+    case Op::Equal:
+        return a == b ? 1.0 : 0.0;
+    case Op::NotEqual:
+        return a != b ? 1.0 : 0.0;
+    case Op::And:
+        return a != 0.0 && b != 0.0 ? 1.0 : 0.0;
+    case Op::Or:
+        return a != 0.0 || b != 0.0 ? 1.0 : 0.0;
+    case Op::Select:
+        return a != 0.0 ? b : c;
+    }
+    return 0.0;
+}
+
+std::uint32_t FormulaSet::constant(double value) {
+    const auto bits = std::bit_cast<std::uint64_t>(value);
+    if (const auto it = m_constants.find(bits); it != m_constants.end()) {
+        return it->second;
+    }
+    const auto reg = static_cast<std::uint32_t>(m_registers.size());
+    m_registers.push_back(value);
+    m_isConstant.push_back(1);
+    m_constants.emplace(bits, reg);
+    return reg;
+}
+
+std::uint32_t FormulaSet::input(int slot) {
+    if (const auto it = m_inputRegs.find(slot); it != m_inputRegs.end()) {
+        return it->second;
+    }
+    const auto reg = static_cast<std::uint32_t>(m_registers.size());
+    m_registers.push_back(0.0);
+    m_isConstant.push_back(0);
+    m_inputs.push_back(Input{slot, reg});
+    m_inputValid.push_back(0);
+    m_inputRegs.emplace(slot, reg);
+    return reg;
+}
+
+std::uint32_t FormulaSet::emit(Op op, std::uint32_t a, std::uint32_t b, std::uint32_t c) {
+    const bool unary   = op == Op::Negate || op == Op::Not || op == Op::Abs || op == Op::Sqrt;
+    const bool ternary = op == Op::Select;
+    if (unary) {
+        b = 0;
+    }
+    if (!ternary) {
+        c = 0;
+    }
+    const auto isConstant = [this](std::uint32_t reg) { return m_isConstant[reg] != 0; };
+    const auto isValue    = [&](std::uint32_t reg, double value) {
+        return isConstant(reg) && m_registers[reg] == value;
+    };
+
+    // Constant folding and identities
+    if (isConstant(a) && (unary || isConstant(b)) && (!ternary || isConstant(c))) {
+        ++m_folded;
+        return constant(apply(op, m_registers[a], m_registers[b], m_registers[c]));
+    }
+    if (ternary && isConstant(a)) {
+        ++m_folded;
+        return m_registers[a] != 0.0 ? b : c;
+    }
+    if (((op == Op::Add || op == Op::Subtract) && isValue(b, 0.0)) ||
+        ((op == Op::Multiply || op == Op::Divide) && isValue(b, 1.0))) {
+        ++m_folded;
+        return a;
+    }
+    if ((op == Op::Add && isValue(a, 0.0)) || (op == Op::Multiply && isValue(a, 1.0))) {
+        ++m_folded;
+        return b;
+    }
+    if (op == Op::Power && (isValue(b, 2.0) || isValue(b, 0.5))) {
+        // x^2 and x^0.5 are common in formulas and much cheaper than pow()
+        ++m_folded;
+        return isValue(b, 2.0) ? emit(Op::Multiply, a, a) : emit(Op::Sqrt, a);
+    }
+
+    // Common subexpressions, operands of commutative operators in canonical order
+    const bool commutative = op == Op::Add || op == Op::Multiply || op == Op::Min ||
+                             op == Op::Max || op == Op::Equal || op == Op::NotEqual ||
+                             op == Op::And || op == Op::Or;
+    if (commutative && b < a) {
+        std::swap(a, b);
+    }
+    const auto key = std::make_tuple(op, a, b, c);
+    if (const auto it = m_shared.find(key); it != m_shared.end()) {
+        ++m_reused;
+        return it->second;
+    }
+    const auto reg = static_cast<std::uint32_t>(m_registers.size());
+    m_registers.push_back(0.0);
+    m_isConstant.push_back(0);
+    m_code.push_back(Instruction{op, reg, a, b, c});
+    m_shared.emplace(key, reg);
+    return reg;
+}
+
+void FormulaSet::evaluate() {
+    double*      registers = m_registers.data();
+    SignalSample sample;
+    for (std::size_t i = 0; i < m_inputs.size(); ++i) {
+        const bool valid           = m_table.read(m_inputs[i].slot, sample);
+        m_inputValid[i]            = valid ? 1 : 0;
+        registers[m_inputs[i].reg] = valid ? sample.value : 0.0;
+    }
+
+    for (const auto& instruction : m_code) {
+        registers[instruction.dst] = apply(instruction.op, registers[instruction.a],
+                                           registers[instruction.b], registers[instruction.c]);
+    }
+
+    for (auto& output : m_outputs) {
+        const double value = registers[output.reg];
+        const bool   ready = std::all_of(output.inputs.begin(), output.inputs.end(),
+                                         [this](std::uint32_t i) { return m_inputValid[i] != 0; });
+        if (!ready || !std::isfinite(value)) {
+            ++output.skipped;
+            continue;
+        }
+        m_table.update(output.slot, value);
+    }
+    m_evaluations.fetch_add(1, std::memory_order_relaxed);
+}
+
+template <FormulaSet::Op OP>
+void FormulaSet::runLanes(std::size_t lanes, double* dst, const double* a, const double* b,
+                          const double* c) {
+    // apply() folds to a single operation per OP; with a constant trip count the
+    // compiler vectorises the full blocks
+    if (lanes == BATCH_LANES) {
+        for (std::size_t lane = 0; lane < BATCH_LANES; ++lane) {
+            dst[lane] = apply(OP, a[lane], b[lane], c[lane]);
+        }
+        return;
+    }
+    for (std::size_t lane = 0; lane < lanes; ++lane) {
+        dst[lane] = apply(OP, a[lane], b[lane], c[lane]);
+    }
+}
+
+void FormulaSet::runBlock(std::size_t lanes) {
+    double* const registers = m_lanes.data();
+    for (const auto& instruction : m_code) {
+        double* const       dst = registers + instruction.dst * BATCH_LANES;
+        const double* const a   = registers + instruction.a * BATCH_LANES;
+        const double* const b   = registers + instruction.b * BATCH_LANES;
+        const double* const c   = registers + instruction.c * BATCH_LANES;
+        switch (instruction.op) {
+        case Op::Add:
+            runLanes<Op::Add>(lanes, dst, a, b, c);
+            break;
+        case Op::Subtract:
+            runLanes<Op::Subtract>(lanes, dst, a, b, c);
+            break;
+        case Op::Multiply:
+            runLanes<Op::Multiply>(lanes, dst, a, b, c);
+            break;
+        case Op::Divide:
+            runLanes<Op::Divide>(lanes, dst, a, b, c);
+            break;
+        case Op::Power:
+            runLanes<Op::Power>(lanes, dst, a, b, c);
+            break;
+        case Op::Negate:
+            runLanes<Op::Negate>(lanes, dst, a, b, c);
+            break;
+        case Op::Not:
+            runLanes<Op::Not>(lanes, dst, a, b, c);
+            break;
+        case Op::Abs:
+            runLanes<Op::Abs>(lanes, dst, a, b, c);
+            break;
+        case Op::Sqrt:
+            runLanes<Op::Sqrt>(lanes, dst, a, b, c);
+            break;
+        case Op::Min:
+            runLanes<Op::Min>(lanes, dst, a, b, c);
+            break;
+        case Op::Max:
+            runLanes<Op::Max>(lanes, dst, a, b, c);
+            break;
+        case Op::Less:
+            runLanes<Op::Less>(lanes, dst, a, b, c);
+            break;
+        case Op::LessEqual:
+            runLanes<Op::LessEqual>(lanes, dst, a, b, c);
+            break;
+        case Op::Greater:
+            runLanes<Op::Greater>(lanes, dst, a, b, c);
+            break;
+        case Op::GreaterEqual:
+            runLanes<Op::GreaterEqual>(lanes, dst, a, b, c);
+            break;
+        case Op::Equal:
+            runLanes<Op::Equal>(lanes, dst, a, b, c);
+            break;
+        case Op::NotEqual:
+            runLanes<Op::NotEqual>(lanes, dst, a, b, c);
+            break;
+        case Op::And:
+            runLanes<Op::And>(lanes, dst, a, b, c);
+            break;
+        case Op::Or:
+            runLanes<Op::Or>(lanes, dst, a, b, c);
+            break;
+        case Op::Select:
+            runLanes<Op::Select>(lanes, dst, a, b, c);
+            break;
+        }
+    }
+}
+
+void FormulaSet::evaluateBatch(const double* const* columns, std::size_t rows,
+                               double* const* results) {
+    double* const registers = m_lanes.data();
+    for (std::size_t row = 0; row < rows; row += BATCH_LANES) {
+        const std::size_t lanes = std::min(BATCH_LANES, rows - row);
+        for (std::size_t i = 0; i < m_inputs.size(); ++i) {
+            std::memcpy(registers + m_inputs[i].reg * BATCH_LANES, columns[i] + row,
+                        lanes * sizeof(double));
+        }
+        runBlock(lanes);
+        for (std::size_t i = 0; i < m_outputs.size(); ++i) {
+            std::memcpy(results[i] + row, registers + m_outputs[i].reg * BATCH_LANES,
+                        lanes * sizeof(double));
+        }
+    }
+}
+
+void FormulaSet::report() const {
+    if (m_outputs.empty()) {
+        return;
+    }
+    velocitas::logger().info("🧮 Formulas: {} evaluations of {} formulas ({} instructions)",
+                             getEvaluationCount(), m_outputs.size(), m_code.size());
+    for (const auto& output : m_outputs) {
+        if (output.skipped > 0) {
+            velocitas::logger().info("🧮   {} = {}: skipped {} times (input missing or not finite)",
+                                     m_table.getPath(output.slot), output.expression,
+                                     output.skipped);
+        }
+    }
+}
+
+} // namespace runtime
@@ -0,0 +1,225 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef VEHICLE_APP_RUNTIME_FORMULA_H
+#define VEHICLE_APP_RUNTIME_FORMULA_H
+
+#include "runtime/SignalTable.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+namespace runtime {
+
+/**
+ * @brief A formula that does not compile; getPosition() is the offset of the offending character.
+ */
+class FormulaError : public std::runtime_error {
+public:
+    FormulaError(const std::string& message, std::size_t position)
+        : std::runtime_error(message)
+        , m_position(position) {}
+
+    [[nodiscard]] std::size_t getPosition() const { return m_position; }
+
+private:
+    std::size_t m_position;
+};
+
+/**
+ * @brief User formulas over the latest signal values, compiled to register bytecode.
+ *
+ * Each formula defines one output signal from VSS signals, e.g.
+ *
+ *     Vehicle.Derived.SpeedKmh = Vehicle.Speed * 3.6
+ *     Vehicle.Derived.LitersPer100Km =
+ *         if(Vehicle.Speed > 1, Vehicle.Powertrain.FuelSystem.InstantConsumption
+ *                               * 100000 / Vehicle.Speed, 0)
+ *
+ * Language: numbers, signal paths, + - * / ^ (power), unary - and !, the
+ * comparisons < <= > >= == != and the logical && || (true is 1, false 0), and
+ * the functions abs, sqrt, min, max, clamp(x, lo, hi) and if(cond, a, b).
+ * A path naming an earlier formula's output uses that formula's result.
+ *
+ * add() parses a formula once and appends it to one shared instruction stream:
+ * constant subexpressions are folded at compile time, and identical
+ * subexpressions - also across formulas - are computed once. Every value has
+ * its own register, inputs and constants included, so evaluate() is one read
+ * of each input's table slot followed by a linear pass over the instructions.
+ * evaluateBatch() runs the same code over columns of input rows, 64 rows per
+ * instruction, for replay and fleet workloads.
+ *
+ * A formula is only written while every signal it reads has a value, and only
+ * if its result is finite. evaluate() writes table slots, so call it from one
+ * thread (e.g. a handler module); add() must not run concurrently with it.
+ *
+ * Environment:
+ *   APP_FORMULAS_FILE=/etc/app/formulas   one "Output.Path = expression" per
+ *                                         line, # starts a comment
+ *   APP_FORMULAS="A.B = x * 2; C.D = y"   further formulas, ';'-separated
+ */
+class FormulaSet {
+public:
+    /**
+     * @brief Rows per instruction in evaluateBatch().
+     */
+    static constexpr std::size_t BATCH_LANES = 64;
+
+    struct Options {
+        std::string file;
+        std::string formulas;
+
+        static Options fromEnvironment();
+    };
+
+    explicit FormulaSet(SignalTable& table);
+
+    FormulaSet(const FormulaSet&)            = delete;
+    FormulaSet& operator=(const FormulaSet&) = delete;
+    FormulaSet(FormulaSet&&)                 = delete;
+    FormulaSet& operator=(FormulaSet&&)      = delete;
+
+    /**
+     * @brief Compile a formula. Throws FormulaError and leaves the set unchanged on error.
+     *
+     * A failed add() also drops the table slots it registered (SignalTable::truncate()),
+     * so add formulas at startup, before anything reads the table.
+     * @return table slot of the output signal
+     */
+    int add(std::string_view output, std::string_view expression);
+
+    /**
+     * @brief Add the formulas from Options::file and Options::formulas. Bad formulas
+     * are logged and skipped.
+     * @return number of formulas added
+     */
+    std::size_t load(const Options& options);
+
+    /**
+     * @brief Evaluate every formula on the latest table values and write the outputs.
+     */
+    void evaluate();
+
+    /**
+     * @brief Evaluate every formula on rows of input values without touching the table.
+     * @param columns one array of rows per input, in getInputPath() order
+     * @param results one array of rows per formula, in add() order
+     */
+    void evaluateBatch(const double* const* columns, std::size_t rows, double* const* results);
+
+    /**
+     * @brief Log the compiled program size and per-formula skip counts.
+     */
+    void report() const;
+
+    [[nodiscard]] std::size_t      getFormulaCount() const { return m_outputs.size(); }
+    [[nodiscard]] std::size_t      getInputCount() const { return m_inputs.size(); }
+    [[nodiscard]] std::string_view getInputPath(std::size_t input) const {
+        return m_table.getPath(m_inputs[input].slot);
+    }
+    [[nodiscard]] int getOutputSlot(std::size_t formula) const { return m_outputs[formula].slot; }
+    [[nodiscard]] std::size_t   getInstructionCount() const { return m_code.size(); }
+    [[nodiscard]] std::uint64_t getEvaluationCount() const {
+        return m_evaluations.load(std::memory_order_relaxed);
+    }
+
+private:
+    class Compiler;
+
+    enum class Op : std::uint8_t {
+        Add,
+        Subtract,
+        Multiply,
+        Divide,
+        Power,
+        Negate,
+        Not,
+        Abs,
+        Sqrt,
+        Min,
+        Max,
+        Less,
+        LessEqual,
+        Greater,
+        GreaterEqual,
+        Equal,
+        NotEqual,
+        And,
+        Or,
+        Select // a ? b : c
+    };
+
+    struct Instruction {
+        Op            op;
+        std::uint32_t dst;
+        std::uint32_t a;
+        std::uint32_t b;
+        std::uint32_t c;
+    };
+
+    struct Input {
+        int           slot;
+        std::uint32_t reg;
+    };
+
+    struct Output {
+        int                        slot;
+        std::uint32_t              reg;
+        std::vector<std::uint32_t> inputs; // indices into m_inputs
+        std::string                expression;
+        std::uint64_t              skipped{0};
+    };
+
+    static double apply(Op op, double a, double b, double c);
+
+    template <Op OP>
+    static void runLanes(std::size_t lanes, double* dst, const double* a, const double* b,
+                         const double* c);
+
+    std::uint32_t constant(double value);
+    std::uint32_t input(int slot);
+    std::uint32_t emit(Op op, std::uint32_t a, std::uint32_t b = 0, std::uint32_t c = 0);
+    void          runBlock(std::size_t lanes);
+
+    using SharedKey = std::tuple<Op, std::uint32_t, std::uint32_t, std::uint32_t>;
+
+    SignalTable&                           m_table;
+    std::vector<Instruction>               m_code;
+    std::vector<double>                    m_registers;
+    std::vector<std::uint8_t>              m_isConstant; // per register
+    std::vector<Input>                     m_inputs;
+    std::vector<std::uint8_t>              m_inputValid; // per input, last evaluate()
+    std::vector<Output>                    m_outputs;
+    std::vector<double>                    m_lanes;       // evaluateBatch() registers
+    std::map<std::uint64_t, std::uint32_t> m_constants;   // value bits -> register
+    std::map<int, std::uint32_t>           m_inputRegs;   // table slot -> register
+    std::map<int, std::size_t>             m_outputIndex; // table slot -> formula
+    std::map<SharedKey, std::uint32_t>     m_shared;      // common subexpressions
+    std::uint64_t                          m_folded{0};
+    std::uint64_t                          m_reused{0};
+    std::atomic<std::uint64_t>             m_evaluations{0};
+};
+
+} // namespace runtime
+
+#endif // VEHICLE_APP_RUNTIME_FORMULA_H
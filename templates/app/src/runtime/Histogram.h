@@ -0,0 +1,103 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef VEHICLE_APP_RUNTIME_HISTOGRAM_H
+#define VEHICLE_APP_RUNTIME_HISTOGRAM_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace runtime {
+
+/**
+ * @brief Lock-free latency histogram with power-of-two microsecond buckets.
+ *
+ * Bucket i counts durations in [2^(i-1), 2^i) us (bucket 0: below 1 us), the
+ * last bucket everything from about 1 s up. record() is a handful of relaxed
+ * atomic increments, cheap enough for every control step or message; readers
+ * on other threads see a slightly torn but monotonic view, which is fine for
+ * metrics.
+ */
+class LatencyHistogram {
+public:
+    static constexpr std::size_t BUCKETS = 22;
+
+    void record(std::chrono::nanoseconds duration) {
+        const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+        const auto micros  = elapsed > 0 ? static_cast<std::uint64_t>(elapsed) : 0;
+        m_buckets[bucketFor(micros)].fetch_add(1, std::memory_order_relaxed);
+        m_count.fetch_add(1, std::memory_order_relaxed);
+        m_sumMicros.fetch_add(micros, std::memory_order_relaxed);
+        auto max = m_maxMicros.load(std::memory_order_relaxed);
+        while (micros > max &&
+               !m_maxMicros.compare_exchange_weak(max, micros, std::memory_order_relaxed)) {
+        }
+    }
+
+    [[nodiscard]] std::uint64_t getCount() const { return m_count.load(std::memory_order_relaxed); }
+
+    [[nodiscard]] std::chrono::microseconds getMax() const {
+        return std::chrono::microseconds(m_maxMicros.load(std::memory_order_relaxed));
+    }
+
+    [[nodiscard]] std::chrono::microseconds getMean() const {
+        const auto count = getCount();
+        return std::chrono::microseconds(
+            count > 0 ? m_sumMicros.load(std::memory_order_relaxed) / count : 0);
+    }
+
+    /**
+     * @brief Upper bound of the bucket holding the given quantile (0..1).
+     */
+    [[nodiscard]] std::chrono::microseconds getPercentile(double quantile) const {
+        const auto    count  = getCount();
+        const auto    target = static_cast<std::uint64_t>(quantile * static_cast<double>(count));
+        std::uint64_t seen   = 0;
+        for (std::size_t i = 0; i < BUCKETS; ++i) {
+            seen += m_buckets[i].load(std::memory_order_relaxed);
+            if (seen > target || (count > 0 && seen == count)) {
+                return std::chrono::microseconds(std::uint64_t{1} << i);
+            }
+        }
+        return getMax();
+    }
+
+    [[nodiscard]] std::uint64_t getBucket(std::size_t index) const {
+        return m_buckets[index].load(std::memory_order_relaxed);
+    }
+
+private:
+    static std::size_t bucketFor(std::uint64_t micros) {
+        std::size_t bucket = 0;
+        while (micros > 0 && bucket + 1 < BUCKETS) {
+            micros >>= 1U;
+            ++bucket;
+        }
+        return bucket;
+    }
+
+    std::array<std::atomic<std::uint64_t>, BUCKETS> m_buckets{};
+    std::atomic<std::uint64_t>                      m_count{0};
+    std::atomic<std::uint64_t>                      m_sumMicros{0};
+    std::atomic<std::uint64_t>                      m_maxMicros{0};
+};
+
+} // namespace runtime
+
+#endif // VEHICLE_APP_RUNTIME_HISTOGRAM_H
@@ -0,0 +1,301 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "runtime/LaunchOptions.h"
+#include "runtime/ScratchArena.h"
+
+#include "sdk/Logger.h"
+
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+#include <nlohmann/json.hpp>
+
+#include <alloca.h>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+namespace runtime {
+
+namespace {
+
+constexpr std::size_t PAGE_SIZE_FALLBACK = 4096;
+constexpr std::size_t STACK_HEADROOM     = 64 * 1024; // left for the frames after prefaultStack()
+
+LaunchOptions& mutableCurrent() {
+    static LaunchOptions options;
+    return options;
+}
+
+std::vector<int> parseCpuList(const std::string& text) {
+    std::vector<int>  cpus;
+    std::stringstream stream(text);
+    std::string       token;
+    while (std::getline(stream, token, ',')) {
+        if (!token.empty()) {
+            cpus.push_back(std::stoi(token));
+        }
+    }
+    return cpus;
+}
+
+void readTuning(const nlohmann::json& json, ThreadTuning& tuning) {
+    if (json.contains("cpus")) {
+        tuning.cpus = json.at("cpus").get<std::vector<int>>();
+    }
+    if (json.contains("priority")) {
+        tuning.priority = json.at("priority").get<int>();
+    }
+}
+
+void readConfigFile(const char* path, LaunchOptions& options) {
+    std::ifstream file(path);
+    if (!file) {
+        velocitas::logger().warn("⚠️  Launch config {} not readable - using defaults", path);
+        return;
+    }
+    try {
+        const auto json = nlohmann::json::parse(file);
+        if (json.contains("ingest")) {
+            readTuning(json.at("ingest"), options.ingest);
+        }
+        if (json.contains("processing")) {
+            readTuning(json.at("processing"), options.processing);
+        }
+        if (json.contains("critical")) {
+            readTuning(json.at("critical"), options.critical);
+        }
+        options.lockMemory = json.value("mlockall", options.lockMemory);
+        options.prefaultStackBytes =
+            json.value("prefaultStackKb", options.prefaultStackBytes / 1024) * 1024;
+    } catch (const std::exception& e) {
+        velocitas::logger().warn("⚠️  Launch config {} invalid ({}) - using defaults", path,
+                                 e.what());
+    }
+}
+
+void readEnvironment(LaunchOptions& options) {
+    if (const char* value = std::getenv("APP_INGEST_CPUS")) {
+        options.ingest.cpus = parseCpuList(value);
+    }
+    if (const char* value = std::getenv("APP_INGEST_PRIORITY")) {
+        options.ingest.priority = std::atoi(value);
+    }
+    if (const char* value = std::getenv("APP_PROCESSING_CPUS")) {
+        options.processing.cpus = parseCpuList(value);
+    }
+    if (const char* value = std::getenv("APP_PROCESSING_PRIORITY")) {
+        options.processing.priority = std::atoi(value);
+    }
+    if (const char* value = std::getenv("APP_CRITICAL_CPUS")) {
+        options.critical.cpus = parseCpuList(value);
+    }
+    if (const char* value = std::getenv("APP_CRITICAL_PRIORITY")) {
+        options.critical.priority = std::atoi(value);
+    }
+    if (const char* value = std::getenv("APP_MLOCKALL")) {
+        options.lockMemory = std::strcmp(value, "1") == 0 || std::strcmp(value, "true") == 0;
+    }
+    if (const char* value = std::getenv("APP_PREFAULT_STACK_KB")) {
+        options.prefaultStackBytes = static_cast<std::size_t>(std::atol(value)) * 1024;
+    }
+}
+
+std::size_t pageSize() {
+    const long size = ::sysconf(_SC_PAGESIZE);
+    return size > 0 ? static_cast<std::size_t>(size) : PAGE_SIZE_FALLBACK;
+}
+
+// Stack below the caller that may be touched without overflowing: the calling
+// thread's own stack when known, else RLIMIT_STACK
+std::size_t usableStack() {
+    char        here      = 0;
+    std::size_t available = 0;
+
+    pthread_attr_t attr;
+    if (::pthread_getattr_np(::pthread_self(), &attr) == 0) {
+        void*       base = nullptr;
+        std::size_t size = 0;
+        if (::pthread_attr_getstack(&attr, &base, &size) == 0 && &here > static_cast<char*>(base)) {
+            available = static_cast<std::size_t>(&here - static_cast<char*>(base));
+        }
+        ::pthread_attr_destroy(&attr);
+    }
+    if (available == 0) {
+        rlimit limit{};
+        if (::getrlimit(RLIMIT_STACK, &limit) != 0 || limit.rlim_cur == RLIM_INFINITY) {
+            return SIZE_MAX;
+        }
+        available = static_cast<std::size_t>(limit.rlim_cur);
+    }
+    return available > STACK_HEADROOM ? available - STACK_HEADROOM : 0;
+}
+
+} // namespace
+
+LaunchOptions LaunchOptions::fromEnvironment() {
+    LaunchOptions options;
+    if (const char* path = std::getenv("APP_LAUNCH_CONFIG")) {
+        readConfigFile(path, options);
+    }
+    try {
+        readEnvironment(options);
+    } catch (const std::exception& e) {
+        velocitas::logger().warn("⚠️  Invalid launch option in environment ({})", e.what());
+    }
+    return options;
+}
+
+const LaunchOptions& LaunchOptions::current() {
+    return mutableCurrent();
+}
+
+void applyProcessLaunchOptions() {
+    auto& options = mutableCurrent();
+    options       = LaunchOptions::fromEnvironment();
+
+    if (options.lockMemory) {
+        if (::mlockall(MCL_CURRENT | MCL_FUTURE) == 0) {
+            velocitas::logger().info("🔒 mlockall: current and future pages locked");
+        } else {
+            velocitas::logger().warn("⚠️  mlockall failed ({}) - pages may fault at runtime",
+                                     std::strerror(errno));
+        }
+    }
+    if (options.prefaultStackBytes > 0) {
+        prefaultStack(options.prefaultStackBytes);
+    }
+
+    velocitas::logger().info("⚙️  Launch options: ingest cpus [{}] prio {}, processing cpus [{}] "
+                             "prio {}, critical cpus [{}] prio {}, mlockall {}, prefault stack {} KB",
+                             fmt::join(options.ingest.cpus, ","), options.ingest.priority,
+                             fmt::join(options.processing.cpus, ","), options.processing.priority,
+                             fmt::join(options.critical.cpus, ","), options.critical.priority,
+                             options.lockMemory ? "on" : "off", options.prefaultStackBytes / 1024);
+}
+
+AppliedTuning applyToThisThread(const ThreadTuning& tuning, const char* role) {
+    AppliedTuning applied;
+    pthread_t     self = ::pthread_self();
+
+    if (!tuning.cpus.empty()) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        int valid = 0;
+        for (const int cpu : tuning.cpus) {
+            if (cpu < 0 || cpu >= CPU_SETSIZE) {
+                velocitas::logger().warn("⚠️  {} thread: ignoring cpu {} (valid: 0-{})", role, cpu,
+                                         CPU_SETSIZE - 1);
+                continue;
+            }
+            CPU_SET(cpu, &set);
+            ++valid;
+        }
+        const int result = valid > 0 ? ::pthread_setaffinity_np(self, sizeof(set), &set) : EINVAL;
+        if (result != 0) {
+            applied.fallbackReason = fmt::format("affinity: {}", std::strerror(result));
+        }
+    }
+
+    if (tuning.priority > 0) {
+        sched_param param{};
+        param.sched_priority = tuning.priority;
+        const int result     = ::pthread_setschedparam(self, SCHED_FIFO, &param);
+        if (result != 0) {
+            if (!applied.fallbackReason.empty()) {
+                applied.fallbackReason += ", ";
+            }
+            applied.fallbackReason += fmt::format("SCHED_FIFO {}: {}", tuning.priority,
+                                                  std::strerror(result));
+        }
+    }
+
+    cpu_set_t actual;
+    CPU_ZERO(&actual);
+    if (::pthread_getaffinity_np(self, sizeof(actual), &actual) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &actual)) {
+                applied.cpus.push_back(cpu);
+            }
+        }
+    }
+    int         policy = SCHED_OTHER;
+    sched_param param{};
+    if (::pthread_getschedparam(self, &policy, &param) == 0) {
+        applied.priority = param.sched_priority;
+    }
+    applied.policy = policy == SCHED_FIFO ? "SCHED_FIFO"
+                     : policy == SCHED_RR ? "SCHED_RR"
+                                          : "SCHED_OTHER";
+
+    if (LaunchOptions::current().prefaultStackBytes > 0) {
+        prefaultStack(LaunchOptions::current().prefaultStackBytes);
+    }
+
+    if (applied.fallbackReason.empty()) {
+        velocitas::logger().info("⚙️  {} thread: {} prio {} on cpus [{}]", role, applied.policy,
+                                 applied.priority, fmt::join(applied.cpus, ","));
+    } else {
+        velocitas::logger().warn("⚠️  {} thread: {} prio {} on cpus [{}] (fallback - {})", role,
+                                 applied.policy, applied.priority, fmt::join(applied.cpus, ","),
+                                 applied.fallbackReason);
+    }
+    return applied;
+}
+
+void tuneIngestThreadOnce() {
+    thread_local bool tuned = false;
+    if (tuned) {
+        return;
+    }
+    tuned = true;
+    applyToThisThread(LaunchOptions::current().ingest, "ingest");
+    if (LaunchOptions::current().lockMemory || LaunchOptions::current().prefaultStackBytes > 0) {
+        ScratchArena::forThisThread().prefault();
+    }
+}
+
+void prefaultStack(std::size_t bytes) {
+    const std::size_t usable = usableStack();
+    if (bytes > usable) {
+        velocitas::logger().warn(
+            "⚠️  Prefault stack {} KB exceeds the thread stack - clamped to {} KB", bytes / 1024,
+            usable / 1024);
+        bytes = usable;
+    }
+    auto* stack = static_cast<volatile char*>(alloca(bytes));
+    for (std::size_t offset = 0; offset < bytes; offset += pageSize()) {
+        stack[offset] = 0;
+    }
+}
+
+void prefaultBuffer(void* data, std::size_t bytes) {
+    auto* buffer = static_cast<volatile char*>(data);
+    for (std::size_t offset = 0; offset < bytes; offset += pageSize()) {
+        buffer[offset] = buffer[offset];
+    }
+}
+
+} // namespace runtime
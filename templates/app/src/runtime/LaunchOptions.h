@@ -0,0 +1,115 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef VEHICLE_APP_RUNTIME_LAUNCHOPTIONS_H
+#define VEHICLE_APP_RUNTIME_LAUNCHOPTIONS_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace runtime {
+
+/**
+ * @brief Scheduling settings for one class of threads.
+ */
+struct ThreadTuning {
+    std::vector<int> cpus;         // empty: leave affinity to the kernel
+    int              priority{0};  // 1..99 requests SCHED_FIFO, 0 keeps SCHED_OTHER
+};
+
+/**
+ * @brief What was actually applied to a thread - permissions may prevent the request.
+ */
+struct AppliedTuning {
+    std::vector<int> cpus;
+    std::string      policy;
+    int              priority{0};
+    std::string      fallbackReason;
+};
+
+/**
+ * @brief Process launch options for real-time-ish deployments.
+ *
+ * Values are read from a JSON file named by APP_LAUNCH_CONFIG and may be
+ * overridden by individual environment variables:
+ *
+ *   APP_INGEST_CPUS=2,3          CPUs for the subscription callback thread(s)
+ *   APP_INGEST_PRIORITY=80       SCHED_FIFO priority for ingest (0 = SCHED_OTHER)
+ *   APP_PROCESSING_CPUS=1        CPUs for processing worker threads
+ *   APP_PROCESSING_PRIORITY=70   SCHED_FIFO priority for processing workers
+ *   APP_CRITICAL_CPUS=0          CPUs for the critical signal fast lane thread
+ *   APP_CRITICAL_PRIORITY=90     SCHED_FIFO priority for the fast lane
+ *   APP_MLOCKALL=1               lock current and future pages into RAM
+ *   APP_PREFAULT_STACK_KB=256    stack to pre-fault on every tuned thread
+ *
+ * JSON layout:
+ *   { "ingest": { "cpus": [2, 3], "priority": 80 },
+ *     "processing": { "cpus": [1], "priority": 70 },
+ *     "critical": { "cpus": [0], "priority": 90 },
+ *     "mlockall": true, "prefaultStackKb": 256 }
+ */
+struct LaunchOptions {
+    ThreadTuning ingest;
+    ThreadTuning processing;
+    ThreadTuning critical;
+    bool         lockMemory{false};
+    std::size_t  prefaultStackBytes{0};
+
+    static LaunchOptions fromEnvironment();
+
+    /**
+     * @brief Options loaded by applyProcessLaunchOptions(); defaults before that.
+     */
+    static const LaunchOptions& current();
+};
+
+/**
+ * @brief Load the options, lock memory if requested and log the outcome.
+ *
+ * Call once from main() before the app starts.
+ */
+void applyProcessLaunchOptions();
+
+/**
+ * @brief Pin and prioritise the calling thread, pre-fault its stack and log the outcome.
+ *
+ * Failures (e.g. missing CAP_SYS_NICE) fall back to the default scheduler and are
+ * reported in AppliedTuning::fallbackReason - they never abort the app.
+ */
+AppliedTuning applyToThisThread(const ThreadTuning& tuning, const char* role);
+
+/**
+ * @brief Apply the ingest options to the calling thread once; cheap on later calls.
+ *
+ * Meant for SDK-owned callback threads, which the app cannot configure up front.
+ */
+void tuneIngestThreadOnce();
+
+/**
+ * @brief Touch the given number of bytes of the calling thread's stack, clamped
+ * to what the stack can hold.
+ */
+void prefaultStack(std::size_t bytes);
+
+/**
+ * @brief Touch every page of a buffer so later writes do not page-fault.
+ */
+void prefaultBuffer(void* data, std::size_t bytes);
+
+} // namespace runtime
+
+#endif // VEHICLE_APP_RUNTIME_LAUNCHOPTIONS_H
@@ -0,0 +1,135 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef VEHICLE_APP_RUNTIME_LAZYMODEL_H
+#define VEHICLE_APP_RUNTIME_LAZYMODEL_H
+
+#include "sdk/Logger.h"
+
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <thread>
+
+namespace runtime {
+
+/**
+ * @brief Storage for a global object that is built on first use instead of
+ * during static initialization.
+ *
+ * The handle is constant-initialized (constinit), so it costs nothing before
+ * main() and has no initialization-order issues. get() constructs the object
+ * exactly once - concurrent callers wait for the first one - and afterwards is
+ * a single acquire load. reference() may be bound before construction, which
+ * keeps existing `Vehicle.Speed` code unchanged:
+ *
+ *   constinit runtime::LazyModel<::vehicle::Vehicle> VehicleModel;
+ *   constinit ::vehicle::Vehicle& Vehicle = VehicleModel.reference();
+ *
+ * Anything reached through reference() must run after get(). The object is
+ * never destroyed: threads still running at exit may hold its signals. A
+ * prefetch thread is joined by the first get() or, if main() returns before
+ * any, by the destructor.
+ */
+template <typename T>
+class LazyModel {
+public:
+    constexpr LazyModel() noexcept = default;
+    ~LazyModel() { joinPrefetch(); }
+
+    LazyModel(const LazyModel&)            = delete;
+    LazyModel& operator=(const LazyModel&) = delete;
+    LazyModel(LazyModel&&)                 = delete;
+    LazyModel& operator=(LazyModel&&)      = delete;
+
+    /**
+     * @brief The object, constructed by the first call.
+     */
+    T& get() {
+        if (!m_constructed.load(std::memory_order_acquire)) {
+            joinPrefetch();
+            construct();
+        }
+        return m_storage.value;
+    }
+
+    /**
+     * @brief Start construction on a background thread, to overlap it with other
+     * startup work. A later get() waits for it; if it failed, get() retries.
+     * Further calls do nothing.
+     */
+    void prefetch() {
+        std::lock_guard<std::mutex> lock(m_prefetchMutex);
+        if (m_prefetch.has_value()) {
+            return;
+        }
+        m_prefetch.emplace([this] {
+            try {
+                construct();
+            } catch (const std::exception& e) {
+                velocitas::logger().error("❌ Model prefetch failed: {} - get() retries", e.what());
+            } catch (...) {
+                velocitas::logger().error("❌ Model prefetch failed: unknown exception - get() "
+                                          "retries");
+            }
+        });
+    }
+
+    /**
+     * @brief Where the object will live - usable in constant initializers.
+     */
+    [[nodiscard]] constexpr T& reference() noexcept { return m_storage.value; }
+
+    [[nodiscard]] bool isConstructed() const {
+        return m_constructed.load(std::memory_order_acquire);
+    }
+
+private:
+    void construct() {
+        std::call_once(m_once, [this] {
+            ::new (static_cast<void*>(&m_storage.value)) T();
+            m_constructed.store(true, std::memory_order_release);
+        });
+    }
+
+    void joinPrefetch() {
+        std::lock_guard<std::mutex> lock(m_prefetchMutex);
+        if (m_prefetch.has_value() && m_prefetch->joinable()) {
+            m_prefetch->join();
+        }
+    }
+
+    union Storage {
+        constexpr Storage() noexcept
+            : empty{} {}
+        ~Storage() {}
+
+        char empty;
+        T    value;
+    };
+
+    Storage                    m_storage;
+    std::once_flag             m_once;
+    std::atomic<bool>          m_constructed{false};
+    std::mutex                 m_prefetchMutex;
+    std::optional<std::thread> m_prefetch; // empty until prefetch()
+};
+
+} // namespace runtime
+
+#endif // VEHICLE_APP_RUNTIME_LAZYMODEL_H
@@ -0,0 +1,605 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "runtime/LiveStream.h"
+
+#include "runtime/ScratchArena.h"
+
+#include "sdk/Logger.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <linux/sockios.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace runtime {
+
+namespace {
+
+constexpr std::size_t MAX_HANDSHAKE_BYTES = 8 * 1024;
+constexpr std::size_t MAX_CLIENT_PAYLOAD  = 64 * 1024;
+constexpr char        WEBSOCKET_GUID[]    = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+
+constexpr std::uint8_t OPCODE_TEXT  = 0x1;
+constexpr std::uint8_t OPCODE_CLOSE = 0x8;
+constexpr std::uint8_t OPCODE_PING  = 0x9;
+constexpr std::uint8_t OPCODE_PONG  = 0xA;
+
+/**
+ * @brief SHA-1 as required by the WebSocket handshake (RFC 6455, section 4.2.2).
+ */
+std::array<std::uint8_t, 20> sha1(const std::string& message) {
+    std::uint32_t h[5] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+
+    std::vector<std::uint8_t> data(message.begin(), message.end());
+    const std::uint64_t       bitLength = static_cast<std::uint64_t>(message.size()) * 8;
+    data.push_back(0x80);
+    while (data.size() % 64 != 56) {
+        data.push_back(0);
+    }
+    for (int shift = 56; shift >= 0; shift -= 8) {
+        data.push_back(static_cast<std::uint8_t>(bitLength >> shift));
+    }
+
+    const auto rotl = [](std::uint32_t value, int bits) {
+        return (value << bits) | (value >> (32 - bits));
+    };
+    for (std::size_t chunk = 0; chunk < data.size(); chunk += 64) {
+        std::uint32_t w[80];
+        for (int i = 0; i < 16; ++i) {
+            w[i] = static_cast<std::uint32_t>(data[chunk + 4 * i]) << 24 |
+                   static_cast<std::uint32_t>(data[chunk + 4 * i + 1]) << 16 |
+                   static_cast<std::uint32_t>(data[chunk + 4 * i + 2]) << 8 |
+                   static_cast<std::uint32_t>(data[chunk + 4 * i + 3]);
+        }
+        for (int i = 16; i < 80; ++i) {
+            w[i] = rotl(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+        }
+        std::uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+        for (int i = 0; i < 80; ++i) {
+            std::uint32_t f = 0;
+            std::uint32_t k = 0;
+            if (i < 20) {
+                f = (b & c) | (~b & d);
+                k = 0x5A827999;
+            } else if (i < 40) {
+                f = b ^ c ^ d;
+                k = 0x6ED9EBA1;
+            } else if (i < 60) {
+                f = (b & c) | (b & d) | (c & d);
+                k = 0x8F1BBCDC;
+            } else {
+                f = b ^ c ^ d;
+                k = 0xCA62C1D6;
+            }
+            const std::uint32_t next = rotl(a, 5) + f + e + k + w[i];
+            e                        = d;
+            d                        = c;
+            c                        = rotl(b, 30);
+            b                        = a;
+            a                        = next;
+        }
+        h[0] += a;
+        h[1] += b;
+        h[2] += c;
+        h[3] += d;
+        h[4] += e;
+    }
+
+    std::array<std::uint8_t, 20> digest{};
+    for (int i = 0; i < 20; ++i) {
+        digest[i] = static_cast<std::uint8_t>(h[i / 4] >> (24 - 8 * (i % 4)));
+    }
+    return digest;
+}
+
+std::string base64(const std::uint8_t* data, std::size_t size) {
+    static constexpr char alphabet[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string encoded;
+    for (std::size_t i = 0; i < size; i += 3) {
+        const std::uint32_t triple = static_cast<std::uint32_t>(data[i]) << 16 |
+                                     (i + 1 < size ? data[i + 1] << 8 : 0) |
+                                     (i + 2 < size ? data[i + 2] : 0);
+        encoded += alphabet[(triple >> 18) & 0x3F];
+        encoded += alphabet[(triple >> 12) & 0x3F];
+        encoded += i + 1 < size ? alphabet[(triple >> 6) & 0x3F] : '=';
+        encoded += i + 2 < size ? alphabet[triple & 0x3F] : '=';
+    }
+    return encoded;
+}
+
+/**
+ * @brief Value of an HTTP header (case-insensitive name), empty if absent.
+ */
+std::string headerValue(const std::string& request, const std::string& name) {
+    std::size_t lineStart = request.find("\r\n");
+    while (lineStart != std::string::npos && lineStart + 2 < request.size()) {
+        lineStart += 2;
+        const auto lineEnd = request.find("\r\n", lineStart);
+        const auto colon   = request.find(':', lineStart);
+        if (colon != std::string::npos && colon < lineEnd && colon - lineStart == name.size() &&
+            std::equal(name.begin(), name.end(), request.begin() + lineStart,
+                       [](char a, char b) { return std::tolower(a) == std::tolower(b); })) {
+            auto value = request.substr(colon + 1, lineEnd - colon - 1);
+            value.erase(0, value.find_first_not_of(" \t"));
+            value.erase(value.find_last_not_of(" \t") + 1);
+            return value;
+        }
+        lineStart = lineEnd;
+    }
+    return {};
+}
+
+template <typename String>
+void appendFrameHeader(String& out, std::uint8_t opcode, std::size_t length) {
+    out += static_cast<char>(0x80 | opcode);
+    if (length < 126) {
+        out += static_cast<char>(length);
+    } else if (length <= 0xFFFF) {
+        out += static_cast<char>(126);
+        out += static_cast<char>(length >> 8);
+        out += static_cast<char>(length);
+    } else {
+        out += static_cast<char>(127);
+        for (int shift = 56; shift >= 0; shift -= 8) {
+            out += static_cast<char>(static_cast<std::uint64_t>(length) >> shift);
+        }
+    }
+}
+
+} // namespace
+
+LiveStream::Options LiveStream::Options::fromEnvironment() {
+    Options options;
+    if (const char* port = std::getenv("APP_LIVE_STREAM_PORT")) {
+        const long parsed = std::atol(port);
+        if (parsed > 0 && parsed <= 0xFFFF) {
+            options.port = static_cast<std::uint16_t>(parsed);
+        }
+    }
+    if (const char* address = std::getenv("APP_LIVE_STREAM_BIND")) {
+        options.bindAddress = address;
+    }
+    if (const char* rate = std::getenv("APP_LIVE_STREAM_MAX_HZ")) {
+        const double parsed = std::atof(rate);
+        if (parsed > 0.0) {
+            options.maxRate = parsed;
+        }
+    }
+    return options;
+}
+
+LiveStream::LiveStream(const SignalTable& table, Options options)
+    : m_table(table)
+    , m_options(std::move(options))
+    , m_minInterval(std::chrono::duration_cast<Clock::duration>(
+          std::chrono::duration<double>(1.0 / m_options.maxRate))) {}
+
+LiveStream::~LiveStream() {
+    stop();
+}
+
+bool LiveStream::start() {
+    if (!isEnabled() || isRunning()) {
+        return isRunning();
+    }
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port   = htons(m_options.port);
+    if (::inet_pton(AF_INET, m_options.bindAddress.c_str(), &address.sin_addr) != 1) {
+        velocitas::logger().error("❌ Live stream: invalid bind address {}", m_options.bindAddress);
+        return false;
+    }
+
+    m_listenFd      = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    const int reuse = 1;
+    if (m_listenFd >= 0) {
+        ::setsockopt(m_listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    }
+    if (m_listenFd < 0 ||
+        ::bind(m_listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(m_listenFd, static_cast<int>(m_options.maxClients)) != 0) {
+        velocitas::logger().error("❌ Live stream port {} unavailable: {}", m_options.port,
+                                  std::strerror(errno));
+        if (m_listenFd >= 0) {
+            ::close(m_listenFd);
+            m_listenFd = -1;
+        }
+        return false;
+    }
+
+    m_epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+    m_wakeFd  = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    epoll_event event{};
+    event.events  = EPOLLIN;
+    event.data.fd = m_listenFd;
+    ::epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_listenFd, &event);
+    event.data.fd = m_wakeFd;
+    ::epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_wakeFd, &event);
+
+    m_thread = std::thread(&LiveStream::loop, this);
+    velocitas::logger().info("📡 Live stream on ws://{}:{}/?hz=N (max {} Hz)",
+                             m_options.bindAddress, m_options.port, m_options.maxRate);
+    return true;
+}
+
+void LiveStream::stop() {
+    if (!isRunning()) {
+        return;
+    }
+    const std::uint64_t one = 1;
+    (void)::write(m_wakeFd, &one, sizeof(one));
+    m_thread.join();
+
+    while (!m_clients.empty()) {
+        closeClient(m_clients.begin()->first);
+    }
+    ::close(m_listenFd);
+    ::close(m_epollFd);
+    ::close(m_wakeFd);
+    m_listenFd = m_epollFd = m_wakeFd = -1;
+}
+
+void LiveStream::loop() {
+    std::array<epoll_event, 32> events{};
+    for (;;) {
+        // Tick at the frame rate while anybody is connected, sleep otherwise.
+        const int timeout =
+            m_clients.empty()
+                ? -1
+                : static_cast<int>(std::max<std::int64_t>(
+                      1, std::chrono::duration_cast<std::chrono::milliseconds>(m_minInterval)
+                             .count()));
+        const int ready =
+            ::epoll_wait(m_epollFd, events.data(), static_cast<int>(events.size()), timeout);
+        if (ready < 0 && errno != EINTR) {
+            velocitas::logger().error("❌ Live stream epoll failed: {}", std::strerror(errno));
+            return;
+        }
+
+        // Frames, payloads and bookkeeping of this pass live in the thread's arena
+        ScratchScope scratch;
+        const auto   now = Clock::now();
+        for (int i = 0; i < ready; ++i) {
+            const int fd = events[i].data.fd;
+            if (fd == m_wakeFd) {
+                return;
+            }
+            if (fd == m_listenFd) {
+                acceptClients();
+                continue;
+            }
+            auto found = m_clients.find(fd);
+            if (found == m_clients.end()) {
+                continue;
+            }
+            bool keep = (events[i].events & (EPOLLERR | EPOLLHUP)) == 0;
+            if (keep && (events[i].events & EPOLLIN) != 0) {
+                keep = readFrom(found->second, now);
+            }
+            if (keep) {
+                keep = flush(found->second);
+            }
+            if (!keep) {
+                closeClient(fd);
+            }
+        }
+
+        fanOut(now);
+    }
+}
+
+void LiveStream::acceptClients() {
+    for (;;) {
+        const int fd = ::accept4(m_listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            return;
+        }
+        if (m_clients.size() >= m_options.maxClients) {
+            ::close(fd);
+            continue;
+        }
+        const int noDelay = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+        epoll_event event{};
+        event.events  = EPOLLIN | EPOLLRDHUP;
+        event.data.fd = fd;
+        ::epoll_ctl(m_epollFd, EPOLL_CTL_ADD, fd, &event);
+        auto& client      = m_clients[fd];
+        client.fd         = fd;
+        client.acceptedAt = Clock::now();
+    }
+}
+
+bool LiveStream::readFrom(Client& client, Clock::time_point now) {
+    std::array<char, 4096> chunk{};
+    for (;;) {
+        const auto received = ::recv(client.fd, chunk.data(), chunk.size(), 0);
+        if (received == 0) {
+            return false;
+        }
+        if (received < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                return false;
+            }
+            break;
+        }
+        client.inbox.append(chunk.data(), static_cast<std::size_t>(received));
+    }
+
+    if (!client.open && !handshake(client, now)) {
+        return false;
+    }
+    return !client.open || handleClientFrames(client);
+}
+
+bool LiveStream::handshake(Client& client, Clock::time_point now) {
+    const auto end = client.inbox.find("\r\n\r\n");
+    if (end == std::string::npos) {
+        return client.inbox.size() < MAX_HANDSHAKE_BYTES;
+    }
+    const auto request = client.inbox.substr(0, end + 2);
+    client.inbox.erase(0, end + 4);
+
+    const auto key = headerValue(request, "Sec-WebSocket-Key");
+    if (request.compare(0, 4, "GET ") != 0 || key.empty()) {
+        const std::string reply = "HTTP/1.1 400 Bad Request\r\nContent-Length: 0\r\n\r\n";
+        (void)::send(client.fd, reply.data(), reply.size(), MSG_NOSIGNAL);
+        return false;
+    }
+
+    // Requested rate from the query string (?hz=N), never above maxRate.
+    client.interval       = m_minInterval;
+    const auto requestUri = request.substr(4, request.find(' ', 4) - 4);
+    const auto query      = requestUri.find('?');
+    for (auto param = query; param != std::string::npos; param = requestUri.find('&', param)) {
+        ++param; // skip '?' or '&'
+        if (requestUri.compare(param, 3, "hz=") != 0) {
+            continue;
+        }
+        const double rate = std::atof(requestUri.c_str() + param + 3);
+        if (rate > 0.0) {
+            client.interval = std::max(m_minInterval,
+                                       std::chrono::duration_cast<Clock::duration>(
+                                           std::chrono::duration<double>(1.0 / rate)));
+        }
+    }
+
+    const auto digest = sha1(key + WEBSOCKET_GUID);
+    client.outbox.push_back(std::make_shared<const std::string>(
+        "HTTP/1.1 101 Switching Protocols\r\n"
+        "Upgrade: websocket\r\n"
+        "Connection: Upgrade\r\n"
+        "Sec-WebSocket-Accept: " +
+        base64(digest.data(), digest.size()) + "\r\n\r\n"));
+    client.open     = true;
+    client.nextSend = now;
+    return true;
+}
+
+bool LiveStream::handleClientFrames(Client& client) {
+    // Clients only send control frames we care about (close, ping); data is ignored.
+    for (;;) {
+        const auto* bytes = reinterpret_cast<const std::uint8_t*>(client.inbox.data());
+        const auto  size  = client.inbox.size();
+        if (size < 2) {
+            return true;
+        }
+        const std::uint8_t opcode = bytes[0] & 0x0F;
+        const bool         masked = (bytes[1] & 0x80) != 0;
+        std::uint64_t      length = bytes[1] & 0x7F;
+        std::size_t        offset = 2;
+        if (length == 126) {
+            if (size < 4) {
+                return true;
+            }
+            length = static_cast<std::uint64_t>(bytes[2]) << 8 | bytes[3];
+            offset = 4;
+        } else if (length == 127) {
+            if (size < 10) {
+                return true;
+            }
+            length = 0;
+            for (int i = 0; i < 8; ++i) {
+                length = length << 8 | bytes[2 + i];
+            }
+            offset = 10;
+        }
+        if (!masked || length > MAX_CLIENT_PAYLOAD) {
+            return false; // RFC 6455: client frames must be masked
+        }
+        if (size < offset + 4 + length) {
+            return true;
+        }
+
+        const auto*   mask = bytes + offset;
+        ScratchString payload(client.inbox.data() + offset + 4, length,
+                              ScratchArena::forThisThread().resource());
+        for (std::size_t i = 0; i < payload.size(); ++i) {
+            payload[i] = static_cast<char>(payload[i] ^ mask[i % 4]);
+        }
+        client.inbox.erase(0, offset + 4 + length);
+
+        if (opcode == OPCODE_CLOSE) {
+            return false;
+        }
+        if (opcode == OPCODE_PING) {
+            auto pong = std::make_shared<std::string>();
+            appendFrameHeader(*pong, OPCODE_PONG, payload.size());
+            pong->append(payload.data(), payload.size());
+            client.outbox.push_back(std::move(pong));
+        }
+    }
+}
+
+void LiveStream::encodeSnapshot() {
+    const auto    count   = m_table.getCount();
+    std::uint64_t version = 0;
+    SignalSample  sample;
+    for (std::uint32_t i = 0; i < count; ++i) {
+        if (m_table.read(static_cast<int>(i), sample)) {
+            version += sample.updateCount;
+        }
+    }
+    if (m_latest && version == m_latestVersion) {
+        return;
+    }
+
+    ScratchString json(ScratchArena::forThisThread().resource());
+    json.reserve(64 + count * 48);
+    fmt::format_to(std::back_inserter(json), "{{\"t\":{},\"signals\":{{",
+                   SignalTable::monotonicNanos());
+    bool first = true;
+    for (std::uint32_t i = 0; i < count; ++i) {
+        if (!m_table.read(static_cast<int>(i), sample)) {
+            continue;
+        }
+        fmt::format_to(std::back_inserter(json), "{}\"{}\":", first ? "" : ",",
+                       m_table.getPath(static_cast<int>(i)));
+        if (std::isfinite(sample.value)) {
+            fmt::format_to(std::back_inserter(json), "{}", sample.value);
+        } else {
+            json += "null";
+        }
+        first = false;
+    }
+    json += "}}";
+
+    // The frame outlives this pass; reuse its buffer once no client holds it
+    auto frame = m_latest.use_count() == 1 ? std::const_pointer_cast<std::string>(m_latest)
+                                           : std::make_shared<std::string>();
+    frame->clear();
+    frame->reserve(json.size() + 10);
+    appendFrameHeader(*frame, OPCODE_TEXT, json.size());
+    frame->append(json.data(), json.size());
+
+    m_latest        = std::move(frame);
+    m_latestVersion = version;
+    ++m_latestId;
+    m_encodedFrames.fetch_add(1, std::memory_order_relaxed);
+}
+
+void LiveStream::fanOut(Clock::time_point now) {
+    ScratchVector<int> dropped(ScratchArena::forThisThread().resource());
+    bool               encoded = false;
+    for (auto& [fd, client] : m_clients) {
+        if (!client.open) {
+            if (now - client.acceptedAt > m_options.handshakeTimeout) {
+                dropped.push_back(fd); // connected but never upgraded
+            }
+            continue;
+        }
+        // Bytes the peer has not acknowledged yet, in our queue or the kernel's.
+        int unacked = 0;
+        if (client.outbox.empty() && ::ioctl(fd, SIOCOUTQ, &unacked) != 0) {
+            unacked = 0;
+        }
+        if (!client.outbox.empty() || unacked > 0) {
+            // Coalesce by skipping this frame, but only for so long.
+            if (!client.lagging) {
+                client.lagging      = true;
+                client.blockedSince = now;
+            } else if (now - client.blockedSince > m_options.stallTimeout) {
+                m_slowDisconnects.fetch_add(1, std::memory_order_relaxed);
+                velocitas::logger().warn("🐢 Live stream: dropping slow client (fd {})", fd);
+                dropped.push_back(fd);
+            }
+            continue;
+        }
+        client.lagging = false;
+        if (now < client.nextSend) {
+            continue;
+        }
+        if (!encoded) {
+            encodeSnapshot(); // at most once per pass, shared by every due client
+            encoded = true;
+        }
+        if (client.sentFrame == m_latestId) {
+            continue;
+        }
+        client.sentFrame = m_latestId;
+        client.nextSend  = now + client.interval;
+        client.outbox.push_back(m_latest);
+        if (!flush(client)) {
+            dropped.push_back(fd);
+        }
+    }
+    for (const int fd : dropped) {
+        closeClient(fd);
+    }
+}
+
+bool LiveStream::flush(Client& client) {
+    while (!client.outbox.empty()) {
+        const auto& frame = *client.outbox.front();
+        const auto  sent  = ::send(client.fd, frame.data() + client.outOffset,
+                                   frame.size() - client.outOffset, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                return false;
+            }
+            break;
+        }
+        client.outOffset += static_cast<std::size_t>(sent);
+        if (client.outOffset == frame.size()) {
+            client.outbox.pop_front();
+            client.outOffset = 0;
+        }
+    }
+
+    const bool pending = !client.outbox.empty();
+    if (pending != client.wantsWrite) {
+        epoll_event event{};
+        event.events  = EPOLLIN | EPOLLRDHUP | (pending ? EPOLLOUT : 0U);
+        event.data.fd = client.fd;
+        ::epoll_ctl(m_epollFd, EPOLL_CTL_MOD, client.fd, &event);
+        client.wantsWrite = pending;
+    }
+    return true;
+}
+
+void LiveStream::closeClient(int fd) {
+    ::epoll_ctl(m_epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+    m_clients.erase(fd);
+}
+
+} // namespace runtime
@@ -0,0 +1,146 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef VEHICLE_APP_RUNTIME_LIVESTREAM_H
+#define VEHICLE_APP_RUNTIME_LIVESTREAM_H
+
+#include "runtime/SignalTable.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace runtime {
+
+/**
+ * @brief WebSocket live stream of the signal table for browser dashboards.
+ *
+ * Instead of forwarding every sample (as an MQTT websocket bridge would), the
+ * stream snapshots the latest values at most maxRate times per second, encodes
+ * each snapshot once as a complete WebSocket text frame and shares that buffer
+ * between all clients:
+ *
+ *   {"t":<monotonic ns>,"signals":{"Vehicle.Speed":12.5,...}}
+ *
+ * Each client asks for its own rate with ws://host:port/?hz=5 (capped at
+ * maxRate). A client has at most one frame in flight and gets the newest
+ * snapshot once it has acknowledged it, so a slow client sees fewer, fresher
+ * frames rather than a growing delay; one that stays behind for stallTimeout
+ * is disconnected. A connection that has not completed the WebSocket upgrade
+ * within handshakeTimeout is closed, so idle sockets cannot hold client slots.
+ *
+ * Environment:
+ *   APP_LIVE_STREAM_PORT=9002        enable the server (9001 is the MQTT websocket)
+ *   APP_LIVE_STREAM_BIND=0.0.0.0     listen address (default 127.0.0.1)
+ *   APP_LIVE_STREAM_MAX_HZ=20        upper rate cap for all clients
+ */
+class LiveStream {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Options {
+        std::uint16_t             port{0}; // 0 = disabled
+        std::string               bindAddress{"127.0.0.1"};
+        double                    maxRate{20.0};
+        std::size_t               maxClients{8};
+        std::chrono::milliseconds stallTimeout{std::chrono::milliseconds(2000)};
+        std::chrono::milliseconds handshakeTimeout{std::chrono::milliseconds(5000)};
+
+        static Options fromEnvironment();
+    };
+
+    LiveStream(const SignalTable& table, Options options);
+    ~LiveStream();
+
+    LiveStream(const LiveStream&)            = delete;
+    LiveStream& operator=(const LiveStream&) = delete;
+    LiveStream(LiveStream&&)                 = delete;
+    LiveStream& operator=(LiveStream&&)      = delete;
+
+    /**
+     * @brief Open the listening socket and start the stream thread.
+     * @return false if disabled or the port could not be bound
+     */
+    bool start();
+
+    /**
+     * @brief Disconnect all clients and join the thread. Idempotent.
+     */
+    void stop();
+
+    [[nodiscard]] bool isEnabled() const { return m_options.port != 0; }
+    [[nodiscard]] bool isRunning() const { return m_thread.joinable(); }
+
+    [[nodiscard]] std::uint64_t getEncodedFrames() const {
+        return m_encodedFrames.load(std::memory_order_relaxed);
+    }
+    [[nodiscard]] std::uint64_t getSlowClientDisconnects() const {
+        return m_slowDisconnects.load(std::memory_order_relaxed);
+    }
+
+private:
+    using Frame = std::shared_ptr<const std::string>;
+
+    struct Client {
+        int               fd{-1};
+        bool              open{false}; // handshake completed
+        std::string       inbox;
+        std::deque<Frame> outbox;
+        std::size_t       outOffset{0};
+        bool              wantsWrite{false};
+        bool              lagging{false}; // unacknowledged data at the last tick
+        Clock::duration   interval{};
+        Clock::time_point nextSend;
+        Clock::time_point blockedSince;
+        Clock::time_point acceptedAt;
+        std::uint64_t     sentFrame{0};
+    };
+
+    void loop();
+    void acceptClients();
+    bool readFrom(Client& client, Clock::time_point now);
+    bool handshake(Client& client, Clock::time_point now);
+    bool handleClientFrames(Client& client);
+    void encodeSnapshot();
+    void fanOut(Clock::time_point now);
+
+    bool flush(Client& client);
+    void closeClient(int fd);
+
+    const SignalTable&              m_table;
+    Options                         m_options;
+    Clock::duration                 m_minInterval;
+    int                             m_listenFd{-1};
+    int                             m_epollFd{-1};
+    int                             m_wakeFd{-1};
+    std::thread                     m_thread;
+    std::unordered_map<int, Client> m_clients;
+
+    Frame                      m_latest;
+    std::uint64_t              m_latestId{0};
+    std::uint64_t              m_latestVersion{0}; // sum of update counts at encode time
+    std::atomic<std::uint64_t> m_encodedFrames{0};
+    std::atomic<std::uint64_t> m_slowDisconnects{0};
+};
+
+} // namespace runtime
+
+#endif // VEHICLE_APP_RUNTIME_LIVESTREAM_H
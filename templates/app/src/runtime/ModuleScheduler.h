@@ -0,0 +1,457 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef VEHICLE_APP_RUNTIME_MODULESCHEDULER_H
+#define VEHICLE_APP_RUNTIME_MODULESCHEDULER_H
+
+#include "runtime/Histogram.h"
+#include "runtime/LaunchOptions.h"
+#include "runtime/RingBuffer.h"
+#include "runtime/Shutdown.h"
+#include "sdk/Logger.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace runtime {
+
+/**
+ * @brief Scheduling class of a handler module; lower values run first.
+ */
+enum class PriorityClass : std::uint8_t {
+    Critical,  // safety-relevant: runs before everything else, never throttled
+    Normal,    // application logic
+    Background // analytics: runs when nothing else is waiting
+};
+
+/**
+ * @brief Per-module scheduling parameters.
+ *
+ * Environment overrides, with NAME the upper-cased module name ('-' becomes '_'):
+ *   APP_MODULE_<NAME>_PRIORITY=background   critical, normal or background
+ *   APP_MODULE_<NAME>_BUDGET_US=500         CPU time per period (0 = unlimited)
+ *   APP_MODULE_<NAME>_QUEUE=256             input queue capacity
+ */
+struct ModuleOptions {
+    PriorityClass             priority{PriorityClass::Normal};
+    std::chrono::microseconds budget{0};
+    std::size_t               queueCapacity{256};
+
+    ModuleOptions withEnvironment(const std::string& moduleName) const {
+        std::string prefix = "APP_MODULE_";
+        for (const char c : moduleName) {
+            prefix += c == '-' ? '_' : static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+        }
+        ModuleOptions options = *this;
+        if (const char* priorityName = std::getenv((prefix + "_PRIORITY").c_str())) {
+            if (std::strcmp(priorityName, "critical") == 0) {
+                options.priority = PriorityClass::Critical;
+            } else if (std::strcmp(priorityName, "background") == 0) {
+                options.priority = PriorityClass::Background;
+            } else {
+                options.priority = PriorityClass::Normal;
+            }
+        }
+        if (const char* budgetUs = std::getenv((prefix + "_BUDGET_US").c_str())) {
+            options.budget = std::chrono::microseconds(std::max(0L, std::atol(budgetUs)));
+        }
+        if (const char* queueSize = std::getenv((prefix + "_QUEUE").c_str())) {
+            const long capacity = std::atol(queueSize);
+            if (capacity > 0) {
+                options.queueCapacity = static_cast<std::size_t>(capacity);
+            }
+        }
+        return options;
+    }
+};
+
+/**
+ * @brief Counters and latencies of one module; readable from any thread.
+ */
+struct ModuleMetrics {
+    std::atomic<std::uint64_t> processed{0};
+    std::atomic<std::uint64_t> rejected{0};   // dropped at the full input queue
+    std::atomic<std::uint64_t> throttled{0};  // deferred to the next period, budget used up
+    std::atomic<std::uint64_t> violations{0}; // periods in which the budget was exceeded
+    std::atomic<std::uint64_t> preempted{0};  // batches cut short for a higher class
+    LatencyHistogram           latency;       // dispatch to end of handling
+    LatencyHistogram           cpu;           // thread CPU time per item
+};
+
+/**
+ * @brief Runs handler modules with priority classes and per-period CPU budgets.
+ *
+ * dispatch() hands every item to every module. One scheduler thread then picks
+ * the highest-priority module with queued work - round robin within a class -
+ * and runs up to Options::batchSize of its items. Between two items it checks
+ * for waiting work of a higher class and, if there is any, ends the batch, so a
+ * Critical item waits at most for one item of a lower class (the longest such
+ * item is reported as the critical wait bound). Handlers are never interrupted
+ * in the middle of an item.
+ *
+ * A module's CPU time (CLOCK_THREAD_CPUTIME_ID) is charged against its budget for
+ * the current period. A Normal or Background module that used up its budget is
+ * deferred until the next period; a Critical module keeps running. Either way
+ * the overrun counts as a budget violation.
+ *
+ * The scheduler thread uses the "processing" launch options. Item must be
+ * default-constructible and copyable.
+ *
+ * Environment:
+ *   APP_MODULE_PERIOD_MS=10   budget accounting period
+ */
+template <typename Item>
+class ModuleScheduler {
+public:
+    using Clock   = std::chrono::steady_clock;
+    using Handler = std::function<void(const Item& item)>;
+
+    struct Options {
+        std::chrono::milliseconds period{10};
+        std::size_t               batchSize{16};
+
+        static Options fromEnvironment() {
+            Options options;
+            if (const char* period = std::getenv("APP_MODULE_PERIOD_MS")) {
+                const long ms = std::atol(period);
+                if (ms > 0) {
+                    options.period = std::chrono::milliseconds(ms);
+                }
+            }
+            return options;
+        }
+    };
+
+    ModuleScheduler(std::string name, Options options)
+        : m_name(std::move(name))
+        , m_options(options) {
+        m_options.batchSize = std::max<std::size_t>(m_options.batchSize, 1);
+    }
+
+    ~ModuleScheduler() { flush(Clock::now()); }
+
+    ModuleScheduler(const ModuleScheduler&)            = delete;
+    ModuleScheduler& operator=(const ModuleScheduler&) = delete;
+    ModuleScheduler(ModuleScheduler&&)                 = delete;
+    ModuleScheduler& operator=(ModuleScheduler&&)      = delete;
+
+    /**
+     * @brief Register a module. Call before start().
+     */
+    std::size_t addModule(std::string name, Handler handler, ModuleOptions options = {}) {
+        auto module     = std::make_unique<Module>();
+        module->name    = std::move(name);
+        module->handler = std::move(handler);
+        module->options = options;
+        module->queue =
+            std::make_unique<RingBuffer<Envelope>>(std::max<std::size_t>(options.queueCapacity, 1));
+        m_modules.push_back(std::move(module));
+        return m_modules.size() - 1;
+    }
+
+    /**
+     * @brief Start the scheduler thread.
+     */
+    void start() {
+        if (m_modules.empty() || m_running.exchange(true)) {
+            return;
+        }
+        m_thread = std::thread(&ModuleScheduler::loop, this);
+        std::lock_guard<std::mutex> lock(m_entryMutex);
+        m_accepting = true;
+    }
+
+    /**
+     * @brief Queue item for every module. Callable from any thread.
+     *
+     * Without a running scheduler the modules run inline on the caller. While
+     * flush() drains the queues, new items are rejected.
+     */
+    void dispatch(const Item& item) {
+        std::unique_lock<std::mutex> entry(m_entryMutex);
+        if (!m_accepting) {
+            entry.unlock();
+            if (m_running.load(std::memory_order_acquire)) {
+                for (auto& module : m_modules) {
+                    module->metrics.rejected.fetch_add(1, std::memory_order_relaxed);
+                }
+                return;
+            }
+            for (auto& module : m_modules) {
+                runGuarded(*module, item);
+            }
+            return;
+        }
+        const auto now = Clock::now();
+        for (auto& module : m_modules) {
+            // Only this (locked) producer pushes, so room seen here stays available
+            if (module->queue->size() >= module->queue->capacity()) {
+                module->metrics.rejected.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            m_pending.fetch_add(1);
+            module->queue->tryPush(Envelope{now, item});
+        }
+        entry.unlock();
+        {
+            std::lock_guard<std::mutex> lock(m_wakeMutex);
+            ++m_dispatches;
+        }
+        m_wakeUp.notify_one();
+    }
+
+    /**
+     * @brief Wait until the queues are empty, then stop - use as a Shutdown drain hook.
+     *
+     * Items dispatched afterwards run inline.
+     */
+    DrainResult flush(Clock::time_point deadline) {
+        DrainResult result;
+        if (!m_running.load()) {
+            return result;
+        }
+        const std::uint64_t processedBefore = getProcessedCount();
+        {
+            // Every item queued before this point is counted in m_pending
+            std::lock_guard<std::mutex> lock(m_entryMutex);
+            m_accepting = false;
+        }
+        while (m_pending.load() > 0 && Clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_wakeMutex);
+            m_running.store(false);
+        }
+        m_wakeUp.notify_all();
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+        result.drained = getProcessedCount() - processedBefore;
+        result.dropped = m_pending.load();
+        return result;
+    }
+
+    /**
+     * @brief Log per-module counters, latency and CPU time, and the critical wait bound.
+     */
+    void report() const {
+        static constexpr std::array<const char*, 3> CLASS_NAMES{"critical", "normal",
+                                                                 "background"};
+        std::chrono::microseconds longestLower{0};
+        for (const auto& module : m_modules) {
+            const auto& m = module->metrics;
+            velocitas::logger().info(
+                "🎚️  {}/{} ({}, budget {} us/{} ms): {} processed, {} rejected, {} throttled, "
+                "{} violations, {} preempted | latency p50 {} us p99 {} us | cpu p99 {} us max {} us",
+                m_name, module->name, CLASS_NAMES[static_cast<std::size_t>(module->options.priority)],
+                module->options.budget.count(), m_options.period.count(), m.processed.load(),
+                m.rejected.load(), m.throttled.load(), m.violations.load(), m.preempted.load(),
+                m.latency.getPercentile(0.5).count(), m.latency.getPercentile(0.99).count(),
+                m.cpu.getPercentile(0.99).count(), m.cpu.getMax().count());
+            if (module->options.priority != PriorityClass::Critical) {
+                longestLower = std::max(longestLower, m.cpu.getMax());
+            }
+        }
+        velocitas::logger().info("🎚️  {}: critical wait bound {} us (longest lower-priority item)",
+                                 m_name, longestLower.count());
+    }
+
+    [[nodiscard]] std::size_t getModuleCount() const { return m_modules.size(); }
+
+    [[nodiscard]] const std::string& getModuleName(std::size_t module) const {
+        return m_modules[module]->name;
+    }
+    [[nodiscard]] const ModuleMetrics& getMetrics(std::size_t module) const {
+        return m_modules[module]->metrics;
+    }
+
+private:
+    static constexpr std::size_t CLASS_COUNT = 3;
+
+    struct Envelope {
+        Clock::time_point enqueued;
+        Item              item;
+    };
+
+    struct Module {
+        std::string                           name;
+        Handler                               handler;
+        ModuleOptions                         options;
+        std::unique_ptr<RingBuffer<Envelope>> queue;
+        ModuleMetrics                         metrics;
+        // Owned by the scheduler thread
+        std::chrono::nanoseconds used{0};
+        bool                     violated{false};
+    };
+
+    static std::chrono::nanoseconds threadCpuTime() {
+        timespec now{};
+        ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+        return std::chrono::seconds(now.tv_sec) + std::chrono::nanoseconds(now.tv_nsec);
+    }
+
+    void runGuarded(Module& module, const Item& item) {
+        try {
+            module.handler(item);
+        } catch (const std::exception& e) {
+            velocitas::logger().error("❌ Module {}/{} failed: {}", m_name, module.name, e.what());
+        }
+    }
+
+    [[nodiscard]] bool hasBudget(const Module& module) const {
+        return module.options.budget.count() == 0 ||
+               module.options.priority == PriorityClass::Critical ||
+               module.used < module.options.budget;
+    }
+
+    [[nodiscard]] bool higherClassWaiting(PriorityClass priority) const {
+        for (const auto& module : m_modules) {
+            if (module->options.priority < priority && !module->queue->empty() &&
+                hasBudget(*module)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Highest class first, round robin within the class; nullptr if nothing can run
+    Module* pick() {
+        for (std::size_t c = 0; c < CLASS_COUNT; ++c) {
+            const std::size_t count = m_modules.size();
+            for (std::size_t offset = 0; offset < count; ++offset) {
+                const std::size_t index  = (m_cursor[c] + offset) % count;
+                Module&           module = *m_modules[index];
+                if (static_cast<std::size_t>(module.options.priority) == c &&
+                    !module.queue->empty() && hasBudget(module)) {
+                    m_cursor[c] = index + 1;
+                    return &module;
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    void runBatch(Module& module) {
+        const bool throttles =
+            module.options.budget.count() > 0 && module.options.priority != PriorityClass::Critical;
+        Envelope envelope;
+        for (std::size_t i = 0; i < m_options.batchSize && module.queue->tryPop(envelope); ++i) {
+            const auto cpuBegin = threadCpuTime();
+            runGuarded(module, envelope.item);
+            const auto cost = threadCpuTime() - cpuBegin;
+            module.metrics.cpu.record(cost);
+            module.metrics.latency.record(Clock::now() - envelope.enqueued);
+            module.metrics.processed.fetch_add(1, std::memory_order_relaxed);
+            m_pending.fetch_sub(1);
+
+            module.used += cost;
+            if (module.options.budget.count() > 0 && module.used > module.options.budget &&
+                !module.violated) {
+                module.violated = true;
+                module.metrics.violations.fetch_add(1, std::memory_order_relaxed);
+            }
+            if (throttles && module.used >= module.options.budget) {
+                if (!module.queue->empty()) {
+                    module.metrics.throttled.fetch_add(1, std::memory_order_relaxed);
+                }
+                return;
+            }
+            if (higherClassWaiting(module.options.priority)) {
+                module.metrics.preempted.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        }
+    }
+
+    void loop() {
+        applyToThisThread(LaunchOptions::current().processing, "modules");
+
+        auto periodStart = Clock::now();
+        while (m_running.load(std::memory_order_acquire)) {
+            const auto now = Clock::now();
+            if (now - periodStart >= m_options.period) {
+                for (auto& module : m_modules) {
+                    module->used     = std::chrono::nanoseconds{0};
+                    module->violated = false;
+                }
+                periodStart = now;
+            }
+
+            std::uint64_t seen = 0;
+            {
+                std::lock_guard<std::mutex> lock(m_wakeMutex);
+                seen = m_dispatches;
+            }
+            if (Module* module = pick()) {
+                runBatch(*module);
+                continue;
+            }
+
+            // Nothing runnable: wait for new items, or for the next period if
+            // throttled modules still hold queued items
+            std::unique_lock<std::mutex> lock(m_wakeMutex);
+            const auto ready = [&] { return m_dispatches != seen || !m_running.load(); };
+            if (m_pending.load() > 0) {
+                m_wakeUp.wait_until(lock, periodStart + m_options.period, ready);
+            } else {
+                m_wakeUp.wait(lock, ready);
+            }
+        }
+    }
+
+    [[nodiscard]] std::uint64_t getProcessedCount() const {
+        std::uint64_t processed = 0;
+        for (const auto& module : m_modules) {
+            processed += module->metrics.processed.load(std::memory_order_relaxed);
+        }
+        return processed;
+    }
+
+    std::string                          m_name;
+    Options                              m_options;
+    std::vector<std::unique_ptr<Module>> m_modules;
+    std::array<std::size_t, CLASS_COUNT> m_cursor{};
+    std::mutex                           m_entryMutex;
+    bool                                 m_accepting{false}; // guarded by m_entryMutex
+    std::mutex                           m_wakeMutex;
+    std::condition_variable              m_wakeUp;
+    std::uint64_t                        m_dispatches{0}; // guarded by m_wakeMutex
+    std::atomic<bool>                    m_running{false};
+    std::atomic<std::size_t>             m_pending{0};
+    std::thread                          m_thread;
+};
+
+} // namespace runtime
+
+#endif // VEHICLE_APP_RUNTIME_MODULESCHEDULER_H
@@ -0,0 +1,426 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef VEHICLE_APP_RUNTIME_PIPELINE_H
+#define VEHICLE_APP_RUNTIME_PIPELINE_H
+
+#include "runtime/Histogram.h"
+#include "runtime/LaunchOptions.h"
+#include "runtime/RingBuffer.h"
+#include "runtime/ScratchArena.h"
+#include "runtime/Shutdown.h"
+#include "sdk/Logger.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace runtime {
+
+/**
+ * @brief What a full stage queue does to a new item.
+ */
+enum class Backpressure : std::uint8_t {
+    Block,     // the producer waits for room - nothing is lost, upstream slows down
+    DropNewest // the item is dropped and counted - upstream never waits
+};
+
+/**
+ * @brief Per-stage tuning.
+ *
+ * Environment overrides, with NAME the upper-cased stage name:
+ *   APP_STAGE_<NAME>_THREADS=2            parallel workers of the stage
+ *   APP_STAGE_<NAME>_BATCH=32             items a worker takes per wake-up
+ *   APP_STAGE_<NAME>_QUEUE=1024           input queue capacity per producer
+ *   APP_STAGE_<NAME>_BACKPRESSURE=drop    block (default) or drop
+ */
+struct StageOptions {
+    std::size_t  parallelism{1};
+    std::size_t  batchSize{16};
+    std::size_t  queueCapacity{1024};
+    Backpressure backpressure{Backpressure::Block};
+
+    StageOptions withEnvironment(const std::string& stageName) const {
+        std::string prefix = "APP_STAGE_";
+        for (const char c : stageName) {
+            prefix += static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+        }
+        StageOptions options = *this;
+        readCount((prefix + "_THREADS").c_str(), options.parallelism);
+        readCount((prefix + "_BATCH").c_str(), options.batchSize);
+        readCount((prefix + "_QUEUE").c_str(), options.queueCapacity);
+        if (const char* policy = std::getenv((prefix + "_BACKPRESSURE").c_str())) {
+            options.backpressure =
+                std::strcmp(policy, "drop") == 0 ? Backpressure::DropNewest : Backpressure::Block;
+        }
+        return options;
+    }
+
+private:
+    static void readCount(const char* name, std::size_t& value) {
+        if (const char* text = std::getenv(name)) {
+            const long count = std::atol(text);
+            if (count > 0) {
+                value = static_cast<std::size_t>(count);
+            }
+        }
+    }
+};
+
+/**
+ * @brief Counters and latencies of one stage; readable from any thread.
+ */
+struct StageMetrics {
+    std::atomic<std::uint64_t> processed{0};
+    std::atomic<std::uint64_t> filtered{0}; // the stage returned false
+    std::atomic<std::uint64_t> rejected{0}; // dropped at the full input queue
+    std::atomic<std::uint64_t> blocked{0};  // pushes that had to wait for room
+    std::atomic<std::size_t>   maxQueueDepth{0};
+    LatencyHistogram           queueWait; // enqueue to start of processing
+    LatencyHistogram           service;   // time spent in the stage function
+};
+
+/**
+ * @brief Chain of processing stages connected by bounded lock-free queues.
+ *
+ * Items enter with push(key, item) and flow through the stages in the order they
+ * were added. Each stage runs on Options::parallelism worker threads; an item is
+ * routed to worker key % parallelism of every stage, so items with the same key
+ * keep their order end to end and a stage may keep per-key state without locks.
+ *
+ * Every worker has one single-producer/single-consumer RingBuffer per upstream
+ * worker, so no queue between stages takes a lock; only the entry queue of the
+ * first stage is shared by the subscription callback threads and guarded by a
+ * mutex. A worker takes up to batchSize items per wake-up and processes them
+ * inside one ScratchScope. A stage function returns false to drop an item.
+ *
+ * Per stage, metrics record queue wait and service time, so the stage with the
+ * growing queue wait is the bottleneck. Workers use the "processing" launch
+ * options. Item must be default-constructible and movable.
+ */
+template <typename Item>
+class Pipeline {
+public:
+    using Clock   = std::chrono::steady_clock;
+    using StageFn = std::function<bool(Item& item)>;
+
+    explicit Pipeline(std::string name)
+        : m_name(std::move(name)) {}
+
+    ~Pipeline() { flush(Clock::now()); }
+
+    Pipeline(const Pipeline&)            = delete;
+    Pipeline& operator=(const Pipeline&) = delete;
+    Pipeline(Pipeline&&)                 = delete;
+    Pipeline& operator=(Pipeline&&)      = delete;
+
+    /**
+     * @brief Append a stage. Call before start().
+     */
+    Pipeline& addStage(std::string name, StageFn function, StageOptions options = {}) {
+        options.parallelism   = std::max<std::size_t>(options.parallelism, 1);
+        options.batchSize     = std::max<std::size_t>(options.batchSize, 1);
+        options.queueCapacity = std::max<std::size_t>(options.queueCapacity, 1);
+
+        auto stage      = std::make_unique<Stage>();
+        stage->name     = std::move(name);
+        stage->function = std::move(function);
+        stage->options  = options;
+        m_stages.push_back(std::move(stage));
+        return *this;
+    }
+
+    /**
+     * @brief Allocate the queues and start the workers of every stage.
+     */
+    void start() {
+        if (m_running.load() || m_stages.empty()) {
+            return;
+        }
+        std::size_t producers = 1; // the entry point counts as one producer
+        for (auto& stage : m_stages) {
+            for (std::size_t w = 0; w < stage->options.parallelism; ++w) {
+                auto worker = std::make_unique<Worker>();
+                for (std::size_t p = 0; p < producers; ++p) {
+                    worker->inputs.push_back(std::make_unique<RingBuffer<Envelope>>(
+                        stage->options.queueCapacity));
+                }
+                stage->workers.push_back(std::move(worker));
+            }
+            producers = stage->options.parallelism;
+        }
+        m_running.store(true);
+        m_accepting.store(true);
+        for (std::size_t s = 0; s < m_stages.size(); ++s) {
+            for (std::size_t w = 0; w < m_stages[s]->workers.size(); ++w) {
+                m_stages[s]->workers[w]->thread = std::thread(&Pipeline::loop, this, s, w);
+            }
+        }
+    }
+
+    /**
+     * @brief Feed an item into the first stage. Callable from any thread.
+     * @return false if the item was dropped by DropNewest backpressure or after flush()
+     */
+    bool push(std::size_t key, Item item) {
+        // Checked under the entry lock: flush() closes the entry under it too
+        std::lock_guard<std::timed_mutex> lock(m_entryMutex);
+        if (!m_accepting.load()) {
+            return false;
+        }
+        return forward(0, 0, key, std::move(item));
+    }
+
+    /**
+     * @brief Wait until every pushed item left the pipeline, then stop the workers -
+     * use as a Shutdown drain hook.
+     */
+    DrainResult flush(Clock::time_point deadline) {
+        DrainResult result;
+        if (!m_running.load()) {
+            return result;
+        }
+        const std::uint64_t completedBefore = m_completed.load();
+        // Close the entry. Once the lock is ours, a push that was admitted before has
+        // counted its item in m_inFlight, so the wait below covers it
+        m_accepting.store(false);
+        if (m_entryMutex.try_lock_until(deadline)) {
+            m_entryMutex.unlock();
+        }
+        while (m_inFlight.load() > 0 && Clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        m_running.store(false);
+        for (auto& stage : m_stages) {
+            for (auto& worker : stage->workers) {
+                wake(*worker);
+            }
+        }
+        for (auto& stage : m_stages) {
+            for (auto& worker : stage->workers) {
+                if (worker->thread.joinable()) {
+                    worker->thread.join();
+                }
+            }
+        }
+        // A push still blocked on a full queue gives up now that m_running is false;
+        // one that got its item in after the workers stopped counts as dropped
+        std::lock_guard<std::timed_mutex> lock(m_entryMutex);
+        result.drained = m_completed.load() - completedBefore;
+        result.dropped = m_inFlight.load();
+        return result;
+    }
+
+    /**
+     * @brief Log throughput, drops, queue depth and latency percentiles per stage.
+     */
+    void report() const {
+        for (const auto& stage : m_stages) {
+            const auto& m = stage->metrics;
+            velocitas::logger().info(
+                "🏭 {}/{} x{}: {} processed, {} filtered, {} rejected, {} blocked, max queue {} | "
+                "wait p50 {} us p99 {} us | service p50 {} us p99 {} us max {} us",
+                m_name, stage->name, stage->options.parallelism, m.processed.load(),
+                m.filtered.load(), m.rejected.load(), m.blocked.load(), m.maxQueueDepth.load(),
+                m.queueWait.getPercentile(0.5).count(), m.queueWait.getPercentile(0.99).count(),
+                m.service.getPercentile(0.5).count(), m.service.getPercentile(0.99).count(),
+                m.service.getMax().count());
+        }
+    }
+
+    [[nodiscard]] std::size_t getStageCount() const { return m_stages.size(); }
+
+    [[nodiscard]] const std::string& getStageName(std::size_t stage) const {
+        return m_stages[stage]->name;
+    }
+    [[nodiscard]] const StageMetrics& getMetrics(std::size_t stage) const {
+        return m_stages[stage]->metrics;
+    }
+
+private:
+    struct Envelope {
+        std::size_t       key{0};
+        Clock::time_point enqueued;
+        Item              item;
+    };
+
+    struct Worker {
+        std::vector<std::unique_ptr<RingBuffer<Envelope>>> inputs; // one per upstream producer
+        std::atomic<bool>                                  sleeping{false};
+        std::mutex                                         wakeMutex;
+        std::condition_variable                            wakeUp;
+        std::thread                                        thread;
+    };
+
+    struct Stage {
+        std::string                          name;
+        StageFn                              function;
+        StageOptions                         options;
+        std::vector<std::unique_ptr<Worker>> workers;
+        StageMetrics                         metrics;
+    };
+
+    bool forward(std::size_t stageIndex, std::size_t producer, std::size_t key, Item&& item) {
+        auto& stage  = *m_stages[stageIndex];
+        auto& target = *stage.workers[key % stage.workers.size()];
+        auto& queue  = *target.inputs[producer];
+
+        // Only this producer pushes to the queue, so room seen here stays available
+        if (queue.size() >= queue.capacity()) {
+            if (stage.options.backpressure == Backpressure::DropNewest) {
+                stage.metrics.rejected.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            stage.metrics.blocked.fetch_add(1, std::memory_order_relaxed);
+            while (queue.size() >= queue.capacity()) {
+                if (!m_running.load(std::memory_order_relaxed)) {
+                    stage.metrics.rejected.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+            }
+        }
+
+        if (stageIndex == 0) {
+            m_inFlight.fetch_add(1);
+        }
+        queue.tryPush(Envelope{key, Clock::now(), std::move(item)});
+        updateMax(stage.metrics.maxQueueDepth, queue.size());
+
+        // Pairs with the fence in loop(): either we see the worker asleep or it sees the item
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (target.sleeping.load(std::memory_order_relaxed)) {
+            wake(target);
+        }
+        return true;
+    }
+
+    void loop(std::size_t stageIndex, std::size_t workerIndex) {
+        applyToThisThread(LaunchOptions::current().processing, "pipeline");
+
+        auto&                 stage  = *m_stages[stageIndex];
+        auto&                 worker = *stage.workers[workerIndex];
+        const bool            last   = stageIndex + 1 == m_stages.size();
+        std::vector<Envelope> batch;
+        batch.reserve(stage.options.batchSize);
+        std::size_t nextInput = 0;
+
+        while (m_running.load(std::memory_order_acquire)) {
+            // Round-robin over the input queues so no upstream worker starves
+            for (std::size_t scanned = 0; scanned < worker.inputs.size() &&
+                                          batch.size() < stage.options.batchSize;
+                 ++scanned) {
+                auto&    queue = *worker.inputs[nextInput];
+                Envelope envelope;
+                while (batch.size() < stage.options.batchSize && queue.tryPop(envelope)) {
+                    batch.push_back(std::move(envelope));
+                }
+                nextInput = (nextInput + 1) % worker.inputs.size();
+            }
+
+            if (batch.empty()) {
+                worker.sleeping.store(true, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                {
+                    std::unique_lock<std::mutex> lock(worker.wakeMutex);
+                    worker.wakeUp.wait(lock, [&] { return hasInput(worker) || !m_running.load(); });
+                }
+                worker.sleeping.store(false, std::memory_order_relaxed);
+                continue;
+            }
+
+            ScratchScope scratch;
+            for (auto& envelope : batch) {
+                const auto begin = Clock::now();
+                stage.metrics.queueWait.record(begin - envelope.enqueued);
+                bool keep = false;
+                try {
+                    keep = stage.function(envelope.item);
+                } catch (const std::exception& e) {
+                    velocitas::logger().error("❌ Pipeline stage {}/{} failed: {}", m_name,
+                                              stage.name, e.what());
+                }
+                stage.metrics.service.record(Clock::now() - begin);
+                stage.metrics.processed.fetch_add(1, std::memory_order_relaxed);
+
+                if (!keep) {
+                    stage.metrics.filtered.fetch_add(1, std::memory_order_relaxed);
+                    leave(true);
+                } else if (last) {
+                    leave(true);
+                } else if (!forward(stageIndex + 1, workerIndex, envelope.key,
+                                    std::move(envelope.item))) {
+                    leave(false);
+                }
+            }
+            batch.clear();
+        }
+    }
+
+    static bool hasInput(const Worker& worker) {
+        for (const auto& queue : worker.inputs) {
+            if (!queue->empty()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static void wake(Worker& worker) {
+        { std::lock_guard<std::mutex> lock(worker.wakeMutex); }
+        worker.wakeUp.notify_one();
+    }
+
+    static void updateMax(std::atomic<std::size_t>& max, std::size_t value) {
+        auto current = max.load(std::memory_order_relaxed);
+        while (value > current &&
+               !max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+        }
+    }
+
+    void leave(bool completed) {
+        if (completed) {
+            m_completed.fetch_add(1, std::memory_order_relaxed);
+        }
+        m_inFlight.fetch_sub(1);
+    }
+
+    std::string                         m_name;
+    std::vector<std::unique_ptr<Stage>> m_stages;
+    std::timed_mutex                    m_entryMutex;
+    std::atomic<bool>                   m_accepting{false}; // push() admits items
+    std::atomic<bool>                   m_running{false};
+    std::atomic<std::size_t>            m_inFlight{0};
+    std::atomic<std::uint64_t>          m_completed{0};
+};
+
+} // namespace runtime
+
+#endif // VEHICLE_APP_RUNTIME_PIPELINE_H
@@ -0,0 +1,93 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Stable C ABI between the vehicle app and processing plugins.
+ *
+ * A plugin is a shared object exporting
+ *
+ *     const vapp_plugin* vapp_plugin_entry(void);
+ *
+ * The host only calls through this table and the plugin only calls back through
+ * vapp_host, so plugins may be built with any compiler and need none of the
+ * app's headers except this one. Never change existing fields: add new ones at
+ * the end and bump VAPP_PLUGIN_ABI_VERSION.
+ *
+ * Threading: the host never calls into one plugin instance concurrently.
+ */
+
+#ifndef VEHICLE_APP_RUNTIME_PLUGINABI_H
+#define VEHICLE_APP_RUNTIME_PLUGINABI_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define VAPP_PLUGIN_ABI_VERSION 1u
+#define VAPP_PLUGIN_ENTRY       "vapp_plugin_entry"
+
+enum vapp_log_level { VAPP_LOG_INFO = 0, VAPP_LOG_WARN = 1, VAPP_LOG_ERROR = 2 };
+
+/* One signal value; path and storage belong to the host and are valid during the call */
+typedef struct vapp_sample {
+    const char* path;
+    double      value;
+    int64_t     timestamp_ns;
+} vapp_sample;
+
+/* Services the host offers to a plugin */
+typedef struct vapp_host {
+    void* context;
+    void (*log)(void* context, int level, const char* message);
+    /* Write a value to the app's signal table; returns 0 on success */
+    int (*publish)(void* context, const char* path, double value);
+} vapp_host;
+
+typedef struct vapp_plugin {
+    uint32_t    abi_version; /* VAPP_PLUGIN_ABI_VERSION the plugin was built against */
+    const char* name;        /* stable across versions - identifies the plugin for hot swap */
+    const char* version;
+
+    /*
+     * Create an instance. On hot swap, state holds what the previous version's
+     * save_state wrote (state_size bytes); otherwise state is NULL. The plugin
+     * must accept or ignore state from older versions of itself.
+     */
+    void* (*create)(const vapp_host* host, const void* state, size_t state_size);
+    void (*destroy)(void* instance);
+
+    /* A batch of new signal values */
+    void (*on_reply)(void* instance, const vapp_sample* samples, size_t count);
+    /* Periodic tick, monotonic time */
+    void (*on_timer)(void* instance, int64_t now_ns);
+
+    /*
+     * Serialise the instance's state for the next version. Returns the number
+     * of bytes required; writes only if it fits into capacity. May be NULL.
+     */
+    size_t (*save_state)(void* instance, void* buffer, size_t capacity);
+} vapp_plugin;
+
+typedef const vapp_plugin* (*vapp_plugin_entry_fn)(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VEHICLE_APP_RUNTIME_PLUGINABI_H */
@@ -0,0 +1,375 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "runtime/PluginHost.h"
+
+#include "sdk/Logger.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <dlfcn.h>
+#include <system_error>
+#include <unistd.h>
+
+namespace runtime {
+
+namespace {
+
+std::atomic<std::uint64_t> copyCounter{0};
+
+std::chrono::milliseconds readMillis(const char* name, std::chrono::milliseconds fallback) {
+    if (const char* text = std::getenv(name)) {
+        const long ms = std::atol(text);
+        if (ms > 0) {
+            return std::chrono::milliseconds(ms);
+        }
+    }
+    return fallback;
+}
+
+std::int64_t monotonicNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               PluginHost::Clock::now().time_since_epoch())
+        .count();
+}
+
+bool isPluginFile(const std::filesystem::directory_entry& entry) {
+    const auto name = entry.path().filename().string();
+    return entry.is_regular_file() && entry.path().extension() == ".so" && name.front() != '.';
+}
+
+} // namespace
+
+PluginHost::Options PluginHost::Options::fromEnvironment() {
+    Options options;
+    if (const char* directory = std::getenv("APP_PLUGIN_DIR")) {
+        options.directory = directory;
+    }
+    options.timerPeriod = readMillis("APP_PLUGIN_TIMER_MS", options.timerPeriod);
+    options.reloadCheck = readMillis("APP_PLUGIN_RELOAD_MS", options.reloadCheck);
+    return options;
+}
+
+PluginHost::Library::~Library() {
+    if (handle != nullptr) {
+        ::dlclose(handle);
+    }
+}
+
+PluginHost::PluginHost(Options options)
+    : m_options(std::move(options)) {
+    m_host.context = this;
+    m_host.log     = &PluginHost::hostLog;
+    m_host.publish = &PluginHost::hostPublish;
+}
+
+PluginHost::~PluginHost() {
+    stop();
+}
+
+bool PluginHost::start(Publish publish) {
+    if (!isEnabled() || m_thread.joinable()) {
+        return false;
+    }
+    m_publish = std::move(publish);
+    scan();
+    m_thread = std::thread(&PluginHost::loop, this);
+    velocitas::logger().info("🧩 Plugins: {} loaded from {}", getPluginCount(),
+                             m_options.directory);
+    return true;
+}
+
+void PluginHost::stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_stopping = true;
+    }
+    m_wakeUp.notify_all();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+
+    std::unique_lock<std::shared_mutex> lock(m_pluginsMutex);
+    for (auto& plugin : m_plugins) {
+        std::lock_guard<std::mutex> pluginLock(plugin->mutex);
+        if (plugin->instance != nullptr) {
+            plugin->library->api->destroy(plugin->instance);
+            plugin->instance = nullptr;
+        }
+        plugin->library.reset();
+    }
+    m_plugins.clear();
+}
+
+void PluginHost::dispatch(const vapp_sample* samples, std::size_t count) {
+    std::shared_lock<std::shared_mutex> lock(m_pluginsMutex);
+    for (auto& plugin : m_plugins) {
+        std::lock_guard<std::mutex> pluginLock(plugin->mutex);
+        const vapp_plugin*          api = plugin->library->api;
+        if (api->on_reply != nullptr) {
+            api->on_reply(plugin->instance, samples, count);
+        }
+        ++plugin->batches;
+    }
+}
+
+bool PluginHost::reload(const std::filesystem::path& file) {
+    Plugin* plugin = find(file);
+    return plugin != nullptr ? swap(*plugin) : load(file);
+}
+
+void PluginHost::report() const {
+    std::shared_lock<std::shared_mutex> lock(m_pluginsMutex);
+    for (const auto& plugin : m_plugins) {
+        std::lock_guard<std::mutex> pluginLock(plugin->mutex);
+        velocitas::logger().info("🧩 Plugin {} {} ({}): {} batches, generation {}",
+                                 plugin->library->api->name, plugin->library->api->version,
+                                 plugin->file.filename().string(), plugin->batches,
+                                 plugin->generation);
+    }
+    velocitas::logger().info("🧩 Plugins: {} loads, {} hot swaps", m_loads.load(), getSwapCount());
+}
+
+std::size_t PluginHost::getPluginCount() const {
+    std::shared_lock<std::shared_mutex> lock(m_pluginsMutex);
+    return m_plugins.size();
+}
+
+std::unique_ptr<PluginHost::Library> PluginHost::open(const std::filesystem::path& file,
+                                                      std::string&                 error) {
+    // dlopen() returns the already loaded image for a known path, so every
+    // version is opened from its own private copy
+    const auto copy = std::filesystem::temp_directory_path() /
+                      ("vapp-plugin-" + std::to_string(::getpid()) + "-" +
+                       std::to_string(copyCounter.fetch_add(1)) + ".so");
+    std::error_code copyError;
+    std::filesystem::copy_file(file, copy, std::filesystem::copy_options::overwrite_existing,
+                               copyError);
+    if (copyError) {
+        error = copyError.message();
+        return nullptr;
+    }
+
+    auto library    = std::make_unique<Library>();
+    library->handle = ::dlopen(copy.c_str(), RTLD_NOW | RTLD_LOCAL);
+    std::filesystem::remove(copy, copyError); // stays mapped
+    if (library->handle == nullptr) {
+        error = ::dlerror();
+        return nullptr;
+    }
+    auto entry = reinterpret_cast<vapp_plugin_entry_fn>(::dlsym(library->handle, VAPP_PLUGIN_ENTRY));
+    if (entry == nullptr) {
+        error = "no " VAPP_PLUGIN_ENTRY " symbol";
+        return nullptr;
+    }
+    library->api = entry();
+    if (library->api == nullptr || library->api->abi_version == 0 ||
+        library->api->abi_version > VAPP_PLUGIN_ABI_VERSION) {
+        error = "incompatible plugin ABI";
+        return nullptr;
+    }
+    if (library->api->name == nullptr || library->api->create == nullptr ||
+        library->api->destroy == nullptr) {
+        error = "incomplete plugin table";
+        return nullptr;
+    }
+    return library;
+}
+
+bool PluginHost::load(const std::filesystem::path& file) {
+    std::string error;
+    auto        library = open(file, error);
+    if (library == nullptr) {
+        velocitas::logger().error("❌ Plugin {} not loaded: {}", file.string(), error);
+        return false;
+    }
+    void* instance = library->api->create(&m_host, nullptr, 0);
+    if (instance == nullptr) {
+        velocitas::logger().error("❌ Plugin {} not loaded: create() failed", file.string());
+        return false;
+    }
+
+    std::error_code timeError;
+    auto            plugin = std::make_unique<Plugin>();
+    plugin->file           = file;
+    plugin->modified       = std::filesystem::last_write_time(file, timeError);
+    plugin->instance = instance;
+    plugin->library  = std::move(library);
+    velocitas::logger().info("🧩 Plugin {} {} loaded", plugin->library->api->name,
+                             plugin->library->api->version);
+    {
+        std::unique_lock<std::shared_mutex> lock(m_pluginsMutex);
+        m_plugins.push_back(std::move(plugin));
+    }
+    m_loads.fetch_add(1);
+    return true;
+}
+
+bool PluginHost::swap(Plugin& plugin) {
+    {
+        // A rejected version is not retried until the file changes again
+        std::lock_guard<std::mutex> lock(plugin.mutex);
+        std::error_code             timeError;
+        plugin.modified = std::filesystem::last_write_time(plugin.file, timeError);
+    }
+    std::string error;
+    auto        next = open(plugin.file, error);
+    if (next == nullptr) {
+        velocitas::logger().error("❌ Plugin {} not swapped: {}", plugin.file.string(), error);
+        return false;
+    }
+
+    std::unique_ptr<Library> previous;
+    void*                    previousInstance = nullptr;
+    {
+        // Waits for the running batch; no call reaches the plugin until the switch is done
+        std::lock_guard<std::mutex> lock(plugin.mutex);
+        if (std::strcmp(next->api->name, plugin.library->api->name) != 0) {
+            velocitas::logger().error("❌ Plugin {} not swapped: new name {}",
+                                      plugin.library->api->name, next->api->name);
+            return false;
+        }
+
+        std::vector<unsigned char> state;
+        if (plugin.library->api->save_state != nullptr) {
+            state.resize(plugin.library->api->save_state(plugin.instance, nullptr, 0));
+            if (!state.empty()) {
+                state.resize(
+                    plugin.library->api->save_state(plugin.instance, state.data(), state.size()));
+            }
+        }
+        void* instance = next->api->create(&m_host, state.empty() ? nullptr : state.data(),
+                                           state.size());
+        if (instance == nullptr) {
+            velocitas::logger().error("❌ Plugin {} not swapped: create() failed",
+                                      plugin.library->api->name);
+            return false;
+        }
+
+        velocitas::logger().info("🧩 Plugin {} {} → {} ({} bytes of state handed over)",
+                                 plugin.library->api->name, plugin.library->api->version,
+                                 next->api->version, state.size());
+        previous         = std::move(plugin.library);
+        previousInstance = plugin.instance;
+        plugin.library   = std::move(next);
+        plugin.instance  = instance;
+        ++plugin.generation;
+    }
+    previous->api->destroy(previousInstance);
+    m_swaps.fetch_add(1);
+    return true;
+}
+
+PluginHost::Plugin* PluginHost::find(const std::filesystem::path& file) {
+    std::shared_lock<std::shared_mutex> lock(m_pluginsMutex);
+    for (auto& plugin : m_plugins) {
+        if (plugin->file == file) {
+            return plugin.get();
+        }
+    }
+    return nullptr;
+}
+
+void PluginHost::scan() {
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(m_options.directory, error)) {
+        if (!isPluginFile(entry)) {
+            continue;
+        }
+        Plugin* plugin = find(entry.path());
+        if (plugin == nullptr) {
+            // A file that failed to load is retried once it changes
+            const auto modified = entry.last_write_time(error);
+            const auto rejected = m_rejected.find(entry.path().string());
+            if (rejected != m_rejected.end() && rejected->second == modified) {
+                continue;
+            }
+            if (load(entry.path())) {
+                m_rejected.erase(entry.path().string());
+            } else {
+                m_rejected[entry.path().string()] = modified;
+            }
+            continue;
+        }
+        bool changed = false;
+        {
+            std::lock_guard<std::mutex> lock(plugin->mutex);
+            changed = entry.last_write_time(error) != plugin->modified;
+        }
+        if (changed) {
+            swap(*plugin);
+        }
+    }
+    if (error) {
+        velocitas::logger().warn("⚠️  Plugin directory {}: {}", m_options.directory,
+                                 error.message());
+    }
+}
+
+void PluginHost::tick() {
+    const std::int64_t                  now = monotonicNanos();
+    std::shared_lock<std::shared_mutex> lock(m_pluginsMutex);
+    for (auto& plugin : m_plugins) {
+        std::lock_guard<std::mutex> pluginLock(plugin->mutex);
+        if (plugin->library->api->on_timer != nullptr) {
+            plugin->library->api->on_timer(plugin->instance, now);
+        }
+    }
+}
+
+void PluginHost::loop() {
+    auto nextTimer  = Clock::now() + m_options.timerPeriod;
+    auto nextReload = Clock::now() + m_options.reloadCheck;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_wakeMutex);
+            if (m_wakeUp.wait_until(lock, std::min(nextTimer, nextReload),
+                                    [this] { return m_stopping; })) {
+                return;
+            }
+        }
+        const auto now = Clock::now();
+        if (now >= nextTimer) {
+            tick();
+            nextTimer += m_options.timerPeriod;
+        }
+        if (now >= nextReload) {
+            scan();
+            nextReload = now + m_options.reloadCheck;
+        }
+    }
+}
+
+void PluginHost::hostLog(void* /*context*/, int level, const char* message) {
+    switch (level) {
+    case VAPP_LOG_ERROR:
+        velocitas::logger().error("🧩 {}", message);
+        break;
+    case VAPP_LOG_WARN:
+        velocitas::logger().warn("🧩 {}", message);
+        break;
+    default:
+        velocitas::logger().info("🧩 {}", message);
+        break;
+    }
+}
+
+int PluginHost::hostPublish(void* context, const char* path, double value) {
+    auto& host = *static_cast<PluginHost*>(context);
+    return host.m_publish && host.m_publish(path, value) ? 0 : -1;
+}
+
+} // namespace runtime
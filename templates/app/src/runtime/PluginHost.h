@@ -0,0 +1,165 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef VEHICLE_APP_RUNTIME_PLUGINHOST_H
+#define VEHICLE_APP_RUNTIME_PLUGINHOST_H
+
+#include "runtime/PluginAbi.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace runtime {
+
+/**
+ * @brief Loads processing plugins (runtime/PluginAbi.h) from shared objects and
+ * swaps them without a restart.
+ *
+ * Every *.so in Options::directory is loaded at start(). A watcher thread calls
+ * on_timer every Options::timerPeriod and rescans the directory every
+ * Options::reloadCheck: new files are loaded, and a file whose modification
+ * time changed is hot-swapped:
+ *
+ *  1. the new version is loaded next to the old one (a private copy of the file
+ *     is opened, so dlopen never returns the cached old image)
+ *  2. the plugin is quiesced at a batch boundary - its lock is held by every
+ *     on_reply/on_timer call, so the swap waits for the running batch
+ *  3. the old instance's save_state output is passed to the new create()
+ *  4. the function table and instance are switched under that lock, then the
+ *     old instance is destroyed and its library closed
+ *
+ * A version that fails to load, has another name or an incompatible ABI, or
+ * whose create() returns NULL is rejected and the old one keeps running.
+ * Deploy with an atomic rename (cp rule.so dir/.rule.tmp && mv dir/.rule.tmp
+ * dir/rule.so) so the watcher never sees a half-written file. Plugins run in
+ * the app's process: a crashing plugin crashes the app.
+ *
+ * Environment:
+ *   APP_PLUGIN_DIR=/opt/app/plugins   directory to load plugins from (unset = off)
+ *   APP_PLUGIN_TIMER_MS=1000          on_timer period
+ *   APP_PLUGIN_RELOAD_MS=1000         how often the directory is checked
+ */
+class PluginHost {
+public:
+    using Clock   = std::chrono::steady_clock;
+    using Publish = std::function<bool(std::string_view path, double value)>;
+
+    struct Options {
+        std::string               directory;
+        std::chrono::milliseconds timerPeriod{1000};
+        std::chrono::milliseconds reloadCheck{1000};
+
+        static Options fromEnvironment();
+    };
+
+    explicit PluginHost(Options options);
+    ~PluginHost();
+
+    PluginHost(const PluginHost&)            = delete;
+    PluginHost& operator=(const PluginHost&) = delete;
+    PluginHost(PluginHost&&)                 = delete;
+    PluginHost& operator=(PluginHost&&)      = delete;
+
+    /**
+     * @brief Load the plugins and start the watcher. Returns false if disabled.
+     * @param publish target of the plugins' vapp_host::publish calls
+     */
+    bool start(Publish publish);
+
+    /**
+     * @brief Stop the watcher and unload every plugin.
+     */
+    void stop();
+
+    /**
+     * @brief Hand one batch of samples to every plugin's on_reply. Callable from any thread.
+     */
+    void dispatch(const vapp_sample* samples, std::size_t count);
+
+    /**
+     * @brief Load a new version of the plugin in file now, without waiting for the watcher.
+     */
+    bool reload(const std::filesystem::path& file);
+
+    /**
+     * @brief Log the loaded plugins with their versions, batch and swap counts.
+     */
+    void report() const;
+
+    [[nodiscard]] bool          isEnabled() const { return !m_options.directory.empty(); }
+    [[nodiscard]] std::size_t   getPluginCount() const;
+    [[nodiscard]] std::uint64_t getSwapCount() const {
+        return m_swaps.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Library {
+        void*              handle{nullptr};
+        const vapp_plugin* api{nullptr};
+        ~Library();
+    };
+
+    struct Plugin {
+        std::filesystem::path           file;
+        std::filesystem::file_time_type modified;
+        std::mutex                      mutex; // held during every call into the instance
+        std::unique_ptr<Library>        library;
+        void*                           instance{nullptr};
+        std::uint64_t                   batches{0};
+        std::uint64_t                   generation{0};
+    };
+
+    std::unique_ptr<Library> open(const std::filesystem::path& file, std::string& error);
+    bool                     load(const std::filesystem::path& file);
+    bool                     swap(Plugin& plugin);
+    Plugin*                  find(const std::filesystem::path& file);
+    void                     scan();
+    void                     tick();
+    void                     loop();
+
+    static void hostLog(void* context, int level, const char* message);
+    static int  hostPublish(void* context, const char* path, double value);
+
+    Options                                                m_options;
+    Publish                                                m_publish;
+    vapp_host                                              m_host{};
+    mutable std::shared_mutex                              m_pluginsMutex; // dispatch() shares it
+    std::vector<std::unique_ptr<Plugin>>                   m_plugins;
+    std::map<std::string, std::filesystem::file_time_type> m_rejected; // watcher thread only
+    std::atomic<std::uint64_t>                             m_swaps{0};
+    std::atomic<std::uint64_t>                             m_loads{0};
+    std::mutex                                             m_wakeMutex;
+    std::condition_variable                                m_wakeUp;
+    bool                                                   m_stopping{false};
+    std::thread                                            m_thread;
+};
+
+} // namespace runtime
+
+#endif // VEHICLE_APP_RUNTIME_PLUGINHOST_H
@@ -0,0 +1,82 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef VEHICLE_APP_RUNTIME_QUERYPROTOCOL_H
+#define VEHICLE_APP_RUNTIME_QUERYPROTOCOL_H
+
+// Wire format of the local query socket (APP_QUERY_SOCKET). SDK-free so that
+// on-box tools can include it directly. All integers are in host byte order -
+// client and server always run on the same machine.
+//
+// Every message is a frame:  u32 payloadLength | u8 type | payload
+//
+//   Request       Payload                                   Reply
+//   LIST          -                                         LIST_REPLY
+//   READ          u32 n, n x u32 index                      VALUES (all n)
+//   SUBSCRIBE     u32 intervalMs, u32 n, n x u32 index      VALUES (all n), then
+//                                                           VALUES (changed only)
+//                                                           at most every intervalMs
+//   UNSUBSCRIBE   -                                         -
+//
+//   LIST_REPLY    u32 n, n x (u32 index, u32 length, path bytes)
+//   VALUES        u32 n, n x QueryValue
+//   ERROR         u32 QueryError
+//
+// Indices are signal table slots; resolve paths to indices once with LIST.
+// Subscriptions are coalesced on the server: a slot that changed several times
+// within one interval is sent once, with its latest value.
+
+#include <cstddef>
+#include <cstdint>
+
+namespace runtime {
+
+constexpr std::uint32_t QUERY_MAX_PAYLOAD = 64 * 1024; // largest accepted request
+constexpr std::uint32_t QUERY_MAX_VALUES  = 1024;      // indices per READ / SUBSCRIBE
+constexpr std::size_t   QUERY_HEADER_SIZE = sizeof(std::uint32_t) + sizeof(std::uint8_t);
+
+enum class QueryType : std::uint8_t {
+    List        = 0x01,
+    Read        = 0x02,
+    Subscribe   = 0x03,
+    Unsubscribe = 0x04,
+    ListReply   = 0x81,
+    Values      = 0x82,
+    Error       = 0xFF,
+};
+
+enum class QueryError : std::uint32_t {
+    Malformed     = 1,
+    UnknownType   = 2,
+    TooManyValues = 3,
+};
+
+/**
+ * @brief One signal value on the wire. Fixed 32-byte layout, no padding.
+ */
+struct QueryValue {
+    std::uint32_t index;
+    std::uint32_t valid; // 0 if the slot does not exist or was never written
+    double        value;
+    std::int64_t  timestampNs;
+    std::uint64_t updateCount;
+};
+
+static_assert(sizeof(QueryValue) == 32, "QueryValue is part of the wire format");
+
+} // namespace runtime
+
+#endif // VEHICLE_APP_RUNTIME_QUERYPROTOCOL_H
@@ -0,0 +1,445 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "runtime/QueryServer.h"
+
+#include "runtime/ScratchArena.h"
+
+#include "sdk/Logger.h"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace runtime {
+
+namespace {
+
+std::uint32_t loadU32(const std::uint8_t* data) {
+    std::uint32_t value = 0;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+void appendBytes(std::vector<std::uint8_t>& buffer, const void* data, std::size_t size) {
+    const auto* bytes = static_cast<const std::uint8_t*>(data);
+    buffer.insert(buffer.end(), bytes, bytes + size);
+}
+
+template <typename T>
+void appendValue(std::vector<std::uint8_t>& buffer, const T& value) {
+    appendBytes(buffer, &value, sizeof(T));
+}
+
+/**
+ * @brief Parses "u32 n, n x u32 index" starting at data; false if malformed.
+ */
+bool parseIndices(const std::uint8_t* data, std::uint32_t length,
+                  ScratchVector<std::uint32_t>& indices) {
+    if (length < sizeof(std::uint32_t)) {
+        return false;
+    }
+    const auto count = loadU32(data);
+    if (length != sizeof(std::uint32_t) * (1 + static_cast<std::size_t>(count))) {
+        return false;
+    }
+    indices.resize(count);
+    std::memcpy(indices.data(), data + sizeof(std::uint32_t), count * sizeof(std::uint32_t));
+    return true;
+}
+
+} // namespace
+
+QueryServer::Options QueryServer::Options::fromEnvironment() {
+    Options options;
+    if (const char* path = std::getenv("APP_QUERY_SOCKET")) {
+        options.socketPath = path;
+    }
+    return options;
+}
+
+QueryServer::QueryServer(const SignalTable& table, Options options)
+    : m_table(table)
+    , m_options(std::move(options)) {}
+
+QueryServer::~QueryServer() {
+    stop();
+}
+
+bool QueryServer::start() {
+    if (!isEnabled() || isRunning()) {
+        return isRunning();
+    }
+
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (m_options.socketPath.size() >= sizeof(address.sun_path)) {
+        velocitas::logger().error("❌ Query socket path too long: {}", m_options.socketPath);
+        return false;
+    }
+    std::memcpy(address.sun_path, m_options.socketPath.data(), m_options.socketPath.size());
+    const bool abstract = m_options.socketPath.front() == '@';
+    if (abstract) {
+        address.sun_path[0] = '\0';
+    } else {
+        ::unlink(m_options.socketPath.c_str());
+    }
+    const auto addressLength =
+        static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + m_options.socketPath.size());
+
+    m_listenFd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (m_listenFd < 0 ||
+        ::bind(m_listenFd, reinterpret_cast<sockaddr*>(&address), addressLength) != 0 ||
+        ::listen(m_listenFd, static_cast<int>(m_options.maxClients)) != 0) {
+        velocitas::logger().error("❌ Query socket {} unavailable: {}", m_options.socketPath,
+                                  std::strerror(errno));
+        if (m_listenFd >= 0) {
+            ::close(m_listenFd);
+            m_listenFd = -1;
+        }
+        return false;
+    }
+
+    m_epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+    m_wakeFd  = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    epoll_event event{};
+    event.events  = EPOLLIN;
+    event.data.fd = m_listenFd;
+    ::epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_listenFd, &event);
+    event.data.fd = m_wakeFd;
+    ::epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_wakeFd, &event);
+
+    m_thread = std::thread(&QueryServer::loop, this);
+    velocitas::logger().info("🔌 Query API listening on {}", m_options.socketPath);
+    return true;
+}
+
+void QueryServer::stop() {
+    if (!isRunning()) {
+        return;
+    }
+    const std::uint64_t one = 1;
+    (void)::write(m_wakeFd, &one, sizeof(one));
+    m_thread.join();
+
+    while (!m_clients.empty()) {
+        closeClient(m_clients.begin()->first);
+    }
+    ::close(m_listenFd);
+    ::close(m_epollFd);
+    ::close(m_wakeFd);
+    m_listenFd = m_epollFd = m_wakeFd = -1;
+    if (m_options.socketPath.front() != '@') {
+        ::unlink(m_options.socketPath.c_str());
+    }
+}
+
+void QueryServer::loop() {
+    std::array<epoll_event, 32> events{};
+    for (;;) {
+        const int ready = ::epoll_wait(m_epollFd, events.data(), static_cast<int>(events.size()),
+                                       millisUntilNextPush(Clock::now()));
+        if (ready < 0 && errno != EINTR) {
+            velocitas::logger().error("❌ Query API epoll failed: {}", std::strerror(errno));
+            return;
+        }
+
+        // Request parsing and reply assembly of this pass use the thread's arena
+        ScratchScope scratch;
+        for (int i = 0; i < ready; ++i) {
+            const int fd = events[i].data.fd;
+            if (fd == m_wakeFd) {
+                return;
+            }
+            if (fd == m_listenFd) {
+                acceptClients();
+                continue;
+            }
+            auto found = m_clients.find(fd);
+            if (found == m_clients.end()) {
+                continue;
+            }
+            auto& client = found->second;
+            // Read before honouring a hang-up so a final request is still answered.
+            const bool readable = (events[i].events & EPOLLIN) != 0;
+            bool       keep     = readable || (events[i].events & (EPOLLERR | EPOLLHUP)) == 0;
+            if (readable) {
+                keep = readFrom(client);
+            }
+            if (keep) {
+                keep = flush(client);
+            }
+            if (!keep) {
+                closeClient(fd);
+            }
+        }
+
+        pushSubscriptions(Clock::now());
+    }
+}
+
+void QueryServer::acceptClients() {
+    for (;;) {
+        const int fd = ::accept4(m_listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            return;
+        }
+        if (m_clients.size() >= m_options.maxClients) {
+            ::close(fd);
+            continue;
+        }
+        epoll_event event{};
+        event.events  = EPOLLIN | EPOLLRDHUP;
+        event.data.fd = fd;
+        ::epoll_ctl(m_epollFd, EPOLL_CTL_ADD, fd, &event);
+        m_clients[fd].fd = fd;
+    }
+}
+
+bool QueryServer::readFrom(Client& client) {
+    std::array<std::uint8_t, 4096> chunk{};
+    bool                           peerOpen = true;
+    for (;;) {
+        const auto received = ::recv(client.fd, chunk.data(), chunk.size(), 0);
+        if (received == 0) {
+            peerOpen = false;
+            break;
+        }
+        if (received < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                return false;
+            }
+            break;
+        }
+        client.inbox.insert(client.inbox.end(), chunk.begin(), chunk.begin() + received);
+    }
+
+    std::size_t offset = 0;
+    while (client.inbox.size() - offset >= QUERY_HEADER_SIZE) {
+        const auto* frame  = client.inbox.data() + offset;
+        const auto  length = loadU32(frame);
+        if (length > QUERY_MAX_PAYLOAD) {
+            return false;
+        }
+        if (client.inbox.size() - offset < QUERY_HEADER_SIZE + length) {
+            break;
+        }
+        m_requests.fetch_add(1, std::memory_order_relaxed);
+        const auto type = static_cast<QueryType>(frame[sizeof(std::uint32_t)]);
+        if (!handleFrame(client, type, frame + QUERY_HEADER_SIZE, length)) {
+            return false;
+        }
+        offset += QUERY_HEADER_SIZE + length;
+    }
+    client.inbox.erase(client.inbox.begin(), client.inbox.begin() + offset);
+    if (!peerOpen) {
+        // Answer what arrived before the peer half-closed, best effort.
+        flush(client);
+    }
+    return peerOpen;
+}
+
+bool QueryServer::handleFrame(Client& client, QueryType type, const std::uint8_t* payload,
+                              std::uint32_t length) {
+    ScratchVector<std::uint32_t> indices(ScratchArena::forThisThread().resource());
+    switch (type) {
+    case QueryType::List:
+        appendList(client);
+        break;
+    case QueryType::Read:
+        if (!parseIndices(payload, length, indices)) {
+            appendError(client, QueryError::Malformed);
+        } else if (indices.size() > QUERY_MAX_VALUES) {
+            appendError(client, QueryError::TooManyValues);
+        } else {
+            appendValues(client, indices, nullptr, false);
+        }
+        break;
+    case QueryType::Subscribe: {
+        if (length < sizeof(std::uint32_t) ||
+            !parseIndices(payload + sizeof(std::uint32_t), length - sizeof(std::uint32_t),
+                          indices)) {
+            appendError(client, QueryError::Malformed);
+            break;
+        }
+        if (indices.size() > QUERY_MAX_VALUES) {
+            appendError(client, QueryError::TooManyValues);
+            break;
+        }
+        client.interval =
+            std::max(m_options.minInterval, std::chrono::milliseconds(loadU32(payload)));
+        client.subscribed.assign(indices.begin(), indices.end());
+        client.lastSent.assign(client.subscribed.size(), 0);
+        client.nextPush = Clock::now() + client.interval;
+        appendValues(client, client.subscribed, &client.lastSent, false);
+        break;
+    }
+    case QueryType::Unsubscribe:
+        client.interval = std::chrono::milliseconds(0);
+        client.subscribed.clear();
+        client.lastSent.clear();
+        break;
+    default:
+        appendError(client, QueryError::UnknownType);
+        break;
+    }
+    if (client.outbox.size() - client.outOffset > m_options.maxBacklogBytes) {
+        m_slowDisconnects.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+void QueryServer::pushSubscriptions(Clock::time_point now) {
+    ScratchVector<int> dropped(ScratchArena::forThisThread().resource());
+    for (auto& [fd, client] : m_clients) {
+        if (client.interval.count() == 0 || now < client.nextPush) {
+            continue;
+        }
+        client.nextPush = now + client.interval;
+        // Coalescing: while the client is still draining earlier data, skip this
+        // round; the next one sends the latest values instead of a queue of stale ones.
+        if (client.outOffset < client.outbox.size()) {
+            continue;
+        }
+        appendValues(client, client.subscribed, &client.lastSent, true);
+        if (!flush(client)) {
+            dropped.push_back(fd);
+        }
+    }
+    for (const int fd : dropped) {
+        closeClient(fd);
+    }
+}
+
+int QueryServer::millisUntilNextPush(Clock::time_point now) const {
+    int timeout = -1;
+    for (const auto& [fd, client] : m_clients) {
+        if (client.interval.count() == 0) {
+            continue;
+        }
+        const auto remaining =
+            std::chrono::duration_cast<std::chrono::milliseconds>(client.nextPush - now).count();
+        const int millis = static_cast<int>(std::max<std::int64_t>(0, remaining));
+        timeout          = timeout < 0 ? millis : std::min(timeout, millis);
+    }
+    return timeout;
+}
+
+void QueryServer::appendList(Client& client) {
+    const auto  count  = m_table.getCount();
+    std::size_t length = sizeof(std::uint32_t);
+    for (std::uint32_t i = 0; i < count; ++i) {
+        length += 2 * sizeof(std::uint32_t) + m_table.getPath(static_cast<int>(i)).size();
+    }
+    beginFrame(client, QueryType::ListReply, static_cast<std::uint32_t>(length));
+    appendValue(client.outbox, count);
+    for (std::uint32_t i = 0; i < count; ++i) {
+        const auto path = m_table.getPath(static_cast<int>(i));
+        appendValue(client.outbox, i);
+        appendValue(client.outbox, static_cast<std::uint32_t>(path.size()));
+        appendBytes(client.outbox, path.data(), path.size());
+    }
+}
+
+void QueryServer::appendValues(Client& client, std::span<const std::uint32_t> indices,
+                               std::vector<std::uint64_t>* lastSent, bool changedOnly) {
+    const auto count = m_table.getCount();
+    m_values.clear();
+    for (std::size_t i = 0; i < indices.size(); ++i) {
+        QueryValue   value{indices[i], 0, 0.0, 0, 0};
+        SignalSample sample;
+        if (indices[i] < count && m_table.read(static_cast<int>(indices[i]), sample)) {
+            value = {indices[i], 1, sample.value, sample.timestampNs, sample.updateCount};
+        }
+        if (lastSent != nullptr) {
+            if (changedOnly && value.updateCount == (*lastSent)[i]) {
+                continue;
+            }
+            (*lastSent)[i] = value.updateCount;
+        }
+        m_values.push_back(value);
+    }
+    if (changedOnly && m_values.empty()) {
+        return;
+    }
+
+    const auto valueCount = static_cast<std::uint32_t>(m_values.size());
+    beginFrame(client, QueryType::Values,
+               static_cast<std::uint32_t>(sizeof(std::uint32_t) + valueCount * sizeof(QueryValue)));
+    appendValue(client.outbox, valueCount);
+    appendBytes(client.outbox, m_values.data(), valueCount * sizeof(QueryValue));
+}
+
+void QueryServer::appendError(Client& client, QueryError error) {
+    beginFrame(client, QueryType::Error, sizeof(std::uint32_t));
+    appendValue(client.outbox, static_cast<std::uint32_t>(error));
+}
+
+void QueryServer::beginFrame(Client& client, QueryType type, std::uint32_t length) {
+    appendValue(client.outbox, length);
+    appendValue(client.outbox, static_cast<std::uint8_t>(type));
+}
+
+bool QueryServer::flush(Client& client) {
+    while (client.outOffset < client.outbox.size()) {
+        const auto sent = ::send(client.fd, client.outbox.data() + client.outOffset,
+                                 client.outbox.size() - client.outOffset, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                return false;
+            }
+            break;
+        }
+        client.outOffset += static_cast<std::size_t>(sent);
+    }
+
+    const bool pending = client.outOffset < client.outbox.size();
+    if (!pending) {
+        client.outbox.clear();
+        client.outOffset = 0;
+    }
+    if (pending != client.wantsWrite) {
+        epoll_event event{};
+        event.events  = EPOLLIN | EPOLLRDHUP | (pending ? EPOLLOUT : 0U);
+        event.data.fd = client.fd;
+        ::epoll_ctl(m_epollFd, EPOLL_CTL_MOD, client.fd, &event);
+        client.wantsWrite = pending;
+    }
+    return true;
+}
+
+void QueryServer::closeClient(int fd) {
+    ::epoll_ctl(m_epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+    m_clients.erase(fd);
+}
+
+} // namespace runtime
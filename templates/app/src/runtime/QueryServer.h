@@ -0,0 +1,136 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef VEHICLE_APP_RUNTIME_QUERYSERVER_H
+#define VEHICLE_APP_RUNTIME_QUERYSERVER_H
+
+#include "runtime/QueryProtocol.h"
+#include "runtime/SignalTable.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace runtime {
+
+/**
+ * @brief Local query API on a Unix domain socket.
+ *
+ * Serves the latest values of a SignalTable to on-box tools with the binary
+ * protocol from QueryProtocol.h: batched reads and coalesced streaming
+ * subscriptions. Runs one epoll loop on its own thread and only touches the
+ * table through its lock-free read path, so it never blocks signal ingest.
+ *
+ * Clients that fall behind do not queue up stale data: subscription updates
+ * are only produced while the client's send buffer is empty, and a client
+ * whose backlog exceeds maxBacklogBytes is disconnected.
+ *
+ * Environment:
+ *   APP_QUERY_SOCKET=/run/vapp/query.sock   enable the server ("@name" = abstract socket)
+ */
+class QueryServer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Options {
+        std::string               socketPath;                      // empty = disabled
+        std::size_t               maxClients{16};
+        std::size_t               maxBacklogBytes{256 * 1024};
+        std::chrono::milliseconds minInterval{std::chrono::milliseconds(5)};
+
+        static Options fromEnvironment();
+    };
+
+    QueryServer(const SignalTable& table, Options options);
+    ~QueryServer();
+
+    QueryServer(const QueryServer&)            = delete;
+    QueryServer& operator=(const QueryServer&) = delete;
+    QueryServer(QueryServer&&)                 = delete;
+    QueryServer& operator=(QueryServer&&)      = delete;
+
+    /**
+     * @brief Bind the socket and start the server thread.
+     * @return false if disabled or the socket could not be created
+     */
+    bool start();
+
+    /**
+     * @brief Close all clients, remove the socket and join the thread. Idempotent.
+     */
+    void stop();
+
+    [[nodiscard]] bool isEnabled() const { return !m_options.socketPath.empty(); }
+    [[nodiscard]] bool isRunning() const { return m_thread.joinable(); }
+
+    [[nodiscard]] std::uint64_t getRequestCount() const {
+        return m_requests.load(std::memory_order_relaxed);
+    }
+    [[nodiscard]] std::uint64_t getSlowClientDisconnects() const {
+        return m_slowDisconnects.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Client {
+        int                        fd{-1};
+        std::vector<std::uint8_t>  inbox;
+        std::vector<std::uint8_t>  outbox;
+        std::size_t                outOffset{0};
+        bool                       wantsWrite{false};
+        std::vector<std::uint32_t> subscribed;
+        std::vector<std::uint64_t> lastSent;    // updateCount per subscribed slot
+        std::chrono::milliseconds  interval{0}; // 0 = not subscribed
+        Clock::time_point          nextPush;
+    };
+
+    void loop();
+    void acceptClients();
+    bool readFrom(Client& client);
+    bool handleFrame(Client& client, QueryType type, const std::uint8_t* payload,
+                     std::uint32_t length);
+    void pushSubscriptions(Clock::time_point now);
+    int  millisUntilNextPush(Clock::time_point now) const;
+
+    void appendList(Client& client);
+    void appendValues(Client& client, std::span<const std::uint32_t> indices,
+                      std::vector<std::uint64_t>* lastSent, bool changedOnly);
+    void appendError(Client& client, QueryError error);
+    void beginFrame(Client& client, QueryType type, std::uint32_t length);
+
+    bool flush(Client& client);
+    void closeClient(int fd);
+
+    const SignalTable&              m_table;
+    Options                         m_options;
+    int                             m_listenFd{-1};
+    int                             m_epollFd{-1};
+    int                             m_wakeFd{-1};
+    std::thread                     m_thread;
+    std::unordered_map<int, Client> m_clients;
+    std::vector<QueryValue>         m_values; // reused per reply
+    std::atomic<std::uint64_t>      m_requests{0};
+    std::atomic<std::uint64_t>      m_slowDisconnects{0};
+};
+
+} // namespace runtime
+
+#endif // VEHICLE_APP_RUNTIME_QUERYSERVER_H
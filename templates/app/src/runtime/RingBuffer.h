@@ -0,0 +1,113 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef VEHICLE_APP_RUNTIME_RINGBUFFER_H
+#define VEHICLE_APP_RUNTIME_RINGBUFFER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace runtime {
+
+constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+/**
+ * @brief Bounded single-producer/single-consumer queue with preallocated storage.
+ *
+ * All slots are allocated in the constructor, so push/pop never touch the heap
+ * (as long as T's move assignment does not). This is the building block for the
+ * app's internal queues; size them at start-up and the processing path stays
+ * allocation free. The capacity is rounded up to a power of two.
+ */
+template <typename T>
+class RingBuffer {
+public:
+    explicit RingBuffer(std::size_t capacity)
+        : m_capacity(roundUpToPowerOfTwo(capacity))
+        , m_mask(m_capacity - 1)
+        , m_slots(std::make_unique<T[]>(m_capacity)) {}
+
+    RingBuffer(const RingBuffer&)            = delete;
+    RingBuffer& operator=(const RingBuffer&) = delete;
+    RingBuffer(RingBuffer&&)                 = delete;
+    RingBuffer& operator=(RingBuffer&&)      = delete;
+    ~RingBuffer()                            = default;
+
+    /**
+     * @brief Producer side. Returns false if the queue is full.
+     */
+    bool tryPush(T value) {
+        const auto tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_headCache >= m_capacity) {
+            m_headCache = m_head.load(std::memory_order_acquire);
+            if (tail - m_headCache >= m_capacity) {
+                return false;
+            }
+        }
+        m_slots[tail & m_mask] = std::move(value);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Consumer side. Returns false if the queue is empty.
+     */
+    bool tryPop(T& value) {
+        const auto head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tailCache) {
+            m_tailCache = m_tail.load(std::memory_order_acquire);
+            if (head == m_tailCache) {
+                return false;
+            }
+        }
+        value = std::move(m_slots[head & m_mask]);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    [[nodiscard]] std::size_t size() const {
+        return static_cast<std::size_t>(m_tail.load(std::memory_order_acquire) -
+                                        m_head.load(std::memory_order_acquire));
+    }
+
+    [[nodiscard]] bool        empty() const { return size() == 0; }
+    [[nodiscard]] std::size_t capacity() const { return m_capacity; }
+
+private:
+    static std::size_t roundUpToPowerOfTwo(std::size_t value) {
+        std::size_t result = 1;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    const std::size_t    m_capacity;
+    const std::size_t    m_mask;
+    std::unique_ptr<T[]> m_slots;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<std::uint64_t> m_head{0};
+    std::uint64_t m_tailCache{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<std::uint64_t> m_tail{0};
+    std::uint64_t m_headCache{0};
+};
+
+} // namespace runtime
+
+#endif // VEHICLE_APP_RUNTIME_RINGBUFFER_H
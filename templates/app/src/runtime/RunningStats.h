@@ -0,0 +1,84 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef VEHICLE_APP_RUNTIME_RUNNINGSTATS_H
+#define VEHICLE_APP_RUNTIME_RUNNINGSTATS_H
+
+#include "runtime/Checkpoint.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <utility>
+
+namespace runtime {
+
+/**
+ * @brief Count, mean, min and max of a signal - a minimal long-running aggregate.
+ *
+ * Checkpointable, so trip statistics survive restarts when registered with a
+ * CheckpointStore.
+ */
+class RunningStats : public Checkpointable {
+public:
+    explicit RunningStats(std::string name)
+        : m_name(std::move(name)) {}
+
+    void add(double value) {
+        ++m_count;
+        m_sum += value;
+        m_min = std::min(m_min, value);
+        m_max = std::max(m_max, value);
+    }
+
+    [[nodiscard]] std::uint64_t getCount() const { return m_count; }
+    [[nodiscard]] double        getMean() const { return m_count > 0 ? m_sum / m_count : 0.0; }
+    [[nodiscard]] double        getMin() const { return m_count > 0 ? m_min : 0.0; }
+    [[nodiscard]] double        getMax() const { return m_count > 0 ? m_max : 0.0; }
+
+    [[nodiscard]] std::string   getCheckpointName() const override { return m_name; }
+    [[nodiscard]] std::uint64_t getGeneration() const override { return m_count; }
+
+    void save(BinaryWriter& writer) const override {
+        writer.write(m_count);
+        writer.write(m_sum);
+        writer.write(m_min);
+        writer.write(m_max);
+    }
+
+    bool restore(BinaryReader& reader, std::uint32_t version) override {
+        if (version != 1) {
+            return false;
+        }
+        m_count = reader.read<std::uint64_t>();
+        m_sum   = reader.read<double>();
+        m_min   = reader.read<double>();
+        m_max   = reader.read<double>();
+        return true;
+    }
+
+private:
+    std::string   m_name;
+    std::uint64_t m_count{0};
+    double        m_sum{0.0};
+    double        m_min{std::numeric_limits<double>::max()};
+    double        m_max{std::numeric_limits<double>::lowest()};
+};
+
+} // namespace runtime
+
+#endif // VEHICLE_APP_RUNTIME_RUNNINGSTATS_H
@@ -0,0 +1,198 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef VEHICLE_APP_RUNTIME_SCRATCHARENA_H
+#define VEHICLE_APP_RUNTIME_SCRATCHARENA_H
+
+#include "runtime/LaunchOptions.h"
+#include "sdk/Logger.h"
+
+#include <fmt/format.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace runtime {
+
+/**
+ * @brief Memory resource that forwards to an upstream resource and counts calls.
+ */
+class CountingResource : public std::pmr::memory_resource {
+public:
+    explicit CountingResource(std::pmr::memory_resource* upstream)
+        : m_upstream(upstream) {}
+
+    [[nodiscard]] std::uint64_t getAllocationCount() const { return m_allocations; }
+    [[nodiscard]] std::uint64_t getAllocatedBytes() const { return m_bytes; }
+
+    void resetCounters() {
+        m_allocations = 0;
+        m_bytes       = 0;
+    }
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        ++m_allocations;
+        m_bytes += bytes;
+        return m_upstream->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override {
+        m_upstream->deallocate(ptr, bytes, alignment);
+    }
+
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    std::pmr::memory_resource* m_upstream;
+    std::uint64_t              m_allocations{0};
+    std::uint64_t              m_bytes{0};
+};
+
+/**
+ * @brief Per-thread monotonic arena for scratch memory used while processing one reply.
+ *
+ * Handler code allocates strings, vectors and formatting buffers from resource();
+ * reset() hands everything back at once after the reply has been processed. The
+ * backing buffer is allocated once, so in steady state no call reaches malloc.
+ * Requests that do not fit spill to the global heap and are counted as overflows;
+ * if that happens regularly, raise the capacity.
+ */
+class ScratchArena {
+public:
+    static constexpr std::size_t DEFAULT_CAPACITY = 64 * 1024;
+
+    explicit ScratchArena(std::size_t capacity = DEFAULT_CAPACITY)
+        : m_buffer(std::make_unique<std::byte[]>(capacity))
+        , m_capacity(capacity)
+        , m_overflow(std::pmr::new_delete_resource())
+        , m_monotonic(m_buffer.get(), m_capacity, &m_overflow)
+        , m_arena(&m_monotonic) {}
+
+    ScratchArena(const ScratchArena&)            = delete;
+    ScratchArena& operator=(const ScratchArena&) = delete;
+    ScratchArena(ScratchArena&&)                 = delete;
+    ScratchArena& operator=(ScratchArena&&)      = delete;
+    ~ScratchArena()                              = default;
+
+    /**
+     * @brief The arena of the calling thread. Each worker thread gets its own.
+     */
+    static ScratchArena& forThisThread() {
+        thread_local ScratchArena arena;
+        return arena;
+    }
+
+    [[nodiscard]] std::pmr::memory_resource* resource() { return &m_arena; }
+
+    /**
+     * @brief Touch the whole backing buffer so the first replies do not page-fault.
+     */
+    void prefault() { prefaultBuffer(m_buffer.get(), m_capacity); }
+
+    /**
+     * @brief Release everything allocated since the last reset.
+     */
+    void reset() {
+        m_monotonic.release();
+        m_arena.resetCounters();
+        m_overflow.resetCounters();
+    }
+
+    /**
+     * @brief Format into arena memory. The view stays valid until the next reset().
+     */
+    template <typename... Args>
+    std::string_view format(fmt::format_string<Args...> formatString, Args&&... args) {
+        fmt::memory_buffer buffer;
+        fmt::format_to(std::back_inserter(buffer), formatString, std::forward<Args>(args)...);
+        auto* dest = static_cast<char*>(m_arena.allocate(buffer.size(), alignof(char)));
+        std::memcpy(dest, buffer.data(), buffer.size());
+        return {dest, buffer.size()};
+    }
+
+    [[nodiscard]] std::size_t   getCapacity() const { return m_capacity; }
+    [[nodiscard]] std::uint64_t getAllocationCount() const { return m_arena.getAllocationCount(); }
+    [[nodiscard]] std::uint64_t getAllocatedBytes() const { return m_arena.getAllocatedBytes(); }
+    [[nodiscard]] std::uint64_t getOverflowCount() const { return m_overflow.getAllocationCount(); }
+
+private:
+    std::unique_ptr<std::byte[]>        m_buffer;
+    std::size_t                         m_capacity;
+    CountingResource                    m_overflow;
+    std::pmr::monotonic_buffer_resource m_monotonic;
+    CountingResource                    m_arena;
+};
+
+/**
+ * @brief RAII scope that resets the thread's arena when one reply (or batch) is done.
+ *
+ * Scopes may nest; only the outermost one resets. Debug builds log how many
+ * allocations the reply made and how many spilled to the heap.
+ */
+class ScratchScope {
+public:
+    explicit ScratchScope(ScratchArena& arena = ScratchArena::forThisThread())
+        : m_arena(arena) {
+        ++depth();
+    }
+
+    ScratchScope(const ScratchScope&)            = delete;
+    ScratchScope& operator=(const ScratchScope&) = delete;
+    ScratchScope(ScratchScope&&)                 = delete;
+    ScratchScope& operator=(ScratchScope&&)      = delete;
+
+    ~ScratchScope() {
+        if (--depth() != 0) {
+            return;
+        }
+#ifndef NDEBUG
+        if (m_arena.getAllocationCount() > 0) {
+            velocitas::logger().debug("🧮 Scratch arena: {} allocations ({} bytes), {} overflows",
+                                      m_arena.getAllocationCount(), m_arena.getAllocatedBytes(),
+                                      m_arena.getOverflowCount());
+        }
+#endif
+        m_arena.reset();
+    }
+
+    [[nodiscard]] std::pmr::memory_resource* resource() { return m_arena.resource(); }
+    [[nodiscard]] ScratchArena&              arena() { return m_arena; }
+
+private:
+    static int& depth() {
+        thread_local int value = 0;
+        return value;
+    }
+
+    ScratchArena& m_arena;
+};
+
+// Containers that allocate from a scratch arena, e.g. ScratchVector<double> v{scope.resource()};
+using ScratchString = std::pmr::string;
+template <typename T>
+using ScratchVector = std::pmr::vector<T>;
+
+} // namespace runtime
+
+#endif // VEHICLE_APP_RUNTIME_SCRATCHARENA_H
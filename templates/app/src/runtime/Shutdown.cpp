@@ -0,0 +1,308 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "runtime/Shutdown.h"
+
+#include "sdk/Logger.h"
+
+#include <array>
+#include <cerrno>
+#include <condition_variable>
+#include <csignal>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
+#include <unistd.h>
+
+namespace runtime {
+
+namespace {
+
+constexpr auto DEFAULT_DEADLINE = std::chrono::milliseconds(2000);
+
+struct NamedHook {
+    std::string         name;
+    Shutdown::DrainHook hook;
+};
+
+struct Progress {
+    std::mutex              mutex;
+    std::condition_variable done;
+    bool                    finished{false};
+    std::size_t             drained{0};
+    std::size_t             dropped{0};
+};
+
+struct State {
+    std::mutex                mutex;
+    std::function<void()>     stopFunction;
+    std::vector<NamedHook>    hooks;
+    std::thread               watcher;
+    std::thread               sequence;
+    std::thread               overdueDrainer; // still running hooks past the deadline
+    std::shared_ptr<Progress> overdueProgress;
+    int                    signalFd{-1};
+    int                    wakeFd{-1};
+    std::atomic_bool       requested{false};
+    std::atomic_bool       shuttingDown{false};
+    std::atomic_bool       exiting{false};
+};
+
+State& state() {
+    static State instance;
+    return instance;
+}
+
+std::chrono::milliseconds deadlineFromEnvironment() {
+    if (const char* value = std::getenv("APP_SHUTDOWN_DEADLINE_MS")) {
+        const long millis = std::atol(value);
+        if (millis > 0) {
+            return std::chrono::milliseconds(millis);
+        }
+    }
+    return DEFAULT_DEADLINE;
+}
+
+} // namespace
+
+void waitForInFlight(Shutdown::Clock::time_point deadline) {
+    while (Shutdown::inFlight().load() > 0 && Shutdown::Clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+namespace {
+
+/**
+ * @brief Runs the drain hooks on their own thread so a hung hook cannot hold up the stop.
+ */
+void drainAndStop(int signalNumber) {
+    auto&      shared   = state();
+    const auto budget   = deadlineFromEnvironment();
+    const auto start    = Shutdown::Clock::now();
+    const auto deadline = start + budget;
+
+    if (signalNumber > 0) {
+        velocitas::logger().info("🛑 Received signal {} - draining (deadline {} ms)", signalNumber,
+                                 budget.count());
+    } else {
+        velocitas::logger().info("🛑 Shutdown requested - draining (deadline {} ms)",
+                                 budget.count());
+    }
+
+    waitForInFlight(deadline);
+
+    std::vector<NamedHook> hooks;
+    {
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        hooks = shared.hooks;
+    }
+
+    auto progress = std::make_shared<Progress>();
+
+    std::thread drainer([hooks = std::move(hooks), progress, deadline]() {
+        for (const auto& entry : hooks) {
+            DrainResult result;
+            try {
+                result = entry.hook(deadline);
+            } catch (const std::exception& e) {
+                velocitas::logger().error("❌ Drain hook '{}' failed: {}", entry.name, e.what());
+            }
+            velocitas::logger().info("   ↳ {}: {} flushed, {} dropped", entry.name, result.drained,
+                                     result.dropped);
+            std::lock_guard<std::mutex> lock(progress->mutex);
+            progress->drained += result.drained;
+            progress->dropped += result.dropped;
+        }
+        std::lock_guard<std::mutex> lock(progress->mutex);
+        progress->finished = true;
+        progress->done.notify_all();
+    });
+
+    bool finished = false;
+    {
+        std::unique_lock<std::mutex> lock(progress->mutex);
+        finished = progress->done.wait_until(lock, deadline, [&] { return progress->finished; });
+    }
+    if (finished) {
+        drainer.join();
+    } else {
+        // Hooks capture the objects they flush - uninstall() must not return while
+        // one still runs, or those objects are destroyed under it
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        shared.overdueDrainer  = std::move(drainer);
+        shared.overdueProgress = progress;
+    }
+
+    const auto elapsed =
+        std::chrono::duration_cast<std::chrono::milliseconds>(Shutdown::Clock::now() - start);
+    {
+        std::lock_guard<std::mutex> lock(progress->mutex);
+        if (finished) {
+            velocitas::logger().info("✅ Drain complete in {} ms: {} flushed, {} dropped",
+                                     elapsed.count(), progress->drained, progress->dropped);
+        } else {
+            velocitas::logger().warn("⚠️  Drain exceeded deadline after {} ms: {} flushed, {} "
+                                     "dropped, rest still running",
+                                     elapsed.count(), progress->drained, progress->dropped);
+        }
+    }
+
+    std::function<void()> stopFunction;
+    {
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        stopFunction = shared.stopFunction;
+    }
+    if (stopFunction) {
+        stopFunction();
+    }
+}
+
+void watch() {
+    auto& shared = state();
+
+    std::array<pollfd, 2> fds{};
+    fds[0].fd     = shared.signalFd;
+    fds[0].events = POLLIN;
+    fds[1].fd     = shared.wakeFd;
+    fds[1].events = POLLIN;
+
+    for (;;) {
+        if (::poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+
+        int signalNumber = 0;
+        if ((fds[0].revents & POLLIN) != 0) {
+            signalfd_siginfo info{};
+            if (::read(shared.signalFd, &info, sizeof(info)) == sizeof(info)) {
+                signalNumber = static_cast<int>(info.ssi_signo);
+            }
+        }
+        if ((fds[1].revents & POLLIN) != 0) {
+            std::uint64_t value = 0;
+            (void)::read(shared.wakeFd, &value, sizeof(value));
+            if (shared.exiting.load()) {
+                return;
+            }
+        }
+
+        if (signalNumber == 0 && !shared.requested.load()) {
+            continue;
+        }
+        if (shared.shuttingDown.exchange(true)) {
+            if (signalNumber != 0) {
+                velocitas::logger().warn("⚠️  Second signal {} - exiting without drain",
+                                         signalNumber);
+                std::_Exit(128 + signalNumber);
+            }
+            continue;
+        }
+        Shutdown::closeIntake();
+        // Drain on a separate thread so a second signal is still noticed while it runs.
+        shared.sequence = std::thread(drainAndStop, signalNumber);
+    }
+}
+
+} // namespace
+
+void Shutdown::install() {
+    auto& shared = state();
+    if (shared.watcher.joinable()) {
+        return;
+    }
+
+    sigset_t mask;
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGINT);
+    sigaddset(&mask, SIGTERM);
+    ::pthread_sigmask(SIG_BLOCK, &mask, nullptr);
+
+    shared.signalFd = ::signalfd(-1, &mask, SFD_CLOEXEC);
+    shared.wakeFd   = ::eventfd(0, EFD_CLOEXEC);
+    shared.watcher  = std::thread(watch);
+}
+
+bool Shutdown::setStopFunction(std::function<void()> stopFunction) {
+    // drainAndStop() reads the function under the same lock, after shuttingDown is set
+    std::lock_guard<std::mutex> lock(state().mutex);
+    if (state().shuttingDown.load()) {
+        return false;
+    }
+    state().stopFunction = std::move(stopFunction);
+    return true;
+}
+
+void Shutdown::addDrainHook(std::string name, DrainHook hook) {
+    std::lock_guard<std::mutex> lock(state().mutex);
+    state().hooks.push_back({std::move(name), std::move(hook)});
+}
+
+void Shutdown::closeIntake() {
+    intakeOpen().store(false);
+}
+
+void Shutdown::request() {
+    closeIntake();
+    state().requested.store(true);
+    const std::uint64_t one = 1;
+    (void)::write(state().wakeFd, &one, sizeof(one));
+}
+
+void Shutdown::uninstall() {
+    auto& shared = state();
+    if (!shared.watcher.joinable()) {
+        return;
+    }
+    shared.exiting.store(true);
+    const std::uint64_t one = 1;
+    (void)::write(shared.wakeFd, &one, sizeof(one));
+    shared.watcher.join();
+    if (shared.sequence.joinable()) {
+        shared.sequence.join();
+    }
+    if (shared.overdueDrainer.joinable()) {
+        // One more deadline for the overrunning hook, then leave without running
+        // the destructors of the objects it may still be using
+        const auto deadline = Shutdown::Clock::now() + deadlineFromEnvironment();
+        auto&      progress = *shared.overdueProgress;
+        bool       finished = false;
+        {
+            std::unique_lock<std::mutex> lock(progress.mutex);
+            finished = progress.done.wait_until(lock, deadline, [&] { return progress.finished; });
+        }
+        if (!finished) {
+            velocitas::logger().error(
+                "❌ Drain hook still running at exit - exiting without cleanup");
+            std::_Exit(EXIT_FAILURE);
+        }
+        shared.overdueDrainer.join();
+    }
+    ::close(shared.signalFd);
+    ::close(shared.wakeFd);
+}
+
+} // namespace runtime
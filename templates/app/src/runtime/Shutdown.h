@@ -0,0 +1,152 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef VEHICLE_APP_RUNTIME_SHUTDOWN_H
+#define VEHICLE_APP_RUNTIME_SHUTDOWN_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+
+namespace runtime {
+
+/**
+ * @brief Outcome of one drain hook.
+ */
+struct DrainResult {
+    std::size_t drained{0}; // items flushed before the deadline
+    std::size_t dropped{0}; // items still pending when the hook gave up
+};
+
+/**
+ * @brief Signal-driven, bounded-time shutdown.
+ *
+ * install() blocks SIGINT and SIGTERM in the calling thread - and therefore in
+ * every thread created afterwards - and receives them through a signalfd on a
+ * dedicated watcher thread. No code runs in signal context, so logging and
+ * locking during shutdown are safe.
+ *
+ * On the first signal the watcher
+ *   1. closes intake (isIntakeOpen() turns false - subscription callbacks return early)
+ *      and waits for callbacks already inside an IntakeGuard to finish,
+ *   2. runs the registered drain hooks until the deadline (APP_SHUTDOWN_DEADLINE_MS,
+ *      default 2000), each flushing its queue, publisher or recording,
+ *   3. reports what was drained and dropped and calls the stop function.
+ * A hook that overruns the deadline keeps running while the app stops; uninstall()
+ * gives it one more deadline and otherwise exits the process without running
+ * destructors, since the hook may still use those objects. A second signal exits
+ * immediately without draining.
+ */
+class Shutdown {
+public:
+    using Clock     = std::chrono::steady_clock;
+    using DrainHook = std::function<DrainResult(Clock::time_point deadline)>;
+
+    /**
+     * @brief Call first thing in main(), before any thread is created.
+     */
+    static void install();
+
+    /**
+     * @brief What to call once draining is done - typically myApp->stop().
+     *
+     * Returns false, without registering it, if a signal already started the
+     * shutdown sequence - the caller should not start running then.
+     */
+    [[nodiscard]] static bool setStopFunction(std::function<void()> stopFunction);
+
+    /**
+     * @brief Register a flush step. Hooks run in registration order.
+     */
+    static void addDrainHook(std::string name, DrainHook hook);
+
+    /**
+     * @brief Stop accepting new samples. Part of the shutdown sequence, callable on its own.
+     */
+    static void closeIntake();
+
+    /**
+     * @brief Start the shutdown sequence as if a signal had arrived.
+     */
+    static void request();
+
+    /**
+     * @brief Cheap check for the ingest path.
+     */
+    static bool isIntakeOpen() { return intakeOpen().load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Admits one callback into the ingest path while intake is open.
+     *
+     * The shutdown sequence waits (up to the deadline) for admitted callbacks to
+     * leave before it runs the drain hooks, so hooks never race with handlers.
+     *
+     *   runtime::Shutdown::IntakeGuard intake;
+     *   if (!intake) return;
+     */
+    class IntakeGuard {
+    public:
+        IntakeGuard()
+            : m_admitted(enter()) {}
+        ~IntakeGuard() {
+            if (m_admitted) {
+                inFlight().fetch_sub(1);
+            }
+        }
+        IntakeGuard(const IntakeGuard&)            = delete;
+        IntakeGuard& operator=(const IntakeGuard&) = delete;
+        IntakeGuard(IntakeGuard&&)                 = delete;
+        IntakeGuard& operator=(IntakeGuard&&)      = delete;
+
+        explicit operator bool() const { return m_admitted; }
+
+    private:
+        static bool enter() {
+            inFlight().fetch_add(1);
+            if (!intakeOpen().load()) {
+                inFlight().fetch_sub(1);
+                return false;
+            }
+            return true;
+        }
+
+        bool m_admitted;
+    };
+
+    /**
+     * @brief Stop and join the watcher thread. Call after run() has returned.
+     */
+    static void uninstall();
+
+private:
+    static std::atomic_bool& intakeOpen() {
+        static std::atomic_bool open{true};
+        return open;
+    }
+
+    static std::atomic_int& inFlight() {
+        static std::atomic_int count{0};
+        return count;
+    }
+
+    friend void waitForInFlight(Clock::time_point deadline);
+};
+
+} // namespace runtime
+
+#endif // VEHICLE_APP_RUNTIME_SHUTDOWN_H
@@ -0,0 +1,175 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef VEHICLE_APP_RUNTIME_SIGNALFILTER_H
+#define VEHICLE_APP_RUNTIME_SIGNALFILTER_H
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+
+namespace runtime {
+
+/**
+ * @brief Per-signal sample filter applied at the subscription boundary.
+ *
+ * A filter decides — before any handler, queue or formatting work — whether an
+ * incoming sample is worth processing. Three policies are supported:
+ *
+ * - MinInterval: pass at most one sample per interval (e.g. 1 Hz cabin temp)
+ * - Deadband:    pass only if the value moved by more than a threshold since
+ *                the last passed sample
+ * - EveryNth:    pass every N-th sample
+ *
+ * accept() never allocates and only touches the filter's own state, so it is
+ * safe to call from the subscription callback for every sample. Counters are
+ * atomics so they can be read from a reporting thread.
+ */
+class SignalFilter {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class Policy : std::uint8_t { PassAll, MinInterval, Deadband, EveryNth };
+
+    static SignalFilter passAll() { return SignalFilter(Policy::PassAll); }
+
+    static SignalFilter minInterval(Clock::duration interval) {
+        SignalFilter filter(Policy::MinInterval);
+        filter.m_interval = interval;
+        return filter;
+    }
+
+    static SignalFilter deadband(double threshold) {
+        SignalFilter filter(Policy::Deadband);
+        filter.m_threshold = std::fabs(threshold);
+        return filter;
+    }
+
+    static SignalFilter everyNth(std::uint32_t n) {
+        SignalFilter filter(Policy::EveryNth);
+        filter.m_everyN = n == 0 ? 1 : n;
+        return filter;
+    }
+
+    // Copies carry the configuration and the filter state; counters are loaded
+    // and stored so a copy can be taken while another thread reads them
+    SignalFilter(const SignalFilter& other) { *this = other; }
+    SignalFilter(SignalFilter&& other) noexcept { *this = other; }
+
+    SignalFilter& operator=(const SignalFilter& other) {
+        m_policy        = other.m_policy;
+        m_interval      = other.m_interval;
+        m_threshold     = other.m_threshold;
+        m_everyN        = other.m_everyN;
+        m_counter       = other.m_counter;
+        m_hasLast       = other.m_hasLast;
+        m_lastPassTime  = other.m_lastPassTime;
+        m_lastPassValue = other.m_lastPassValue;
+        m_passed.store(other.m_passed.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        m_dropped.store(other.m_dropped.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        return *this;
+    }
+    SignalFilter& operator=(SignalFilter&& other) noexcept { return *this = other; }
+
+    ~SignalFilter() = default;
+
+    /**
+     * @brief Decide whether the sample should be processed.
+     *
+     * @param value the sample value (ignored by time/count based policies)
+     * @param now   arrival time of the sample
+     * @return true if the sample should be handed to the handler
+     */
+    bool accept(double value, Clock::time_point now = Clock::now()) {
+        bool pass = true;
+        switch (m_policy) {
+        case Policy::PassAll:
+            break;
+        case Policy::MinInterval:
+            pass = !m_hasLast || (now - m_lastPassTime) >= m_interval;
+            break;
+        case Policy::Deadband:
+            pass = !m_hasLast || std::fabs(value - m_lastPassValue) > m_threshold;
+            break;
+        case Policy::EveryNth:
+            pass = ++m_counter >= m_everyN;
+            if (pass) {
+                m_counter = 0;
+            }
+            break;
+        }
+
+        if (pass) {
+            m_hasLast       = true;
+            m_lastPassTime  = now;
+            m_lastPassValue = value;
+            m_passed.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+        return pass;
+    }
+
+    /**
+     * @brief Overload for policies that do not look at the value.
+     */
+    bool accept(Clock::time_point now = Clock::now()) { return accept(m_lastPassValue, now); }
+
+    [[nodiscard]] Policy        getPolicy() const { return m_policy; }
+    [[nodiscard]] std::uint64_t getPassedCount() const {
+        return m_passed.load(std::memory_order_relaxed);
+    }
+    [[nodiscard]] std::uint64_t getDroppedCount() const {
+        return m_dropped.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Human readable policy name for status logging.
+     */
+    [[nodiscard]] const char* getPolicyName() const {
+        switch (m_policy) {
+        case Policy::MinInterval:
+            return "min-interval";
+        case Policy::Deadband:
+            return "deadband";
+        case Policy::EveryNth:
+            return "every-nth";
+        case Policy::PassAll:
+        default:
+            return "pass-all";
+        }
+    }
+
+private:
+    explicit SignalFilter(Policy policy)
+        : m_policy(policy) {}
+
+    Policy               m_policy{Policy::PassAll};
+    Clock::duration      m_interval{};
+    double               m_threshold{0.0};
+    std::uint32_t        m_everyN{1};
+    std::uint32_t        m_counter{0};
+    bool                 m_hasLast{false};
+    Clock::time_point    m_lastPassTime{};
+    double               m_lastPassValue{0.0};
+    std::atomic_uint64_t m_passed{0};
+    std::atomic_uint64_t m_dropped{0};
+};
+
+} // namespace runtime
+
+#endif // VEHICLE_APP_RUNTIME_SIGNALFILTER_H
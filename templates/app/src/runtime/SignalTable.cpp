@@ -0,0 +1,151 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "runtime/SignalTable.h"
+
+#include "sdk/Logger.h"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace runtime {
+
+SignalTable::SignalTable(std::uint32_t capacity)
+    : SignalTable(::operator new(signalTableBytes(capacity), std::align_val_t(alignof(SignalSlot))),
+                  signalTableBytes(capacity), capacity, {}) {}
+
+SignalTable::SignalTable(void* memory, std::size_t bytes, std::uint32_t capacity,
+                         std::string shmName)
+    : m_memory(memory)
+    , m_bytes(bytes)
+    , m_shmName(std::move(shmName))
+    , m_header(static_cast<SignalTableHeader*>(memory))
+    , m_slots(signalTableSlots(m_header)) {
+    initialise(capacity);
+}
+
+std::unique_ptr<SignalTable> SignalTable::createShared(const std::string& shmName,
+                                                       std::uint32_t      capacity) {
+    const auto bytes = signalTableBytes(capacity);
+
+    // Remove a segment left behind by a crashed predecessor; readers re-open by name.
+    ::shm_unlink(shmName.c_str());
+    const int fd = ::shm_open(shmName.c_str(), O_CREAT | O_EXCL | O_RDWR | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        throw std::system_error(errno, std::generic_category(), "shm_open " + shmName);
+    }
+    if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+        const int error = errno;
+        ::close(fd);
+        ::shm_unlink(shmName.c_str());
+        throw std::system_error(error, std::generic_category(), "ftruncate " + shmName);
+    }
+    void* memory = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED) {
+        ::shm_unlink(shmName.c_str());
+        throw std::system_error(errno, std::generic_category(), "mmap " + shmName);
+    }
+    return std::unique_ptr<SignalTable>(new SignalTable(memory, bytes, capacity, shmName));
+}
+
+std::unique_ptr<SignalTable> SignalTable::fromEnvironment() {
+    std::uint32_t capacity = DEFAULT_CAPACITY;
+    if (const char* value = std::getenv("APP_SIGNAL_TABLE_CAPACITY")) {
+        const long parsed = std::atol(value);
+        if (parsed > 0) {
+            capacity = static_cast<std::uint32_t>(parsed);
+        }
+    }
+
+    if (const char* shmName = std::getenv("APP_SIGNAL_TABLE_SHM")) {
+        try {
+            auto table = createShared(shmName, capacity);
+            velocitas::logger().info("🗂️  Signal table exported as shared memory {} ({} slots)",
+                                     shmName, capacity);
+            return table;
+        } catch (const std::system_error& e) {
+            velocitas::logger().warn("⚠️  Signal table not shared ({}) - using private memory",
+                                     e.what());
+        }
+    }
+    return std::make_unique<SignalTable>(capacity);
+}
+
+SignalTable::~SignalTable() {
+    if (isShared()) {
+        ::munmap(m_memory, m_bytes);
+        ::shm_unlink(m_shmName.c_str());
+    } else {
+        ::operator delete(m_memory, std::align_val_t(alignof(SignalSlot)));
+    }
+}
+
+void SignalTable::initialise(std::uint32_t capacity) {
+    std::memset(m_memory, 0, m_bytes);
+    // Zeroed memory is a valid state for the atomics (lock-free, no hidden state).
+    m_header->layoutVersion = SIGNAL_TABLE_LAYOUT_VERSION;
+    m_header->capacity      = capacity;
+    m_header->slotSize      = sizeof(SignalSlot);
+    m_header->count.store(0, std::memory_order_relaxed);
+    // Magic last: readers treat the segment as valid only once it is complete.
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(m_header->magic, SIGNAL_TABLE_MAGIC, sizeof(SIGNAL_TABLE_MAGIC));
+}
+
+int SignalTable::registerSignal(std::string_view path) {
+    const int existing = find(path);
+    if (existing >= 0) {
+        return existing;
+    }
+
+    const auto count = m_header->count.load(std::memory_order_relaxed);
+    if (count >= m_header->capacity || path.size() >= SIGNAL_PATH_CAPACITY) {
+        velocitas::logger().warn("⚠️  Signal table: cannot register {}", path);
+        return -1;
+    }
+    auto& slot = m_slots[count];
+    std::memcpy(slot.path, path.data(), path.size());
+    slot.path[path.size()] = '\0';
+    m_header->count.store(count + 1, std::memory_order_release);
+    return static_cast<int>(count);
+}
+
+void SignalTable::truncate(std::uint32_t count) {
+    const auto current = m_header->count.load(std::memory_order_relaxed);
+    if (count >= current) {
+        return;
+    }
+    m_header->count.store(count, std::memory_order_release);
+    // Back to the zeroed state of initialise(), so a reused index starts without a value
+    for (auto index = count; index < current; ++index) {
+        auto& slot = m_slots[index];
+        slot.sequence.store(0, std::memory_order_relaxed);
+        slot.valueBits.store(0, std::memory_order_relaxed);
+        slot.timestampNs.store(0, std::memory_order_relaxed);
+        slot.updateCount.store(0, std::memory_order_relaxed);
+        std::memset(slot.path, 0, SIGNAL_PATH_CAPACITY);
+    }
+}
+
+} // namespace runtime
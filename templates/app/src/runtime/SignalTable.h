@@ -0,0 +1,155 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef VEHICLE_APP_RUNTIME_SIGNALTABLE_H
+#define VEHICLE_APP_RUNTIME_SIGNALTABLE_H
+
+#include "runtime/SignalTableLayout.h"
+
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace runtime {
+
+/**
+ * @brief Latest value of every registered signal, readable without locks.
+ *
+ * Each signal has one seqlock-protected slot; update() is wait-free and must be
+ * called from a single writer thread per slot, reads may happen from any thread.
+ * The table lives either in private memory or - to share it with co-located
+ * processes such as an HMI bridge or a logger - in a POSIX shared-memory segment
+ * that those processes map read-only through SignalTableReader.h, avoiding a
+ * databroker subscription and any syscall per read.
+ *
+ * Environment:
+ *   APP_SIGNAL_TABLE_SHM=/vapp-signals   export the table under this shm name
+ *   APP_SIGNAL_TABLE_CAPACITY=256        number of slots (default 128)
+ */
+class SignalTable {
+public:
+    static constexpr std::uint32_t DEFAULT_CAPACITY = 128;
+
+    /**
+     * @brief Table in private memory.
+     */
+    explicit SignalTable(std::uint32_t capacity = DEFAULT_CAPACITY);
+
+    /**
+     * @brief Table exported as a shared-memory segment. Throws std::system_error on failure.
+     */
+    static std::unique_ptr<SignalTable> createShared(const std::string& shmName,
+                                                     std::uint32_t      capacity = DEFAULT_CAPACITY);
+
+    /**
+     * @brief Shared if APP_SIGNAL_TABLE_SHM is set (falls back to private on error).
+     */
+    static std::unique_ptr<SignalTable> fromEnvironment();
+
+    ~SignalTable();
+
+    SignalTable(const SignalTable&)            = delete;
+    SignalTable& operator=(const SignalTable&) = delete;
+    SignalTable(SignalTable&&)                 = delete;
+    SignalTable& operator=(SignalTable&&)      = delete;
+
+    /**
+     * @brief Add a slot for a VSS path (idempotent). Call during initialisation.
+     * @return slot index, or -1 if the table is full or the path is too long
+     */
+    int registerSignal(std::string_view path);
+
+    /**
+     * @brief Drop the slots registered after the table held @p count, e.g. to undo a failed
+     * configuration step. The dropped slots are reset and their indices reused.
+     *
+     * Only call this while no reader is attached: not concurrently with read() or
+     * update(), and, for a shared table, before other processes open it. A reader
+     * still holding a dropped index would see whatever signal takes it next.
+     */
+    void truncate(std::uint32_t count);
+
+    [[nodiscard]] int find(std::string_view path) const { return findSignalSlot(m_header, path); }
+
+    /**
+     * @brief Write a slot. An index outside the table (e.g. -1 from a failed
+     * registerSignal()) is ignored.
+     */
+    void update(int index, double value) { update(index, value, monotonicNanos()); }
+
+    void update(int index, double value, std::int64_t timestampNs) {
+        if (!isValid(index)) {
+            return;
+        }
+        auto&      slot     = m_slots[index];
+        const auto sequence = slot.sequence.load(std::memory_order_relaxed);
+        slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        std::uint64_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(double));
+        slot.valueBits.store(bits, std::memory_order_relaxed);
+        slot.timestampNs.store(timestampNs, std::memory_order_relaxed);
+        slot.updateCount.store(slot.updateCount.load(std::memory_order_relaxed) + 1,
+                               std::memory_order_relaxed);
+
+        slot.sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    /**
+     * @brief Consistent read of a slot. Returns false if the signal was never updated
+     * or the index is outside the table.
+     */
+    bool read(int index, SignalSample& sample) const {
+        return isValid(index) && readSignalSlot(m_slots[index], sample);
+    }
+
+    [[nodiscard]] std::uint32_t getCount() const {
+        return m_header->count.load(std::memory_order_acquire);
+    }
+    [[nodiscard]] std::uint32_t getCapacity() const { return m_header->capacity; }
+    [[nodiscard]] bool          isShared() const { return !m_shmName.empty(); }
+    [[nodiscard]] std::string_view getPath(int index) const {
+        return isValid(index) ? std::string_view(m_slots[index].path) : std::string_view();
+    }
+
+    static std::int64_t monotonicNanos() {
+        timespec now{};
+        ::clock_gettime(CLOCK_MONOTONIC, &now);
+        return static_cast<std::int64_t>(now.tv_sec) * 1000000000 + now.tv_nsec;
+    }
+
+private:
+    [[nodiscard]] bool isValid(int index) const {
+        return static_cast<std::uint32_t>(index) < m_header->capacity;
+    }
+
+    SignalTable(void* memory, std::size_t bytes, std::uint32_t capacity, std::string shmName);
+
+    void initialise(std::uint32_t capacity);
+
+    void*              m_memory;
+    std::size_t        m_bytes;
+    std::string        m_shmName;
+    SignalTableHeader* m_header;
+    SignalSlot*        m_slots;
+};
+
+} // namespace runtime
+
+#endif // VEHICLE_APP_RUNTIME_SIGNALTABLE_H
@@ -0,0 +1,127 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef VEHICLE_APP_RUNTIME_SIGNALTABLELAYOUT_H
+#define VEHICLE_APP_RUNTIME_SIGNALTABLELAYOUT_H
+
+// Memory layout of the latest-value signal table. Shared between the app
+// (writer) and SignalTableReader.h (readers in other processes), so it must
+// only depend on the standard library and may only change together with
+// SIGNAL_TABLE_LAYOUT_VERSION.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace runtime {
+
+constexpr char          SIGNAL_TABLE_MAGIC[8]       = {'V', 'A', 'P', 'P', 'S', 'I', 'G', 'T'};
+constexpr std::uint32_t SIGNAL_TABLE_LAYOUT_VERSION = 1;
+constexpr std::size_t   SIGNAL_PATH_CAPACITY        = 104;
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+              "signal table slots must be lock-free to live in shared memory");
+
+struct SignalTableHeader {
+    char                       magic[8];
+    std::uint32_t              layoutVersion;
+    std::uint32_t              capacity;  // number of slots following the header
+    std::uint32_t              slotSize;  // sizeof(SignalSlot), guards against ABI drift
+    std::atomic<std::uint32_t> count;     // registered slots; slots [0, count) are valid
+};
+
+/**
+ * @brief One signal. Written by a single writer under a seqlock: the sequence is
+ * odd while an update is in progress; readers retry until they see the same even
+ * sequence before and after copying the payload.
+ */
+struct alignas(64) SignalSlot {
+    std::atomic<std::uint64_t> sequence;
+    std::atomic<std::uint64_t> valueBits;    // IEEE-754 double
+    std::atomic<std::int64_t>  timestampNs;  // CLOCK_MONOTONIC of the update
+    std::atomic<std::uint64_t> updateCount;
+    char                       path[SIGNAL_PATH_CAPACITY];
+};
+
+/**
+ * @brief Consistent copy of one slot.
+ */
+struct SignalSample {
+    double        value{0.0};
+    std::int64_t  timestampNs{0};
+    std::uint64_t updateCount{0};
+};
+
+inline std::size_t signalTableBytes(std::uint32_t capacity) {
+    return sizeof(SignalTableHeader) + alignof(SignalSlot) +
+           static_cast<std::size_t>(capacity) * sizeof(SignalSlot);
+}
+
+inline SignalSlot* signalTableSlots(SignalTableHeader* header) {
+    auto address = reinterpret_cast<std::uintptr_t>(header + 1);
+    address      = (address + alignof(SignalSlot) - 1) & ~(alignof(SignalSlot) - 1);
+    return reinterpret_cast<SignalSlot*>(address);
+}
+
+inline const SignalSlot* signalTableSlots(const SignalTableHeader* header) {
+    return signalTableSlots(const_cast<SignalTableHeader*>(header));
+}
+
+inline bool isCompatibleSignalTable(const SignalTableHeader* header) {
+    return std::memcmp(header->magic, SIGNAL_TABLE_MAGIC, sizeof(SIGNAL_TABLE_MAGIC)) == 0 &&
+           header->layoutVersion == SIGNAL_TABLE_LAYOUT_VERSION &&
+           header->slotSize == sizeof(SignalSlot);
+}
+
+/**
+ * @brief Seqlock read of one slot. Wait-free for the writer, retries for the reader.
+ */
+inline bool readSignalSlot(const SignalSlot& slot, SignalSample& sample) {
+    for (int attempt = 0; attempt < 64; ++attempt) {
+        const auto before = slot.sequence.load(std::memory_order_acquire);
+        if ((before & 1U) != 0) {
+            continue;
+        }
+        const auto bits      = slot.valueBits.load(std::memory_order_relaxed);
+        const auto timestamp = slot.timestampNs.load(std::memory_order_relaxed);
+        const auto updates   = slot.updateCount.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) == before) {
+            std::memcpy(&sample.value, &bits, sizeof(double));
+            sample.timestampNs = timestamp;
+            sample.updateCount = updates;
+            return updates > 0;
+        }
+    }
+    return false;
+}
+
+inline int findSignalSlot(const SignalTableHeader* header, std::string_view path) {
+    const auto  count = header->count.load(std::memory_order_acquire);
+    const auto* slots = signalTableSlots(header);
+    for (std::uint32_t i = 0; i < count; ++i) {
+        if (path == std::string_view(slots[i].path)) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+} // namespace runtime
+
+#endif // VEHICLE_APP_RUNTIME_SIGNALTABLELAYOUT_H
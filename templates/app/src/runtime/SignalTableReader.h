@@ -0,0 +1,111 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef VEHICLE_APP_RUNTIME_SIGNALTABLEREADER_H
+#define VEHICLE_APP_RUNTIME_SIGNALTABLEREADER_H
+
+// Header-only reader for the signal table exported by a vehicle app
+// (APP_SIGNAL_TABLE_SHM). Copy this file and SignalTableLayout.h into any
+// C++17 process on the same ECU - no SDK, no gRPC, no syscalls per read:
+//
+//   runtime::SignalTableReader reader("/vapp-signals");
+//   int speed = reader.find("Vehicle.Speed");
+//   runtime::SignalSample sample;
+//   if (speed >= 0 && reader.read(speed, sample)) { use(sample.value); }
+//
+// Link with -lrt on older glibc.
+
+#include "runtime/SignalTableLayout.h"
+
+#include <cerrno>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace runtime {
+
+class SignalTableReader {
+public:
+    /**
+     * @brief Map the segment read-only. Throws std::system_error if it does not
+     * exist or has an incompatible layout version.
+     */
+    explicit SignalTableReader(const std::string& shmName) {
+        const int fd = ::shm_open(shmName.c_str(), O_RDONLY | O_CLOEXEC, 0);
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "shm_open " + shmName);
+        }
+        struct stat info {};
+        if (::fstat(fd, &info) != 0 ||
+            static_cast<std::size_t>(info.st_size) < sizeof(SignalTableHeader)) {
+            ::close(fd);
+            throw std::system_error(EINVAL, std::generic_category(), "signal table too small");
+        }
+        m_bytes      = static_cast<std::size_t>(info.st_size);
+        void* memory = ::mmap(nullptr, m_bytes, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (memory == MAP_FAILED) {
+            throw std::system_error(errno, std::generic_category(), "mmap " + shmName);
+        }
+        m_header = static_cast<const SignalTableHeader*>(memory);
+        if (!isCompatibleSignalTable(m_header) ||
+            signalTableBytes(m_header->capacity) > m_bytes) {
+            ::munmap(memory, m_bytes);
+            throw std::system_error(EPROTO, std::generic_category(),
+                                    "incompatible signal table layout");
+        }
+        m_slots = signalTableSlots(m_header);
+    }
+
+    ~SignalTableReader() { ::munmap(const_cast<SignalTableHeader*>(m_header), m_bytes); }
+
+    SignalTableReader(const SignalTableReader&)            = delete;
+    SignalTableReader& operator=(const SignalTableReader&) = delete;
+    SignalTableReader(SignalTableReader&&)                 = delete;
+    SignalTableReader& operator=(SignalTableReader&&)      = delete;
+
+    /**
+     * @brief Slot index for a VSS path, -1 if the app does not publish it (yet).
+     */
+    [[nodiscard]] int find(std::string_view path) const { return findSignalSlot(m_header, path); }
+
+    bool read(int index, SignalSample& sample) const {
+        if (index < 0 ||
+            static_cast<std::uint32_t>(index) >= m_header->count.load(std::memory_order_acquire)) {
+            return false;
+        }
+        return readSignalSlot(m_slots[index], sample);
+    }
+
+    [[nodiscard]] std::uint32_t getCount() const {
+        return m_header->count.load(std::memory_order_acquire);
+    }
+    [[nodiscard]] std::string_view getPath(int index) const { return m_slots[index].path; }
+
+private:
+    const SignalTableHeader* m_header{nullptr};
+    const SignalSlot*        m_slots{nullptr};
+    std::size_t              m_bytes{0};
+};
+
+} // namespace runtime
+
+#endif // VEHICLE_APP_RUNTIME_SIGNALTABLEREADER_H
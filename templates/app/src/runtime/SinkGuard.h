@@ -0,0 +1,254 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef VEHICLE_APP_RUNTIME_SINKGUARD_H
+#define VEHICLE_APP_RUNTIME_SINKGUARD_H
+
+#include "runtime/CircuitBreaker.h"
+#include "runtime/Histogram.h"
+#include "runtime/RingBuffer.h"
+#include "runtime/Shutdown.h"
+#include "sdk/Logger.h"
+
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+namespace runtime {
+
+/**
+ * @brief What a record is worth when its sink is under pressure.
+ */
+enum class RecordPriority : std::uint8_t {
+    Summary, // aggregates - kept while the sink is tripped and delivered after recovery
+    Raw      // individual samples - shed first
+};
+
+/**
+ * @brief Decouples a slow output sink (MQTT, disk, ...) from the signal path.
+ *
+ * offer() never blocks: it queues the record in one of two bounded queues, one
+ * per RecordPriority, and returns. A dedicated thread calls the sink, summaries
+ * first, and feeds every call's outcome and latency to a CircuitBreaker.
+ *
+ * While the breaker is open, raw records are shed - both new offers and those
+ * already queued - and summaries wait in their queue (the newest are shed once
+ * it is full). Once the breaker turns half-open, raw offers are queued again.
+ * The queued summaries are the first probes, and raw records become probes once
+ * the summaries run out, so a sink that only gets raw records still recovers.
+ * Enough good probes close the breaker. Every shed record is counted by priority.
+ *
+ * Environment: APP_SINK_<NAME>_* as for CircuitBreaker, plus
+ *   APP_SINK_<NAME>_QUEUE=1024     capacity of each of the two queues
+ */
+template <typename Record>
+class SinkGuard {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Sink  = std::function<bool(const Record& record)>;
+
+    struct Options {
+        std::size_t             queueCapacity{1024};
+        CircuitBreaker::Options breaker;
+
+        Options withEnvironment(const std::string& sinkName) const {
+            Options options = *this;
+            options.breaker = breaker.withEnvironment(sinkName);
+            std::string variable = "APP_SINK_";
+            for (const char c : sinkName) {
+                variable +=
+                    c == '-' ? '_' : static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+            }
+            if (const char* queue = std::getenv((variable + "_QUEUE").c_str())) {
+                const long capacity = std::atol(queue);
+                if (capacity > 0) {
+                    options.queueCapacity = static_cast<std::size_t>(capacity);
+                }
+            }
+            return options;
+        }
+    };
+
+    SinkGuard(std::string name, Options options)
+        : m_name(std::move(name))
+        , m_breaker(m_name, options.breaker)
+        , m_summaries(options.queueCapacity)
+        , m_raw(options.queueCapacity) {}
+
+    ~SinkGuard() { flush(Clock::now()); }
+
+    SinkGuard(const SinkGuard&)            = delete;
+    SinkGuard& operator=(const SinkGuard&) = delete;
+    SinkGuard(SinkGuard&&)                 = delete;
+    SinkGuard& operator=(SinkGuard&&)      = delete;
+
+    /**
+     * @brief Start the sink thread.
+     */
+    bool start(Sink sink) {
+        if (m_running.exchange(true)) {
+            return false;
+        }
+        m_sink   = std::move(sink);
+        m_thread = std::thread(&SinkGuard::loop, this);
+        return true;
+    }
+
+    /**
+     * @brief Queue a record for the sink. Callable from any thread; never blocks.
+     * @return false if the record was shed
+     */
+    bool offer(Record record, RecordPriority priority) {
+        if (!m_running.load(std::memory_order_acquire)) {
+            return false;
+        }
+        const bool raw = priority == RecordPriority::Raw;
+        if (raw && m_breaker.getState() == CircuitBreaker::State::Open) {
+            m_shedRaw.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!(raw ? m_raw : m_summaries).tryPush(std::move(record))) {
+                (raw ? m_shedRaw : m_shedSummaries).fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        }
+        m_wakeUp.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief Deliver what the breaker lets through until deadline, then stop -
+     * use as a Shutdown drain hook.
+     */
+    DrainResult flush(Clock::time_point deadline) {
+        DrainResult result;
+        if (!m_running.load()) {
+            return result;
+        }
+        const std::uint64_t deliveredBefore = getDeliveredCount();
+        while ((!m_summaries.empty() || !m_raw.empty()) && Clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_running.store(false);
+        }
+        m_wakeUp.notify_all();
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+        result.drained = getDeliveredCount() - deliveredBefore;
+        result.dropped = m_summaries.size() + m_raw.size();
+        return result;
+    }
+
+    /**
+     * @brief Log delivered, failed and shed counts, the breaker state and sink latency.
+     */
+    void report() const {
+        velocitas::logger().info(
+            "🔌 Sink {} ({}): {} delivered, {} failed, shed {} raw / {} summaries, {} trips, "
+            "{} probes | latency p50 {} us p99 {} us max {} us",
+            m_name, m_breaker.getStateName(), getDeliveredCount(), m_failed.load(),
+            m_shedRaw.load(), m_shedSummaries.load(), m_breaker.getTripCount(),
+            m_breaker.getProbeCount(), m_latency.getPercentile(0.5).count(),
+            m_latency.getPercentile(0.99).count(), m_latency.getMax().count());
+    }
+
+    [[nodiscard]] CircuitBreaker::State getState() const { return m_breaker.getState(); }
+    [[nodiscard]] std::uint64_t         getDeliveredCount() const {
+        return m_delivered.load(std::memory_order_relaxed);
+    }
+    [[nodiscard]] std::uint64_t getShedCount(RecordPriority priority) const {
+        return (priority == RecordPriority::Raw ? m_shedRaw : m_shedSummaries)
+            .load(std::memory_order_relaxed);
+    }
+
+private:
+    void deliver(Record& record) {
+        const auto begin     = Clock::now();
+        bool       succeeded = false;
+        try {
+            succeeded = m_sink(record);
+        } catch (const std::exception& e) {
+            velocitas::logger().debug("🔌 Sink {} failed: {}", m_name, e.what());
+        }
+        const auto end = Clock::now();
+        m_latency.record(end - begin);
+        m_breaker.record(succeeded, end - begin, end);
+        (succeeded ? m_delivered : m_failed).fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void shedQueuedRaw() {
+        Record record;
+        while (m_raw.tryPop(record)) {
+            m_shedRaw.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void loop() {
+        Record record;
+        while (m_running.load(std::memory_order_acquire)) {
+            if (!m_breaker.allowRequest()) {
+                shedQueuedRaw();
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_wakeUp.wait_until(lock, m_breaker.getRetryTime(),
+                                    [this] { return !m_running.load(); });
+                continue;
+            }
+            // Summaries first - they are the first probes of a half-open breaker
+            if (m_summaries.tryPop(record) || m_raw.tryPop(record)) {
+                deliver(record);
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeUp.wait(lock, [this] {
+                return !m_summaries.empty() || !m_raw.empty() || !m_running.load();
+            });
+        }
+    }
+
+    std::string                m_name;
+    CircuitBreaker             m_breaker;
+    RingBuffer<Record>         m_summaries;
+    RingBuffer<Record>         m_raw;
+    Sink                       m_sink;
+    LatencyHistogram           m_latency;
+    std::mutex                 m_mutex;
+    std::condition_variable    m_wakeUp;
+    std::atomic<bool>          m_running{false};
+    std::atomic<std::uint64_t> m_delivered{0};
+    std::atomic<std::uint64_t> m_failed{0};
+    std::atomic<std::uint64_t> m_shedRaw{0};
+    std::atomic<std::uint64_t> m_shedSummaries{0};
+    std::thread                m_thread;
+};
+
+} // namespace runtime
+
+#endif // VEHICLE_APP_RUNTIME_SINKGUARD_H
@@ -0,0 +1,96 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef VEHICLE_APP_RUNTIME_TIMERWHEEL_H
+#define VEHICLE_APP_RUNTIME_TIMERWHEEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace runtime {
+
+/**
+ * @brief Hashed timing wheel for many periodic timers identified by an integer.
+ *
+ * Time is counted in ticks; a timer due at tick T lives in slot T % slots and
+ * fires when advance() reaches T. Scheduling and firing are O(1) per timer,
+ * independent of how many timers exist, which is what makes thousands of
+ * per-vehicle timers cheap. Slot vectors keep their capacity, so a wheel whose
+ * timers are rescheduled in steady state does not allocate.
+ *
+ * Single-threaded: schedule() and advance() must be called from the same thread.
+ */
+class TimerWheel {
+public:
+    explicit TimerWheel(std::size_t slots)
+        : m_slots(slots == 0 ? 1 : slots) {}
+
+    /**
+     * @brief Fire timer id after the given number of ticks (0 = on the next advance()).
+     */
+    void scheduleIn(std::uint32_t id, std::uint64_t ticks) {
+        const std::uint64_t due = m_tick + (ticks == 0 ? 1 : ticks);
+        m_slots[due % m_slots.size()].push_back({id, due});
+        ++m_pending;
+    }
+
+    /**
+     * @brief Advance to the given tick, calling onExpired(id) for every timer due.
+     *
+     * onExpired may schedule timers again, including the one that just fired.
+     */
+    template <typename Callback>
+    void advance(std::uint64_t toTick, Callback&& onExpired) {
+        while (m_tick < toTick) {
+            ++m_tick;
+            auto& slot = m_slots[m_tick % m_slots.size()];
+            if (slot.empty()) {
+                continue;
+            }
+            // Timers fired below may land in this slot again - work on a copy
+            m_firing.swap(slot);
+            for (const auto& entry : m_firing) {
+                if (entry.due <= m_tick) {
+                    --m_pending;
+                    onExpired(entry.id);
+                } else {
+                    slot.push_back(entry); // a later round of the wheel
+                }
+            }
+            m_firing.clear();
+        }
+    }
+
+    [[nodiscard]] std::uint64_t getTick() const { return m_tick; }
+    [[nodiscard]] std::size_t   getPendingCount() const { return m_pending; }
+
+private:
+    struct Entry {
+        std::uint32_t id;
+        std::uint64_t due;
+    };
+
+    std::vector<std::vector<Entry>> m_slots;
+    std::vector<Entry>              m_firing;
+    std::uint64_t                   m_tick{0};
+    std::size_t                     m_pending{0};
+};
+
+} // namespace runtime
+
+#endif // VEHICLE_APP_RUNTIME_TIMERWHEEL_H
@@ -0,0 +1,361 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef VEHICLE_APP_RUNTIME_UNITS_H
+#define VEHICLE_APP_RUNTIME_UNITS_H
+
+#include <compare>
+#include <ratio>
+#include <type_traits>
+
+/**
+ * Signal values with their unit in the type.
+ *
+ * Units carry the names VSS uses in its unit catalogue (units.yaml: "km/h" is
+ * km_per_h, "m/s^2" is m_per_s2, ...). A quantity converts implicitly into any
+ * unit of the same dimension, and comparisons and +/- convert the right operand
+ * into the left one's unit. The conversion factor is a std::ratio, so when the
+ * operand is a constant - a threshold written in whatever unit reads best - the
+ * compiler converts it and the hot path compares raw doubles:
+ *
+ *     using namespace runtime::units::literals;
+ *     Speed<m_per_s> speed{reply->get(Vehicle.Speed)->value()};
+ *     if (speed > 108_kmh) { ... }                          // speed > 30.0
+ *     logger().info("{:.1f} km/h", speed.in<km_per_h>());
+ *
+ * Mixing dimensions (speed > 20_celsius) does not compile. Quantities are
+ * doubles in memory; the unit costs nothing at runtime.
+ *
+ * Temperatures are points on a scale with an arbitrary zero, so 2 * 22_celsius
+ * means nothing and does not compile. Subtracting two gives a difference
+ * (delta<celsius>), which scales and converts without the offset and can be
+ * added back to a temperature:
+ *
+ *     const auto error = TARGET - cabin;                    // delta<celsius>
+ *     const CabinTemperature setPoint = TARGET + 0.5 * error;
+ */
+namespace runtime::units {
+
+namespace dimension {
+struct Acceleration {};
+struct Angle {};
+struct AngularSpeed {};
+struct Current {};
+struct Energy {};
+struct FuelConsumption {};
+struct Length {};
+struct Mass {};
+struct Power {};
+struct Pressure {};
+struct Ratio {};
+struct Speed {};
+struct Temperature {};
+struct TemperatureDifference {};
+struct Time {};
+struct Torque {};
+struct Voltage {};
+struct Volume {};
+} // namespace dimension
+
+/**
+ * @brief A unit of Dimension: reference value = value * Scale + Offset.
+ *
+ * Each dimension's reference unit has Scale 1 and Offset 0.
+ */
+template <typename Dimension, typename Scale, typename Offset = std::ratio<0>>
+struct Unit {
+    using dimension = Dimension;
+    using scale     = Scale;
+    using offset    = Offset;
+};
+
+template <typename U, typename Dimension>
+concept UnitOf = std::is_same_v<typename U::dimension, Dimension>;
+
+template <typename U>
+inline constexpr bool HAS_OFFSET = !std::ratio_equal_v<typename U::offset, std::ratio<0>>;
+
+template <typename A, typename B>
+concept SameDimension = std::is_same_v<typename A::dimension, typename B::dimension>;
+
+/**
+ * @brief True for units of a dimension whose values are points, not amounts (temperatures).
+ */
+template <typename U>
+inline constexpr bool IS_POINT = std::is_same_v<typename U::dimension, dimension::Temperature>;
+
+/**
+ * @brief Unit of a temperature difference in U: U's scale, no offset.
+ */
+template <typename U>
+    requires IS_POINT<U>
+struct delta : Unit<dimension::TemperatureDifference, typename U::scale> {
+    static constexpr const char* symbol = U::symbol;
+};
+
+/**
+ * @brief Unit of the difference of two U values: delta<U> for points, else U itself.
+ */
+template <typename U>
+struct DifferenceOf {
+    using type = U;
+};
+template <typename U>
+    requires IS_POINT<U>
+struct DifferenceOf<U> {
+    using type = delta<U>;
+};
+template <typename U>
+using Difference = typename DifferenceOf<U>::type;
+
+// clang-format off
+// Speed and acceleration
+struct m_per_s    : Unit<dimension::Speed, std::ratio<1>> { static constexpr const char* symbol = "m/s"; };
+struct km_per_h   : Unit<dimension::Speed, std::ratio<1000, 3600>> { static constexpr const char* symbol = "km/h"; };
+struct mi_per_h   : Unit<dimension::Speed, std::ratio<1609344, 3600000>> { static constexpr const char* symbol = "mph"; };
+struct m_per_s2   : Unit<dimension::Acceleration, std::ratio<1>> { static constexpr const char* symbol = "m/s^2"; };
+struct cm_per_s2  : Unit<dimension::Acceleration, std::ratio<1, 100>> { static constexpr const char* symbol = "cm/s^2"; };
+// Length and time
+struct m          : Unit<dimension::Length, std::ratio<1>> { static constexpr const char* symbol = "m"; };
+struct mm         : Unit<dimension::Length, std::milli> { static constexpr const char* symbol = "mm"; };
+struct cm         : Unit<dimension::Length, std::centi> { static constexpr const char* symbol = "cm"; };
+struct km         : Unit<dimension::Length, std::kilo> { static constexpr const char* symbol = "km"; };
+struct mi         : Unit<dimension::Length, std::ratio<1609344, 1000>> { static constexpr const char* symbol = "mi"; };
+struct s          : Unit<dimension::Time, std::ratio<1>> { static constexpr const char* symbol = "s"; };
+struct ms         : Unit<dimension::Time, std::milli> { static constexpr const char* symbol = "ms"; };
+struct min        : Unit<dimension::Time, std::ratio<60>> { static constexpr const char* symbol = "min"; };
+struct h          : Unit<dimension::Time, std::ratio<3600>> { static constexpr const char* symbol = "h"; };
+// Temperature (VSS uses celsius)
+struct celsius    : Unit<dimension::Temperature, std::ratio<1>> { static constexpr const char* symbol = "celsius"; };
+struct fahrenheit : Unit<dimension::Temperature, std::ratio<5, 9>, std::ratio<-160, 9>> { static constexpr const char* symbol = "fahrenheit"; };
+struct K          : Unit<dimension::Temperature, std::ratio<1>, std::ratio<-27315, 100>> { static constexpr const char* symbol = "K"; };
+// Pressure
+struct Pa         : Unit<dimension::Pressure, std::ratio<1>> { static constexpr const char* symbol = "Pa"; };
+struct kPa        : Unit<dimension::Pressure, std::kilo> { static constexpr const char* symbol = "kPa"; };
+struct mbar       : Unit<dimension::Pressure, std::ratio<100>> { static constexpr const char* symbol = "mbar"; };
+struct bar        : Unit<dimension::Pressure, std::ratio<100000>> { static constexpr const char* symbol = "bar"; };
+// Ratios
+struct percent    : Unit<dimension::Ratio, std::ratio<1>> { static constexpr const char* symbol = "percent"; };
+struct ratio      : Unit<dimension::Ratio, std::ratio<100>> { static constexpr const char* symbol = "ratio"; };
+// Powertrain and electrics
+struct W          : Unit<dimension::Power, std::ratio<1>> { static constexpr const char* symbol = "W"; };
+struct kW         : Unit<dimension::Power, std::kilo> { static constexpr const char* symbol = "kW"; };
+struct Wh         : Unit<dimension::Energy, std::ratio<1>> { static constexpr const char* symbol = "Wh"; };
+struct kWh        : Unit<dimension::Energy, std::kilo> { static constexpr const char* symbol = "kWh"; };
+struct Nm         : Unit<dimension::Torque, std::ratio<1>> { static constexpr const char* symbol = "Nm"; };
+struct rpm        : Unit<dimension::AngularSpeed, std::ratio<1>> { static constexpr const char* symbol = "rpm"; };
+struct degrees_per_s : Unit<dimension::AngularSpeed, std::ratio<1, 6>> { static constexpr const char* symbol = "degrees/s"; };
+struct degrees    : Unit<dimension::Angle, std::ratio<1>> { static constexpr const char* symbol = "degrees"; };
+struct V          : Unit<dimension::Voltage, std::ratio<1>> { static constexpr const char* symbol = "V"; };
+struct A          : Unit<dimension::Current, std::ratio<1>> { static constexpr const char* symbol = "A"; };
+// Fluids and mass
+struct l          : Unit<dimension::Volume, std::ratio<1>> { static constexpr const char* symbol = "l"; };
+struct ml         : Unit<dimension::Volume, std::milli> { static constexpr const char* symbol = "ml"; };
+struct l_per_100km : Unit<dimension::FuelConsumption, std::ratio<1>> { static constexpr const char* symbol = "l/100km"; };
+struct kg         : Unit<dimension::Mass, std::ratio<1>> { static constexpr const char* symbol = "kg"; };
+struct g          : Unit<dimension::Mass, std::milli> { static constexpr const char* symbol = "g"; };
+// clang-format on
+
+/**
+ * @brief Convert a value between two units of one dimension; constant-folds for constant input.
+ */
+template <typename From, typename To, typename Rep>
+    requires SameDimension<From, To>
+constexpr Rep convert(Rep value) {
+    if constexpr (std::is_same_v<From, To>) {
+        return value;
+    } else {
+        using Factor = std::ratio_divide<typename From::scale, typename To::scale>;
+        using Shift  = std::ratio_divide<std::ratio_subtract<typename From::offset, typename To::offset>,
+                                        typename To::scale>;
+        Rep result = value;
+        if constexpr (Factor::num != Factor::den) {
+            result *= static_cast<Rep>(Factor::num) / static_cast<Rep>(Factor::den);
+        }
+        if constexpr (Shift::num != 0) {
+            result += static_cast<Rep>(Shift::num) / static_cast<Rep>(Shift::den);
+        }
+        return result;
+    }
+}
+
+/**
+ * @brief A value of unit U.
+ */
+template <typename U, typename Rep = double>
+class Quantity {
+    static_assert(IS_POINT<U> || !HAS_OFFSET<U>, "only temperature units may have an offset");
+
+public:
+    using unit = U;
+    using rep  = Rep;
+
+    constexpr Quantity() = default;
+    constexpr explicit Quantity(Rep value)
+        : m_value(value) {}
+
+    template <typename Other>
+        requires SameDimension<Other, U>
+    constexpr Quantity(const Quantity<Other, Rep>& other) // NOLINT(google-explicit-constructor)
+        : m_value(convert<Other, U>(other.value())) {}
+
+    [[nodiscard]] constexpr Rep value() const { return m_value; }
+
+    /**
+     * @brief The value in another unit of the same dimension.
+     */
+    template <typename To>
+        requires SameDimension<To, U>
+    [[nodiscard]] constexpr Rep in() const {
+        return convert<U, To>(m_value);
+    }
+
+    template <typename Other>
+        requires SameDimension<Other, U>
+    constexpr auto operator<=>(const Quantity<Other, Rep>& other) const {
+        return m_value <=> convert<Other, U>(other.value());
+    }
+    template <typename Other>
+        requires SameDimension<Other, U>
+    constexpr bool operator==(const Quantity<Other, Rep>& other) const {
+        return m_value == convert<Other, U>(other.value());
+    }
+
+    /**
+     * @brief Add or subtract a difference: another amount, or a delta for temperatures.
+     */
+    template <typename Other>
+        requires SameDimension<Other, Difference<U>>
+    constexpr Quantity operator+(const Quantity<Other, Rep>& other) const {
+        return Quantity(m_value + convert<Other, Difference<U>>(other.value()));
+    }
+    template <typename Other>
+        requires SameDimension<Other, Difference<U>>
+    constexpr Quantity operator-(const Quantity<Other, Rep>& other) const {
+        return Quantity(m_value - convert<Other, Difference<U>>(other.value()));
+    }
+
+    /**
+     * @brief Difference of two temperatures, in U's delta.
+     */
+    template <typename Other>
+        requires(IS_POINT<U> && SameDimension<Other, U>)
+    constexpr Quantity<Difference<U>, Rep> operator-(const Quantity<Other, Rep>& other) const {
+        return Quantity<Difference<U>, Rep>(m_value - convert<Other, U>(other.value()));
+    }
+
+    constexpr Quantity operator-() const {
+        static_assert(!IS_POINT<U>, "negate a temperature difference, not a temperature");
+        return Quantity(-m_value);
+    }
+
+    constexpr Quantity operator*(Rep factor) const {
+        static_assert(!IS_POINT<U>, "scale a temperature difference, not a temperature");
+        return Quantity(m_value * factor);
+    }
+    constexpr Quantity operator/(Rep divisor) const {
+        static_assert(!IS_POINT<U>, "scale a temperature difference, not a temperature");
+        return Quantity(m_value / divisor);
+    }
+    friend constexpr Quantity operator*(Rep factor, const Quantity& quantity) {
+        return quantity * factor;
+    }
+
+    /**
+     * @brief Ratio of two quantities of one dimension, e.g. speed / limit.
+     */
+    template <typename Other>
+        requires SameDimension<Other, U>
+    constexpr Rep operator/(const Quantity<Other, Rep>& other) const {
+        static_assert(!IS_POINT<U>, "divide temperature differences, not temperatures");
+        return m_value / convert<Other, U>(other.value());
+    }
+
+    constexpr Quantity& operator+=(const Quantity<Difference<U>, Rep>& other) {
+        m_value += other.value();
+        return *this;
+    }
+    constexpr Quantity& operator-=(const Quantity<Difference<U>, Rep>& other) {
+        m_value -= other.value();
+        return *this;
+    }
+
+private:
+    Rep m_value{};
+};
+
+template <UnitOf<dimension::Speed> U = m_per_s>
+using Speed = Quantity<U>;
+template <UnitOf<dimension::Acceleration> U = m_per_s2>
+using Acceleration = Quantity<U>;
+template <UnitOf<dimension::Length> U = m>
+using Length = Quantity<U>;
+template <UnitOf<dimension::Time> U = s>
+using Time = Quantity<U>;
+template <UnitOf<dimension::Temperature> U = celsius>
+using Temperature = Quantity<U>;
+template <UnitOf<dimension::TemperatureDifference> U = delta<celsius>>
+using TemperatureDelta = Quantity<U>;
+template <UnitOf<dimension::Pressure> U = kPa>
+using Pressure = Quantity<U>;
+template <UnitOf<dimension::Ratio> U = percent>
+using Ratio = Quantity<U>;
+template <UnitOf<dimension::Power> U = kW>
+using Power = Quantity<U>;
+template <UnitOf<dimension::AngularSpeed> U = rpm>
+using AngularSpeed = Quantity<U>;
+template <UnitOf<dimension::Volume> U = l>
+using Volume = Quantity<U>;
+
+/**
+ * Literals for thresholds: 108_kmh, 30_mps, 22.5_celsius, 15_percent, ...
+ */
+namespace literals {
+
+// clang-format off
+constexpr Speed<m_per_s>         operator""_mps(long double v) { return Speed<m_per_s>(static_cast<double>(v)); }
+constexpr Speed<m_per_s>         operator""_mps(unsigned long long v) { return Speed<m_per_s>(static_cast<double>(v)); }
+constexpr Speed<km_per_h>        operator""_kmh(long double v) { return Speed<km_per_h>(static_cast<double>(v)); }
+constexpr Speed<km_per_h>        operator""_kmh(unsigned long long v) { return Speed<km_per_h>(static_cast<double>(v)); }
+constexpr Speed<mi_per_h>        operator""_mph(long double v) { return Speed<mi_per_h>(static_cast<double>(v)); }
+constexpr Speed<mi_per_h>        operator""_mph(unsigned long long v) { return Speed<mi_per_h>(static_cast<double>(v)); }
+constexpr Acceleration<m_per_s2> operator""_mps2(long double v) { return Acceleration<m_per_s2>(static_cast<double>(v)); }
+constexpr Acceleration<m_per_s2> operator""_mps2(unsigned long long v) { return Acceleration<m_per_s2>(static_cast<double>(v)); }
+constexpr Length<m>              operator""_m(long double v) { return Length<m>(static_cast<double>(v)); }
+constexpr Length<m>              operator""_m(unsigned long long v) { return Length<m>(static_cast<double>(v)); }
+constexpr Length<km>             operator""_km(long double v) { return Length<km>(static_cast<double>(v)); }
+constexpr Length<km>             operator""_km(unsigned long long v) { return Length<km>(static_cast<double>(v)); }
+constexpr Temperature<celsius>   operator""_celsius(long double v) { return Temperature<celsius>(static_cast<double>(v)); }
+constexpr Temperature<celsius>   operator""_celsius(unsigned long long v) { return Temperature<celsius>(static_cast<double>(v)); }
+constexpr Temperature<fahrenheit> operator""_fahrenheit(long double v) { return Temperature<fahrenheit>(static_cast<double>(v)); }
+constexpr Temperature<fahrenheit> operator""_fahrenheit(unsigned long long v) { return Temperature<fahrenheit>(static_cast<double>(v)); }
+constexpr Pressure<kPa>          operator""_kPa(long double v) { return Pressure<kPa>(static_cast<double>(v)); }
+constexpr Pressure<kPa>          operator""_kPa(unsigned long long v) { return Pressure<kPa>(static_cast<double>(v)); }
+constexpr Pressure<bar>          operator""_bar(long double v) { return Pressure<bar>(static_cast<double>(v)); }
+constexpr Pressure<bar>          operator""_bar(unsigned long long v) { return Pressure<bar>(static_cast<double>(v)); }
+constexpr Ratio<percent>         operator""_percent(long double v) { return Ratio<percent>(static_cast<double>(v)); }
+constexpr Ratio<percent>         operator""_percent(unsigned long long v) { return Ratio<percent>(static_cast<double>(v)); }
+constexpr Power<kW>              operator""_kW(long double v) { return Power<kW>(static_cast<double>(v)); }
+constexpr Power<kW>              operator""_kW(unsigned long long v) { return Power<kW>(static_cast<double>(v)); }
+constexpr AngularSpeed<rpm>      operator""_rpm(long double v) { return AngularSpeed<rpm>(static_cast<double>(v)); }
+constexpr AngularSpeed<rpm>      operator""_rpm(unsigned long long v) { return AngularSpeed<rpm>(static_cast<double>(v)); }
+// clang-format on
+
+} // namespace literals
+
+} // namespace runtime::units
+
+#endif // VEHICLE_APP_RUNTIME_UNITS_H
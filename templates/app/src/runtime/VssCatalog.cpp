@@ -0,0 +1,138 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "runtime/VssCatalog.h"
+
+#include "sdk/Logger.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace runtime {
+
+namespace {
+
+bool isValidCatalog(const VssCatalogHeader& header, std::size_t bytes) {
+    if (std::memcmp(header.magic, VSS_CATALOG_MAGIC, sizeof(VSS_CATALOG_MAGIC)) != 0 ||
+        header.layoutVersion != VSS_CATALOG_LAYOUT_VERSION ||
+        header.entrySize != sizeof(VssCatalogEntry) || header.count == 0 ||
+        header.bucketCount == 0 || header.totalBytes != bytes) {
+        return false;
+    }
+    return vssCatalogBytes(header) <= bytes;
+}
+
+} // namespace
+
+std::unique_ptr<VssCatalog> VssCatalog::open(const std::string& file) {
+    const int fd = ::open(file.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::system_error(errno, std::generic_category(), "open " + file);
+    }
+    struct stat info {};
+    if (::fstat(fd, &info) != 0 ||
+        static_cast<std::size_t>(info.st_size) < sizeof(VssCatalogHeader)) {
+        ::close(fd);
+        throw std::system_error(EINVAL, std::generic_category(), "VSS catalog too small");
+    }
+    const auto bytes  = static_cast<std::size_t>(info.st_size);
+    void*      memory = ::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED) {
+        throw std::system_error(errno, std::generic_category(), "mmap " + file);
+    }
+    if (!isValidCatalog(*static_cast<const VssCatalogHeader*>(memory), bytes)) {
+        ::munmap(memory, bytes);
+        throw std::system_error(EPROTO, std::generic_category(),
+                                "incompatible VSS catalog layout: " + file);
+    }
+    std::unique_ptr<VssCatalog> catalog(new VssCatalog(memory, bytes));
+
+    // Check every reference once so that lookups need no bounds checks
+    const auto& header = *catalog->m_header;
+    for (std::uint32_t id = 0; id < header.count; ++id) {
+        const auto& entry = catalog->m_entries[id];
+        if (static_cast<std::size_t>(entry.pathOffset) + entry.pathLength > header.stringBytes ||
+            static_cast<std::size_t>(entry.unitOffset) + entry.unitLength > header.stringBytes ||
+            catalog->m_sorted[id] >= header.count) {
+            throw std::system_error(EPROTO, std::generic_category(), "corrupt VSS catalog: " + file);
+        }
+    }
+    return catalog;
+}
+
+std::unique_ptr<VssCatalog> VssCatalog::fromEnvironment() {
+    std::string file;
+    if (const char* configured = std::getenv("APP_VSS_CATALOG")) {
+        file = configured;
+    } else {
+        std::error_code error;
+        const auto      executable = std::filesystem::read_symlink("/proc/self/exe", error);
+        if (error) {
+            return nullptr;
+        }
+        file = (executable.parent_path() / "vss.catalog").string();
+        if (!std::filesystem::exists(file, error)) {
+            velocitas::logger().debug("📚 No VSS catalog at {}", file);
+            return nullptr;
+        }
+    }
+    try {
+        auto catalog = open(file);
+        velocitas::logger().info("📚 VSS catalog {}: {} nodes", file, catalog->getCount());
+        return catalog;
+    } catch (const std::system_error& e) {
+        velocitas::logger().warn("⚠️  VSS catalog not loaded: {}", e.what());
+        return nullptr;
+    }
+}
+
+VssCatalog::VssCatalog(const void* memory, std::size_t bytes)
+    : m_header(static_cast<const VssCatalogHeader*>(memory))
+    , m_bytes(bytes) {
+    const auto* base = static_cast<const char*>(memory);
+    m_displacements =
+        reinterpret_cast<const std::uint32_t*>(base + vssCatalogDisplacementsOffset());
+    m_entries = reinterpret_cast<const VssCatalogEntry*>(base + vssCatalogEntriesOffset(*m_header));
+    m_sorted  = reinterpret_cast<const std::uint32_t*>(base + vssCatalogSortedOffset(*m_header));
+    m_strings = base + vssCatalogStringsOffset(*m_header);
+}
+
+VssCatalog::~VssCatalog() {
+    ::munmap(const_cast<VssCatalogHeader*>(m_header), m_bytes);
+}
+
+std::span<const std::uint32_t> VssCatalog::findPrefix(std::string_view prefix) const {
+    const std::span<const std::uint32_t> sorted(m_sorted, m_header->count);
+    const auto first = std::partition_point(sorted.begin(), sorted.end(), [&](std::uint32_t id) {
+        return getPath(static_cast<int>(id)) < prefix;
+    });
+    const auto last  = std::partition_point(first, sorted.end(), [&](std::uint32_t id) {
+        return getPath(static_cast<int>(id)).starts_with(prefix);
+    });
+    return {first, last};
+}
+
+} // namespace runtime
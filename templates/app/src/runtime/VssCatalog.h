@@ -0,0 +1,118 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef VEHICLE_APP_RUNTIME_VSSCATALOG_H
+#define VEHICLE_APP_RUNTIME_VSSCATALOG_H
+
+#include "runtime/VssCatalogLayout.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace runtime {
+
+/**
+ * @brief Metadata of every VSS node (type, unit, min/max), mapped read-only
+ * from the binary catalog the build generates from the VSS JSON.
+ *
+ * Each node has a dense signal ID. find() hashes the path once, reads the
+ * bucket's displacement and compares one stored path - O(1) with no parsing
+ * and no allocation, so rules, routing and validation can look up metadata on
+ * the signal path. findPrefix() returns a subtree for wildcard routing.
+ *
+ * Environment:
+ *   APP_VSS_CATALOG=/opt/app/vss.catalog   catalog file (default: vss.catalog
+ *                                          next to the executable)
+ */
+class VssCatalog {
+public:
+    /**
+     * @brief Map a catalog file. Throws std::system_error if it cannot be read
+     * or was written with another layout.
+     */
+    static std::unique_ptr<VssCatalog> open(const std::string& file);
+
+    /**
+     * @brief The configured catalog, or nullptr (logged) if there is none.
+     */
+    static std::unique_ptr<VssCatalog> fromEnvironment();
+
+    ~VssCatalog();
+
+    VssCatalog(const VssCatalog&)            = delete;
+    VssCatalog& operator=(const VssCatalog&) = delete;
+    VssCatalog(VssCatalog&&)                 = delete;
+    VssCatalog& operator=(VssCatalog&&)      = delete;
+
+    /**
+     * @brief Signal ID of a VSS path, -1 if the catalog does not contain it.
+     */
+    [[nodiscard]] int find(std::string_view path) const {
+        const auto hash   = vssCatalogHash(path, m_header->seed);
+        const auto bucket = vssCatalogBucket(hash, m_header->bucketCount);
+        const auto id     = vssCatalogSlot(hash, m_displacements[bucket], m_header->count);
+        return getPath(static_cast<int>(id)) == path ? static_cast<int>(id) : -1;
+    }
+
+    /**
+     * @brief IDs of all nodes whose path starts with prefix, in path order. Pass
+     * "Vehicle.Cabin.Door." for the subtree below Vehicle.Cabin.Door.
+     */
+    [[nodiscard]] std::span<const std::uint32_t> findPrefix(std::string_view prefix) const;
+
+    /**
+     * @brief False if value lies outside the node's VSS min/max.
+     */
+    [[nodiscard]] bool isInRange(int id, double value) const {
+        const auto& entry = m_entries[id];
+        return !(((entry.flags & VSS_HAS_MIN) != 0 && value < entry.min) ||
+                 ((entry.flags & VSS_HAS_MAX) != 0 && value > entry.max));
+    }
+
+    [[nodiscard]] std::string_view getPath(int id) const {
+        return {m_strings + m_entries[id].pathOffset, m_entries[id].pathLength};
+    }
+    [[nodiscard]] std::string_view getUnit(int id) const {
+        return {m_strings + m_entries[id].unitOffset, m_entries[id].unitLength};
+    }
+    [[nodiscard]] VssNodeKind getKind(int id) const {
+        return static_cast<VssNodeKind>(m_entries[id].kind);
+    }
+    [[nodiscard]] VssDataType getType(int id) const {
+        return static_cast<VssDataType>(m_entries[id].type);
+    }
+    [[nodiscard]] bool isArray(int id) const { return (m_entries[id].flags & VSS_ARRAY) != 0; }
+    [[nodiscard]] const VssCatalogEntry& getEntry(int id) const { return m_entries[id]; }
+    [[nodiscard]] std::uint32_t          getCount() const { return m_header->count; }
+
+private:
+    VssCatalog(const void* memory, std::size_t bytes);
+
+    const VssCatalogHeader* m_header;
+    std::size_t             m_bytes;
+    const std::uint32_t*    m_displacements;
+    const VssCatalogEntry*  m_entries;
+    const std::uint32_t*    m_sorted;
+    const char*             m_strings;
+};
+
+} // namespace runtime
+
+#endif // VEHICLE_APP_RUNTIME_VSSCATALOG_H
@@ -0,0 +1,153 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef VEHICLE_APP_RUNTIME_VSSCATALOGLAYOUT_H
+#define VEHICLE_APP_RUNTIME_VSSCATALOGLAYOUT_H
+
+// File layout of the binary VSS catalog. Shared between the build-time
+// generator (tools/VssCatalogGen.cpp) and VssCatalog.h, so it must only depend
+// on the standard library and may only change together with
+// VSS_CATALOG_LAYOUT_VERSION.
+//
+//   VssCatalogHeader
+//   std::uint32_t    displacements[bucketCount]  perfect hash, one per bucket
+//   VssCatalogEntry  entries[count]              indexed by signal ID
+//   std::uint32_t    sorted[count]               IDs in path order (prefix scans)
+//   char             strings[stringBytes]        paths and units, not terminated
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace runtime {
+
+constexpr char          VSS_CATALOG_MAGIC[8]       = {'V', 'A', 'P', 'P', 'V', 'S', 'S', 'C'};
+constexpr std::uint32_t VSS_CATALOG_LAYOUT_VERSION = 1;
+
+enum class VssNodeKind : std::uint8_t { Branch, Sensor, Actuator, Attribute };
+
+enum class VssDataType : std::uint8_t {
+    None, // branches
+    Boolean,
+    String,
+    Int8,
+    Int16,
+    Int32,
+    Int64,
+    UInt8,
+    UInt16,
+    UInt32,
+    UInt64,
+    Float,
+    Double
+};
+
+constexpr std::uint8_t VSS_HAS_MIN = 0x1;
+constexpr std::uint8_t VSS_HAS_MAX = 0x2;
+constexpr std::uint8_t VSS_ARRAY   = 0x4;
+
+struct VssCatalogHeader {
+    char          magic[8];
+    std::uint32_t layoutVersion;
+    std::uint32_t entrySize; // sizeof(VssCatalogEntry), guards against ABI drift
+    std::uint32_t count;
+    std::uint32_t bucketCount;
+    std::uint32_t stringBytes;
+    std::uint32_t reserved;
+    std::uint64_t seed;
+    std::uint64_t totalBytes;
+};
+
+struct VssCatalogEntry {
+    double        min;
+    double        max;
+    std::uint32_t pathOffset; // into strings
+    std::uint32_t unitOffset;
+    std::uint16_t pathLength;
+    std::uint8_t  unitLength; // 0: no unit
+    std::uint8_t  kind;       // VssNodeKind
+    std::uint8_t  type;       // VssDataType
+    std::uint8_t  flags;      // VSS_HAS_MIN | VSS_HAS_MAX | VSS_ARRAY
+    std::uint16_t reserved;
+};
+
+static_assert(sizeof(VssCatalogHeader) == 48, "catalog header layout changed");
+static_assert(sizeof(VssCatalogEntry) == 32, "catalog entry layout changed");
+
+inline std::size_t vssCatalogAlign(std::size_t offset) {
+    return (offset + 7) & ~static_cast<std::size_t>(7);
+}
+
+inline std::size_t vssCatalogDisplacementsOffset() {
+    return sizeof(VssCatalogHeader);
+}
+
+inline std::size_t vssCatalogEntriesOffset(const VssCatalogHeader& header) {
+    return vssCatalogAlign(vssCatalogDisplacementsOffset() +
+                           static_cast<std::size_t>(header.bucketCount) * sizeof(std::uint32_t));
+}
+
+inline std::size_t vssCatalogSortedOffset(const VssCatalogHeader& header) {
+    return vssCatalogEntriesOffset(header) +
+           static_cast<std::size_t>(header.count) * sizeof(VssCatalogEntry);
+}
+
+inline std::size_t vssCatalogStringsOffset(const VssCatalogHeader& header) {
+    return vssCatalogSortedOffset(header) +
+           static_cast<std::size_t>(header.count) * sizeof(std::uint32_t);
+}
+
+inline std::size_t vssCatalogBytes(const VssCatalogHeader& header) {
+    return vssCatalogStringsOffset(header) + header.stringBytes;
+}
+
+/**
+ * @brief Finaliser of splitmix64 - spreads every input bit over the whole word.
+ */
+inline std::uint64_t vssCatalogMix(std::uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+inline std::uint64_t vssCatalogHash(std::string_view path, std::uint64_t seed) {
+    std::uint64_t hash = 0xcbf29ce484222325ULL ^ seed; // FNV-1a
+    for (const char c : path) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 0x100000001b3ULL;
+    }
+    return vssCatalogMix(hash);
+}
+
+/**
+ * @brief Hash-and-displace: the high half of the hash picks a bucket, the
+ * bucket's displacement moves all of its paths to free IDs.
+ */
+inline std::uint32_t vssCatalogBucket(std::uint64_t hash, std::uint32_t bucketCount) {
+    return static_cast<std::uint32_t>((hash >> 32) % bucketCount);
+}
+
+inline std::uint32_t vssCatalogSlot(std::uint64_t hash, std::uint32_t displacement,
+                                    std::uint32_t count) {
+    return static_cast<std::uint32_t>((hash ^ vssCatalogMix(displacement)) % count);
+}
+
+} // namespace runtime
+
+#endif // VEHICLE_APP_RUNTIME_VSSCATALOGLAYOUT_H
@@ -0,0 +1,264 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "runtime/WorkerPool.h"
+
+#include "runtime/AllocTripwire.h"
+#include "runtime/LaunchOptions.h"
+#include "sdk/Logger.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+
+namespace runtime {
+
+namespace {
+
+void runGuarded(WorkerPool::Job& job) {
+    try {
+        job();
+    } catch (const std::exception& e) {
+        velocitas::logger().error("❌ Worker job failed: {}", e.what());
+    } catch (...) {
+        velocitas::logger().error("❌ Worker job failed: unknown exception");
+    }
+}
+
+} // namespace
+
+WorkerPool::Options WorkerPool::Options::fromEnvironment() {
+    Options options;
+    if (const char* workers = std::getenv("APP_WORKER_THREADS")) {
+        const long count = std::atol(workers);
+        if (count > 0) {
+            options.workers = static_cast<std::size_t>(count);
+        }
+    }
+    return options;
+}
+
+WorkerPool::WorkerPool(Options options)
+    : m_options(options) {
+    if (m_options.strands == 0) {
+        m_options.strands = 1;
+    }
+    if (m_options.batch == 0) {
+        m_options.batch = 1;
+    }
+    if (!isEnabled()) {
+        return;
+    }
+    m_strands.reserve(m_options.strands);
+    for (std::size_t i = 0; i < m_options.strands; ++i) {
+        m_strands.push_back(std::make_unique<Strand>());
+        m_strands.back()->home = i % m_options.workers;
+    }
+    m_workers.reserve(m_options.workers);
+    for (std::size_t i = 0; i < m_options.workers; ++i) {
+        m_workers.push_back(std::make_unique<Worker>());
+        m_workers.back()->slots = std::make_unique<Strand*[]>(m_options.strands);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    flush(Clock::now());
+}
+
+bool WorkerPool::start() {
+    if (!isEnabled() || m_running.exchange(true)) {
+        return false;
+    }
+    for (std::size_t i = 0; i < m_workers.size(); ++i) {
+        m_workers[i]->thread = std::thread(&WorkerPool::loop, this, i);
+    }
+    velocitas::logger().info("🧵 Worker pool: {} workers, {} strands", m_options.workers,
+                             m_options.strands);
+    return true;
+}
+
+void WorkerPool::submit(std::size_t key, Job job) {
+    if (!m_running.load(std::memory_order_acquire)) {
+        runGuarded(job);
+        return;
+    }
+    Strand& strand = *m_strands[key % m_strands.size()];
+    m_pendingJobs.fetch_add(1);
+    bool wasQueued = false;
+    {
+        std::lock_guard<std::mutex> lock(strand.mutex);
+        strand.jobs.push_back(std::move(job));
+        wasQueued     = strand.queued;
+        strand.queued = true;
+    }
+    if (!wasQueued) {
+        enqueue(strand.home, &strand);
+    }
+}
+
+DrainResult WorkerPool::flush(Clock::time_point deadline) {
+    DrainResult result;
+    if (!m_running.load()) {
+        return result;
+    }
+    const std::uint64_t finishedBefore = m_finishedJobs.load();
+    {
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_idle.wait_until(lock, deadline, [this] { return m_pendingJobs.load() == 0; });
+        m_running.store(false);
+    }
+    m_wake.notify_all();
+    for (auto& worker : m_workers) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+    result.drained = m_finishedJobs.load() - finishedBefore;
+    result.dropped = m_pendingJobs.load();
+    return result;
+}
+
+void WorkerPool::report() const {
+    for (std::size_t i = 0; i < m_workers.size(); ++i) {
+        const auto stats = getStats(i);
+        velocitas::logger().info("🧵 Worker {}: {} jobs, {} strands stolen", i, stats.executed,
+                                 stats.stolen);
+    }
+}
+
+WorkerPool::WorkerStats WorkerPool::getStats(std::size_t worker) const {
+    WorkerStats stats;
+    stats.executed = m_workers[worker]->executed.load(std::memory_order_relaxed);
+    stats.stolen   = m_workers[worker]->stolen.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void WorkerPool::enqueue(std::size_t worker, Strand* strand) {
+    auto& target = *m_workers[worker];
+    {
+        std::lock_guard<std::mutex> lock(target.mutex);
+        target.slots[(target.front + target.size) % m_options.strands] = strand;
+        ++target.size;
+        m_queuedStrands.fetch_add(1);
+    }
+    if (m_sleeping.load() > 0) {
+        // Taking the lock orders this wake-up after a sleeper's predicate check
+        { std::lock_guard<std::mutex> lock(m_sleepMutex); }
+        m_wake.notify_one();
+    }
+}
+
+WorkerPool::Strand* WorkerPool::popOwn(std::size_t worker) {
+    auto&                       own = *m_workers[worker];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    if (own.size == 0) {
+        return nullptr;
+    }
+    Strand* strand = own.slots[own.front];
+    own.front      = (own.front + 1) % m_options.strands;
+    --own.size;
+    m_queuedStrands.fetch_sub(1);
+    return strand;
+}
+
+WorkerPool::Strand* WorkerPool::steal(std::size_t thief) {
+    for (std::size_t offset = 1; offset < m_workers.size(); ++offset) {
+        auto&                       victim = *m_workers[(thief + offset) % m_workers.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.size == 0) {
+            continue;
+        }
+        --victim.size;
+        Strand* strand = victim.slots[(victim.front + victim.size) % m_options.strands];
+        m_queuedStrands.fetch_sub(1);
+        m_workers[thief]->stolen.fetch_add(1, std::memory_order_relaxed);
+        return strand;
+    }
+    return nullptr;
+}
+
+void WorkerPool::runStrand(std::size_t worker, Strand* strand, std::vector<Job>& batch) {
+    {
+        std::lock_guard<std::mutex> lock(strand->mutex);
+        const std::size_t           available = strand->jobs.size() - strand->head;
+        const std::size_t           take      = std::min(available, m_options.batch);
+        for (std::size_t i = 0; i < take; ++i) {
+            batch.push_back(std::move(strand->jobs[strand->head++]));
+        }
+        if (strand->head == strand->jobs.size()) {
+            strand->jobs.clear(); // keeps the capacity
+            strand->head = 0;
+        } else if (strand->head * 2 >= strand->jobs.size()) {
+            // A strand that never empties would otherwise grow without bound
+            strand->jobs.erase(strand->jobs.begin(),
+                               strand->jobs.begin() + static_cast<std::ptrdiff_t>(strand->head));
+            strand->head = 0;
+        }
+    }
+
+    for (auto& job : batch) {
+        runGuarded(job);
+    }
+    const std::size_t ran = batch.size();
+    batch.clear();
+    m_workers[worker]->executed.fetch_add(ran, std::memory_order_relaxed);
+    m_finishedJobs.fetch_add(ran);
+
+    bool more = false;
+    {
+        std::lock_guard<std::mutex> lock(strand->mutex);
+        more           = strand->head < strand->jobs.size();
+        strand->queued = more;
+    }
+    if (more) {
+        // Back of this worker's deque: the strand keeps its (possibly new) core
+        enqueue(worker, strand);
+    }
+    if (m_pendingJobs.fetch_sub(ran) == ran) {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_idle.notify_all();
+    }
+}
+
+void WorkerPool::loop(std::size_t index) {
+    ThreadTuning tuning = LaunchOptions::current().processing;
+    if (!tuning.cpus.empty()) {
+        tuning.cpus = {tuning.cpus[index % tuning.cpus.size()]};
+    }
+    applyToThisThread(tuning, "worker");
+    AllocTripwire::nameThisThread("worker");
+
+    std::vector<Job> batch;
+    batch.reserve(m_options.batch);
+    while (m_running.load(std::memory_order_acquire)) {
+        Strand* strand = popOwn(index);
+        if (strand == nullptr) {
+            strand = steal(index);
+        }
+        if (strand != nullptr) {
+            runStrand(index, strand, batch);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_sleeping.fetch_add(1);
+        m_wake.wait(lock, [this] { return m_queuedStrands.load() > 0 || !m_running.load(); });
+        m_sleeping.fetch_sub(1);
+    }
+}
+
+} // namespace runtime
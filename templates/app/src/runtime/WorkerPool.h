@@ -0,0 +1,152 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef VEHICLE_APP_RUNTIME_WORKERPOOL_H
+#define VEHICLE_APP_RUNTIME_WORKERPOOL_H
+
+#include "runtime/RingBuffer.h"
+#include "runtime/Shutdown.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace runtime {
+
+/**
+ * @brief Work-stealing thread pool that keeps the jobs of one key in order.
+ *
+ * Jobs are submitted with a key - typically a signal's slot. Every key maps to a
+ * strand: a FIFO of its jobs of which at most one runs at a time, so a signal's
+ * jobs execute in submission order and need no locking among themselves. A strand
+ * with work is queued on its home worker (affinity hint: key % workers), which
+ * keeps a signal on the same core and its state in that core's cache. Idle
+ * workers steal whole strands from the back of other workers' deques, so heavy
+ * signals spread across cores without breaking per-signal ordering.
+ *
+ * A worker runs at most Options::batch jobs of a strand before re-queueing it,
+ * so one busy signal cannot starve the others on its worker. Workers use the
+ * "processing" launch options; with APP_PROCESSING_CPUS each worker is pinned to
+ * one of the listed CPUs (round robin).
+ *
+ * With zero workers (the default) submit() runs the job inline on the caller.
+ *
+ * Environment:
+ *   APP_WORKER_THREADS=4   number of workers (0 = inline)
+ */
+class WorkerPool {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Job   = std::function<void()>;
+
+    struct Options {
+        std::size_t workers{0};
+        std::size_t strands{256}; // keys sharing a strand are serialised together
+        std::size_t batch{16};
+
+        static Options fromEnvironment();
+    };
+
+    struct WorkerStats {
+        std::uint64_t executed{0};
+        std::uint64_t stolen{0}; // strands taken from another worker
+    };
+
+    explicit WorkerPool(Options options);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&)            = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+    WorkerPool(WorkerPool&&)                 = delete;
+    WorkerPool& operator=(WorkerPool&&)      = delete;
+
+    /**
+     * @brief Start the workers. Returns false if the pool runs jobs inline.
+     */
+    bool start();
+
+    /**
+     * @brief Run job after every job submitted earlier with the same key.
+     */
+    void submit(std::size_t key, Job job);
+
+    /**
+     * @brief Wait for queued jobs, then stop the workers - use as a Shutdown drain hook.
+     *
+     * Jobs submitted afterwards run inline.
+     */
+    DrainResult flush(Clock::time_point deadline);
+
+    /**
+     * @brief Log per-worker executed and stolen counts.
+     */
+    void report() const;
+
+    [[nodiscard]] bool        isEnabled() const { return m_options.workers > 0; }
+    [[nodiscard]] std::size_t getWorkerCount() const { return m_options.workers; }
+    [[nodiscard]] WorkerStats getStats(std::size_t worker) const;
+
+private:
+    struct Strand {
+        std::mutex       mutex;
+        std::vector<Job> jobs;
+        std::size_t      head{0};
+        bool             queued{false};
+        std::size_t      home{0};
+    };
+
+    // Deque of strands with work; each strand is in at most one deque at a time,
+    // so a ring of Options::strands slots never overflows.
+    struct alignas(CACHE_LINE_SIZE) Worker {
+        std::mutex                 mutex;
+        std::unique_ptr<Strand*[]> slots;
+        std::size_t                front{0};
+        std::size_t                size{0};
+        std::atomic<std::uint64_t> executed{0};
+        std::atomic<std::uint64_t> stolen{0};
+        std::thread                thread;
+    };
+
+    void    loop(std::size_t index);
+    void    enqueue(std::size_t worker, Strand* strand);
+    Strand* popOwn(std::size_t worker);
+    Strand* steal(std::size_t thief);
+    void    runStrand(std::size_t worker, Strand* strand, std::vector<Job>& batch);
+
+    Options                              m_options;
+    std::vector<std::unique_ptr<Strand>> m_strands;
+    std::vector<std::unique_ptr<Worker>> m_workers;
+
+    std::atomic<bool>          m_running{false};
+    std::atomic<std::size_t>   m_queuedStrands{0};
+    std::atomic<std::size_t>   m_sleeping{0};
+    std::atomic<std::size_t>   m_pendingJobs{0};
+    std::atomic<std::uint64_t> m_finishedJobs{0};
+    std::mutex                 m_sleepMutex;
+    std::condition_variable    m_wake;
+    std::condition_variable    m_idle;
+};
+
+} // namespace runtime
+
+#endif // VEHICLE_APP_RUNTIME_WORKERPOOL_H
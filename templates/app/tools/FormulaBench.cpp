@@ -0,0 +1,224 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// Formula bytecode (runtime/Formula.h) against the same metrics written in C++:
+//
+//   cmake --build build --target formula-bench && build/bin/formula-bench [samples]
+//
+// Scalar: one speed update followed by evaluate(), as the app does per sample.
+// The hand-written side reads the same table slots, applies the same "every
+// input has a value, result is finite" rule and writes the same output slots.
+// Batch: evaluateBatch() over input columns against a plain loop over rows.
+// Both sides are checked for equal results before anything is reported.
+
+#include "runtime/Formula.h"
+#include "runtime/SignalTable.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t FORMULAS     = 7;
+constexpr std::size_t BATCH_ROWS   = 1 << 16;
+constexpr int         BATCH_PASSES = 50;
+
+constexpr std::array<std::array<std::string_view, 2>, FORMULAS> DEFINITIONS{{
+    {"Bench.SpeedKmh", "Vehicle.Speed * 3.6"},
+    {"Bench.SpeedMph", "Vehicle.Speed * 3.6 / 1.609344"},
+    {"Bench.LitersPer100Km", "if(Vehicle.Speed > 1, "
+                             "Vehicle.Powertrain.FuelSystem.InstantConsumption * 100000 / "
+                             "Vehicle.Speed, 0)"},
+    {"Bench.LongitudinalG", "clamp(Vehicle.Acceleration.Longitudinal / 9.81, -2, 2)"},
+    {"Bench.PowerKw", "Vehicle.Speed * Vehicle.Acceleration.Longitudinal * 1500 / 1000"},
+    {"Bench.Speeding", "Bench.SpeedKmh > 100 && Vehicle.Speed < 60"},
+    {"Bench.AccelerationG", "sqrt(Vehicle.Acceleration.Longitudinal^2 + "
+                            "Vehicle.Acceleration.Lateral^2) / 9.81"},
+}};
+
+struct Inputs {
+    double speed;
+    double consumption;
+    double longitudinal;
+    double lateral;
+};
+
+// The formulas above as C++
+std::array<double, FORMULAS> compute(const Inputs& in) {
+    const double kmh = in.speed * 3.6;
+    return {kmh,
+            kmh / 1.609344,
+            in.speed > 1 ? in.consumption * 100000 / in.speed : 0,
+            std::clamp(in.longitudinal / 9.81, -2.0, 2.0),
+            in.speed * in.longitudinal * 1500 / 1000,
+            kmh > 100 && in.speed < 60 ? 1.0 : 0.0,
+            std::sqrt(in.longitudinal * in.longitudinal + in.lateral * in.lateral) / 9.81};
+}
+
+double nanosPer(Clock::time_point start, double count) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / count;
+}
+
+bool same(double a, double b) {
+    return std::fabs(a - b) <= 1e-9 * std::max(1.0, std::fabs(a));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int samples = argc > 1 ? std::max(1, std::atoi(argv[1])) : 2'000'000;
+
+    runtime::SignalTable table(64);
+    runtime::FormulaSet  formulas(table);
+    for (const auto& [output, expression] : DEFINITIONS) {
+        formulas.add(output, expression);
+    }
+    const int speed        = table.find("Vehicle.Speed");
+    const int consumption  = table.find("Vehicle.Powertrain.FuelSystem.InstantConsumption");
+    const int longitudinal = table.find("Vehicle.Acceleration.Longitudinal");
+    const int lateral      = table.find("Vehicle.Acceleration.Lateral");
+    std::array<int, FORMULAS> outputs{};
+    for (std::size_t i = 0; i < FORMULAS; ++i) {
+        outputs[i] = formulas.getOutputSlot(i);
+    }
+    table.update(consumption, 0.002);
+    table.update(longitudinal, 1.2);
+    table.update(lateral, 0.5);
+
+    std::printf("%zu formulas, %zu instructions, %zu inputs\n", formulas.getFormulaCount(),
+                formulas.getInstructionCount(), formulas.getInputCount());
+
+    // Scalar
+    const auto read = [&](std::array<double, FORMULAS>& values) {
+        runtime::SignalSample sample;
+        for (std::size_t i = 0; i < FORMULAS; ++i) {
+            values[i] = table.read(outputs[i], sample) ? sample.value : NAN;
+        }
+    };
+    std::array<double, FORMULAS> expected{};
+    std::array<double, FORMULAS> actual{};
+    table.update(speed, 27.5);
+    formulas.evaluate();
+    read(expected);
+
+    auto start = Clock::now();
+    for (int i = 0; i < samples; ++i) {
+        table.update(speed, 20 + (i & 15));
+        formulas.evaluate();
+    }
+    const double scalarFormulas = nanosPer(start, samples);
+
+    const auto handWritten = [&] {
+        runtime::SignalSample s;
+        runtime::SignalSample c;
+        runtime::SignalSample lo;
+        runtime::SignalSample la;
+        if (!table.read(speed, s) || !table.read(consumption, c) ||
+            !table.read(longitudinal, lo) || !table.read(lateral, la)) {
+            return;
+        }
+        const auto values = compute({s.value, c.value, lo.value, la.value});
+        for (std::size_t i = 0; i < FORMULAS; ++i) {
+            if (std::isfinite(values[i])) {
+                table.update(outputs[i], values[i]);
+            }
+        }
+    };
+    start = Clock::now();
+    for (int i = 0; i < samples; ++i) {
+        table.update(speed, 20 + (i & 15));
+        handWritten();
+    }
+    const double scalarHand = nanosPer(start, samples);
+
+    table.update(speed, 27.5);
+    handWritten();
+    read(actual);
+    for (std::size_t i = 0; i < FORMULAS; ++i) {
+        if (!same(expected[i], actual[i])) {
+            std::fprintf(stderr, "%s: %s differs: formula %g, C++ %g\n", argv[0],
+                         DEFINITIONS[i][0].data(), expected[i], actual[i]);
+            return 1;
+        }
+    }
+
+    // Batch
+    std::vector<std::vector<double>> columns(formulas.getInputCount(),
+                                             std::vector<double>(BATCH_ROWS));
+    std::vector<const double*>       columnData;
+    std::vector<std::size_t>         columnOf(4);
+    for (std::size_t k = 0; k < columns.size(); ++k) {
+        for (std::size_t row = 0; row < BATCH_ROWS; ++row) {
+            columns[k][row] = 0.5 * static_cast<double>(row % 97) + static_cast<double>(k);
+        }
+        columnData.push_back(columns[k].data());
+        const auto path = formulas.getInputPath(k);
+        columnOf[path == "Vehicle.Speed"                                      ? 0
+                 : path == "Vehicle.Powertrain.FuelSystem.InstantConsumption" ? 1
+                 : path == "Vehicle.Acceleration.Longitudinal"                ? 2
+                                                                              : 3] = k;
+    }
+    std::vector<std::vector<double>> results(FORMULAS, std::vector<double>(BATCH_ROWS));
+    std::vector<std::vector<double>> handResults(FORMULAS, std::vector<double>(BATCH_ROWS));
+    std::vector<double*>             resultData;
+    for (auto& column : results) {
+        resultData.push_back(column.data());
+    }
+
+    start = Clock::now();
+    for (int pass = 0; pass < BATCH_PASSES; ++pass) {
+        formulas.evaluateBatch(columnData.data(), BATCH_ROWS, resultData.data());
+    }
+    const double batchFormulas = nanosPer(start, BATCH_PASSES * static_cast<double>(BATCH_ROWS));
+
+    start = Clock::now();
+    for (int pass = 0; pass < BATCH_PASSES; ++pass) {
+        for (std::size_t row = 0; row < BATCH_ROWS; ++row) {
+            const auto values =
+                compute({columns[columnOf[0]][row], columns[columnOf[1]][row],
+                         columns[columnOf[2]][row], columns[columnOf[3]][row]});
+            for (std::size_t i = 0; i < FORMULAS; ++i) {
+                handResults[i][row] = values[i];
+            }
+        }
+    }
+    const double batchHand = nanosPer(start, BATCH_PASSES * static_cast<double>(BATCH_ROWS));
+
+    for (std::size_t i = 0; i < FORMULAS; ++i) {
+        for (std::size_t row = 0; row < BATCH_ROWS; ++row) {
+            if (!same(results[i][row], handResults[i][row])) {
+                std::fprintf(stderr, "%s: %s row %zu differs: formula %g, C++ %g\n", argv[0],
+                             DEFINITIONS[i][0].data(), row, results[i][row], handResults[i][row]);
+                return 1;
+            }
+        }
+    }
+
+    std::printf("%-7s %14s %14s %7s\n", "mode", "formulas ns", "C++ ns", "ratio");
+    std::printf("%-7s %14.1f %14.1f %7.2f   (per sample, %d samples)\n", "scalar", scalarFormulas,
+                scalarHand, scalarFormulas / scalarHand, samples);
+    std::printf("%-7s %14.2f %14.2f %7.2f   (per row, %zu rows x %d)\n", "batch", batchFormulas,
+                batchHand, batchFormulas / batchHand, BATCH_ROWS, BATCH_PASSES);
+    return 0;
+}
@@ -0,0 +1,179 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// Startup cost of the global vehicle model, eager vs lazy (runtime/LazyModel.h):
+//
+//   cmake --build build --target model-startup-bench && build/bin/model-startup-bench [runs]
+//
+// Starts itself repeatedly and reports the median time from exec to main()
+// and to a constructed model. Each start first waits STARTUP_WORK in main(),
+// like the app does while it connects to the databroker. eager builds it in a
+// static initializer like `::vehicle::Vehicle Vehicle;`, lazy on that first
+// get(), and prefetch on a background thread started at the top of main().
+
+#include "runtime/LazyModel.h"
+
+#include "vehicle/Vehicle.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <spawn.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+extern char** environ;
+
+namespace {
+
+constexpr auto STARTUP_WORK = std::chrono::milliseconds(2);
+
+constinit runtime::LazyModel<::vehicle::Vehicle> model;
+
+std::int64_t monotonicNanos() {
+    timespec now{};
+    ::clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<std::int64_t>(now.tv_sec) * 1'000'000'000 + now.tv_nsec;
+}
+
+// Stands in for the eager global: runs before main() when requested
+const bool EAGER = [] {
+    if (std::getenv("MODEL_BENCH_MODE") != nullptr &&
+        std::strcmp(std::getenv("MODEL_BENCH_MODE"), "eager") == 0) {
+        model.get();
+        return true;
+    }
+    return false;
+}();
+
+int runChild(const char* mode) {
+    const auto mainNanos = monotonicNanos();
+    if (std::strcmp(mode, "prefetch") == 0) {
+        model.prefetch();
+    }
+    std::this_thread::sleep_for(STARTUP_WORK);
+    model.get();
+    std::printf("%lld %lld\n", static_cast<long long>(mainNanos),
+                static_cast<long long>(monotonicNanos()));
+    return EAGER == (std::strcmp(mode, "eager") == 0) ? 0 : 1;
+}
+
+struct Startup {
+    double toMainUs;
+    double toReadyUs;
+};
+
+bool spawnChild(const char* self, const char* mode, Startup& startup) {
+    int output[2];
+    if (::pipe(output) != 0) {
+        return false;
+    }
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, output[1], STDOUT_FILENO);
+    posix_spawn_file_actions_addclose(&actions, output[0]);
+
+    std::vector<std::string> environment;
+    for (char** variable = environ; *variable != nullptr; ++variable) {
+        if (std::strncmp(*variable, "MODEL_BENCH_MODE=", 17) != 0) {
+            environment.emplace_back(*variable);
+        }
+    }
+    environment.push_back(std::string("MODEL_BENCH_MODE=") + mode);
+    std::vector<char*> envp;
+    for (auto& variable : environment) {
+        envp.push_back(variable.data());
+    }
+    envp.push_back(nullptr);
+    char* argv[] = {const_cast<char*>(self), const_cast<char*>("--child"),
+                    const_cast<char*>(mode), nullptr};
+
+    pid_t      pid   = 0;
+    const auto start = monotonicNanos();
+    const int  error = ::posix_spawn(&pid, self, &actions, nullptr, argv, envp.data());
+    posix_spawn_file_actions_destroy(&actions);
+    ::close(output[1]);
+    if (error != 0) {
+        ::close(output[0]);
+        return false;
+    }
+    char          line[64] = {};
+    const ssize_t bytes    = ::read(output[0], line, sizeof(line) - 1);
+    ::close(output[0]);
+    int status = 0;
+    ::waitpid(pid, &status, 0);
+
+    long long mainNanos  = 0;
+    long long readyNanos = 0;
+    if (bytes <= 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0 ||
+        std::sscanf(line, "%lld %lld", &mainNanos, &readyNanos) != 2) {
+        return false;
+    }
+    startup.toMainUs  = static_cast<double>(mainNanos - start) / 1000.0;
+    startup.toReadyUs = static_cast<double>(readyNanos - start) / 1000.0;
+    return true;
+}
+
+double median(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    return values[values.size() / 2];
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc == 3 && std::strcmp(argv[1], "--child") == 0) {
+        return runChild(argv[2]);
+    }
+    const int runs = argc > 1 ? std::max(1, std::atoi(argv[1])) : 51;
+
+    std::printf("%-9s %14s %15s   (median of %d starts, %lld ms startup wait)\n", "mode",
+                "exec->main us", "exec->ready us", runs,
+                static_cast<long long>(STARTUP_WORK.count()));
+    for (const char* mode : {"eager", "lazy", "prefetch"}) {
+        std::vector<double> toMain;
+        std::vector<double> toReady;
+        for (int run = 0; run < runs; ++run) {
+            Startup startup{};
+            if (!spawnChild("/proc/self/exe", mode, startup)) {
+                std::fprintf(stderr, "%s: %s child failed\n", argv[0], mode);
+                return 1;
+            }
+            toMain.push_back(startup.toMainUs);
+            toReady.push_back(startup.toReadyUs);
+        }
+        std::printf("%-9s %14.1f %15.1f\n", mode, median(toMain), median(toReady));
+    }
+
+    // What every access pays once the model exists
+    constexpr int ACCESSES = 10'000'000;
+    model.get();
+    const auto start = monotonicNanos();
+    for (int i = 0; i < ACCESSES; ++i) {
+        auto* vehicle = &model.get();
+        asm volatile("" : : "r"(vehicle) : "memory");
+    }
+    std::printf("get() after construction: %.2f ns\n",
+                static_cast<double>(monotonicNanos() - start) / ACCESSES);
+    return 0;
+}
@@ -0,0 +1,287 @@
+/**
+ * Copyright (c) 2022-2025 Contributors to the Eclipse Foundation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// Build-time generator of the binary VSS catalog (runtime/VssCatalogLayout.h):
+//
+//   vss-catalog-gen vss_rel_4.0.json vss.catalog
+//
+// Reads the VSS JSON export, assigns every node a signal ID through a minimal
+// perfect hash of its path and writes the catalog the app maps at runtime.
+
+#include "runtime/VssCatalogLayout.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+using runtime::VssCatalogEntry;
+using runtime::VssCatalogHeader;
+using runtime::VssDataType;
+using runtime::VssNodeKind;
+
+struct Node {
+    std::string  path;
+    std::string  unit;
+    VssNodeKind  kind{VssNodeKind::Branch};
+    VssDataType  type{VssDataType::None};
+    std::uint8_t flags{0};
+    double       min{0.0};
+    double       max{0.0};
+};
+
+VssNodeKind parseKind(const std::string& type, const std::string& path) {
+    static const std::map<std::string, VssNodeKind> KINDS = {{"branch", VssNodeKind::Branch},
+                                                             {"sensor", VssNodeKind::Sensor},
+                                                             {"actuator", VssNodeKind::Actuator},
+                                                             {"attribute", VssNodeKind::Attribute}};
+    const auto it = KINDS.find(type);
+    if (it == KINDS.end()) {
+        throw std::runtime_error(path + ": unknown node type '" + type + "'");
+    }
+    return it->second;
+}
+
+VssDataType parseType(std::string datatype, std::uint8_t& flags, const std::string& path) {
+    static const std::map<std::string, VssDataType> TYPES = {
+        {"boolean", VssDataType::Boolean}, {"string", VssDataType::String},
+        {"int8", VssDataType::Int8},       {"int16", VssDataType::Int16},
+        {"int32", VssDataType::Int32},     {"int64", VssDataType::Int64},
+        {"uint8", VssDataType::UInt8},     {"uint16", VssDataType::UInt16},
+        {"uint32", VssDataType::UInt32},   {"uint64", VssDataType::UInt64},
+        {"float", VssDataType::Float},     {"double", VssDataType::Double}};
+    if (datatype.size() > 2 && datatype.compare(datatype.size() - 2, 2, "[]") == 0) {
+        flags |= runtime::VSS_ARRAY;
+        datatype.resize(datatype.size() - 2);
+    }
+    const auto it = TYPES.find(datatype);
+    if (it == TYPES.end()) {
+        throw std::runtime_error(path + ": unknown datatype '" + datatype + "'");
+    }
+    return it->second;
+}
+
+void collect(const std::string& path, const nlohmann::json& json, std::vector<Node>& nodes) {
+    Node node;
+    node.path = path;
+    node.kind = parseKind(json.value("type", "branch"), path);
+    if (json.contains("datatype")) {
+        node.type = parseType(json["datatype"].get<std::string>(), node.flags, path);
+    }
+    node.unit = json.value("unit", "");
+    if (json.contains("min") && json["min"].is_number()) {
+        node.min = json["min"].get<double>();
+        node.flags |= runtime::VSS_HAS_MIN;
+    }
+    if (json.contains("max") && json["max"].is_number()) {
+        node.max = json["max"].get<double>();
+        node.flags |= runtime::VSS_HAS_MAX;
+    }
+    if (node.path.size() > UINT16_MAX || node.unit.size() > UINT8_MAX) {
+        throw std::runtime_error(path + ": path or unit too long");
+    }
+    nodes.push_back(std::move(node));
+
+    if (const auto children = json.find("children"); children != json.end()) {
+        for (const auto& [name, child] : children->items()) {
+            collect(path + "." + name, child, nodes);
+        }
+    }
+}
+
+/**
+ * @brief Hash-and-displace construction: buckets are placed largest first, each
+ * with the smallest displacement that moves all its paths to free IDs.
+ * @return false if some bucket found no displacement - retry with another seed
+ */
+bool buildPerfectHash(const std::vector<Node>& nodes, std::uint64_t seed,
+                      std::vector<std::uint32_t>& displacements, std::vector<std::uint32_t>& ids) {
+    constexpr std::uint32_t MAX_DISPLACEMENT = 1U << 20;
+
+    const auto count       = static_cast<std::uint32_t>(nodes.size());
+    const auto bucketCount = static_cast<std::uint32_t>(displacements.size());
+
+    std::vector<std::uint64_t>              hashes(count);
+    std::vector<std::vector<std::uint32_t>> buckets(bucketCount);
+    for (std::uint32_t i = 0; i < count; ++i) {
+        hashes[i] = runtime::vssCatalogHash(nodes[i].path, seed);
+        buckets[runtime::vssCatalogBucket(hashes[i], bucketCount)].push_back(i);
+    }
+    std::vector<std::uint32_t> order(bucketCount);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](std::uint32_t a, std::uint32_t b) {
+        return buckets[a].size() > buckets[b].size();
+    });
+
+    std::vector<bool>          taken(count, false);
+    std::vector<std::uint32_t> slots;
+    ids.assign(count, 0);
+    for (const auto bucket : order) {
+        const auto& members = buckets[bucket];
+        if (members.empty()) {
+            break;
+        }
+        bool placed = false;
+        for (std::uint32_t displacement = 0; displacement < MAX_DISPLACEMENT && !placed;
+             ++displacement) {
+            slots.clear();
+            placed = true;
+            for (const auto member : members) {
+                const auto slot = runtime::vssCatalogSlot(hashes[member], displacement, count);
+                if (taken[slot] || std::find(slots.begin(), slots.end(), slot) != slots.end()) {
+                    placed = false;
+                    break;
+                }
+                slots.push_back(slot);
+            }
+            if (placed) {
+                displacements[bucket] = displacement;
+                for (std::size_t i = 0; i < members.size(); ++i) {
+                    taken[slots[i]] = true;
+                    ids[members[i]] = slots[i];
+                }
+            }
+        }
+        if (!placed) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        std::cerr << "usage: " << argv[0] << " <vss.json> <vss.catalog>\n";
+        return 2;
+    }
+    try {
+        std::ifstream input(argv[1]);
+        if (!input) {
+            throw std::runtime_error(std::string("cannot read ") + argv[1]);
+        }
+        const auto json = nlohmann::json::parse(input);
+
+        std::vector<Node> nodes;
+        for (const auto& [name, root] : json.items()) {
+            collect(name, root, nodes);
+        }
+        if (nodes.empty()) {
+            throw std::runtime_error("no VSS nodes in input");
+        }
+        std::sort(nodes.begin(), nodes.end(),
+                  [](const Node& a, const Node& b) { return a.path < b.path; });
+        if (const auto duplicate = std::adjacent_find(
+                nodes.begin(), nodes.end(),
+                [](const Node& a, const Node& b) { return a.path == b.path; });
+            duplicate != nodes.end()) {
+            throw std::runtime_error("duplicate path " + duplicate->path);
+        }
+
+        // About four paths per bucket keeps the table small and construction fast
+        const auto                 count = static_cast<std::uint32_t>(nodes.size());
+        std::vector<std::uint32_t> displacements((count + 3) / 4, 0);
+        std::vector<std::uint32_t> ids;
+        std::uint64_t              seed = 0;
+        while (!buildPerfectHash(nodes, seed, displacements, ids)) {
+            std::fill(displacements.begin(), displacements.end(), 0);
+            if (++seed == 64) {
+                throw std::runtime_error("no perfect hash found");
+            }
+        }
+
+        // Strings: each unit once, paths in sorted order
+        std::string                        strings;
+        std::map<std::string, std::size_t> units;
+        std::vector<VssCatalogEntry>       entries(count);
+        std::vector<std::uint32_t>         sorted(count);
+        for (std::uint32_t i = 0; i < count; ++i) {
+            const auto& node  = nodes[i];
+            auto&       entry = entries[ids[i]];
+            entry.pathOffset  = static_cast<std::uint32_t>(strings.size());
+            entry.pathLength  = static_cast<std::uint16_t>(node.path.size());
+            strings += node.path;
+            if (!node.unit.empty()) {
+                auto [unit, added] = units.emplace(node.unit, strings.size());
+                if (added) {
+                    strings += node.unit;
+                }
+                entry.unitOffset = static_cast<std::uint32_t>(unit->second);
+                entry.unitLength = static_cast<std::uint8_t>(node.unit.size());
+            }
+            entry.min   = node.min;
+            entry.max   = node.max;
+            entry.kind  = static_cast<std::uint8_t>(node.kind);
+            entry.type  = static_cast<std::uint8_t>(node.type);
+            entry.flags = node.flags;
+            sorted[i]   = ids[i];
+        }
+
+        VssCatalogHeader header{};
+        std::memcpy(header.magic, runtime::VSS_CATALOG_MAGIC, sizeof(header.magic));
+        header.layoutVersion = runtime::VSS_CATALOG_LAYOUT_VERSION;
+        header.entrySize     = sizeof(VssCatalogEntry);
+        header.count         = count;
+        header.bucketCount   = static_cast<std::uint32_t>(displacements.size());
+        header.stringBytes   = static_cast<std::uint32_t>(strings.size());
+        header.seed          = seed;
+        header.totalBytes    = runtime::vssCatalogBytes(header);
+
+        std::string image(header.totalBytes, '\0');
+        const auto  place = [&image](std::size_t offset, const void* data, std::size_t bytes) {
+            std::memcpy(image.data() + offset, data, bytes);
+        };
+        place(0, &header, sizeof(header));
+        place(runtime::vssCatalogDisplacementsOffset(), displacements.data(),
+              displacements.size() * sizeof(std::uint32_t));
+        place(runtime::vssCatalogEntriesOffset(header), entries.data(),
+              entries.size() * sizeof(VssCatalogEntry));
+        place(runtime::vssCatalogSortedOffset(header), sorted.data(),
+              sorted.size() * sizeof(std::uint32_t));
+        place(runtime::vssCatalogStringsOffset(header), strings.data(), strings.size());
+
+        // Replace the catalog atomically - a running app may have it mapped
+        const std::string temporary = std::string(argv[2]) + ".tmp";
+        {
+            std::ofstream output(temporary, std::ios::binary | std::ios::trunc);
+            output.write(image.data(), static_cast<std::streamsize>(image.size()));
+            if (!output) {
+                throw std::runtime_error("cannot write " + temporary);
+            }
+        }
+        if (std::rename(temporary.c_str(), argv[2]) != 0) {
+            throw std::runtime_error(std::string("cannot replace ") + argv[2]);
+        }
+        std::cout << "VSS catalog " << argv[2] << ": " << count << " nodes, "
+                  << header.bucketCount << " buckets, seed " << seed << ", " << image.size()
+                  << " bytes\n";
+    } catch (const std::exception& e) {
+        std::cerr << argv[0] << ": " << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}